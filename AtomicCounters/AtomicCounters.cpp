@@ -78,7 +78,7 @@ int AtomicCounters::setupCL(void) {
   CHECK_ERROR(retValue, SDK_SUCCESS, "displayDevices() failed.");
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
   // getting device on which to run the sample
   status = getDevices(context, &devices, sampleArgs->deviceId,
@@ -484,7 +484,7 @@ int main(int argc, char* argv[]) {
   if (clAtomicCounters.run() != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
-  if (clAtomicCounters.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clAtomicCounters.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
   if (clAtomicCounters.cleanup() != SDK_SUCCESS) {
@@ -143,7 +143,7 @@ int BinarySearch::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -522,9 +522,11 @@ int BinarySearch::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -600,6 +602,8 @@ void BinarySearch::printStats() {
     stats[3] = toString(length / sampleTimer->totalTime, std::dec);
 
     printStatistics(strArray, stats, 4);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -656,7 +660,7 @@ int main(int argc, char *argv[]) {
       return SDK_FAILURE;
     }
 
-    if (clBinarySearch.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clBinarySearch.verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
@@ -105,7 +105,7 @@ int BinomialOption::setupCL() {
    */
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -297,73 +297,18 @@ int BinomialOption::runCLKernels() {
  * length specifies the length of the array
  */
 int BinomialOption::binomialOptionCPUReference() {
-  refOutput = (float*)malloc(samplesPerVectorWidth * sizeof(cl_float4));
-  CHECK_ALLOCATION(refOutput, "Failed to allocate host memory. (refOutput)");
-
-  float* stepsArray = (float*)malloc((numSteps + 1) * sizeof(cl_float4));
-  CHECK_ALLOCATION(stepsArray, "Failed to allocate host memory. (stepsArray)");
-
-  // Iterate for all samples
-  for (int bid = 0; bid < numSamples; ++bid) {
-    float s[4];
-    float x[4];
-    float vsdt[4];
-    float puByr[4];
-    float pdByr[4];
-    float optionYears[4];
-
-    float inRand[4];
-
-    for (int i = 0; i < 4; ++i) {
-      inRand[i] = randArray[bid + i];
-      s[i] = (1.0f - inRand[i]) * 5.0f + inRand[i] * 30.f;
-      x[i] = (1.0f - inRand[i]) * 1.0f + inRand[i] * 100.f;
-      optionYears[i] = (1.0f - inRand[i]) * 0.25f + inRand[i] * 10.f;
-      float dt = optionYears[i] * (1.0f / (float)numSteps);
-      vsdt[i] = VOLATILITY * sqrtf(dt);
-      float rdt = RISKFREE * dt;
-      float r = expf(rdt);
-      float rInv = 1.0f / r;
-      float u = expf(vsdt[i]);
-      float d = 1.0f / u;
-      float pu = (r - d) / (u - d);
-      float pd = 1.0f - pu;
-      puByr[i] = pu * rInv;
-      pdByr[i] = pd * rInv;
-    }
-    /**
-     * Compute values at expiration date:
-     * Call option value at period end is v(t) = s(t) - x
-     * If s(t) is greater than x, or zero otherwise...
-     * The computation is similar for put options...
-     */
-    for (int j = 0; j <= numSteps; j++) {
-      for (int i = 0; i < 4; ++i) {
-        float profit = s[i] * expf(vsdt[i] * (2.0f * j - numSteps)) - x[i];
-        stepsArray[j * 4 + i] = profit > 0.0f ? profit : 0.0f;
-      }
-    }
-
-    /**
-     * walk backwards up on the binomial tree of depth numSteps
-     * Reduce the price step by step
-     */
-    for (int j = numSteps; j > 0; --j) {
-      for (int k = 0; k <= j - 1; ++k) {
-        for (int i = 0; i < 4; ++i) {
-          int index_k = k * 4 + i;
-          int index_k_1 = (k + 1) * 4 + i;
-          stepsArray[index_k] =
-              pdByr[i] * stepsArray[index_k_1] + puByr[i] * stepsArray[index_k];
-        }
-      }
-    }
-
-    // Copy the root to result
-    refOutput[bid] = stepsArray[0];
+  if (refOutput == NULL) {
+    refOutput = (float*)malloc(samplesPerVectorWidth * sizeof(cl_float4));
+    CHECK_ALLOCATION(refOutput, "Failed to allocate host memory. (refOutput)");
   }
 
-  free(stepsArray);
+  // Option bid is priced from randArray[bid], see BinomialOptionCPU.hpp
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
+  cpuEngine.price(randArray, refOutput, numSamples, numSteps);
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 
   return SDK_SUCCESS;
 }
@@ -439,9 +384,11 @@ int BinomialOption::run() {
   sampleTimer->startTimer(timer);
 
   for (int i = 0; i < iterations; i++) {
+    sampleTimer->startIteration();
     if (runCLKernels()) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
   sampleTimer->stopTimer(timer);
 
@@ -499,7 +446,10 @@ void BinomialOption::printStats() {
     stats[2] = toString(kernelTime, std::dec);
     stats[3] = toString(numSamples / sampleTimer->totalTime, std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Options/sec",
+                            numSamples);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -571,7 +521,7 @@ int main(int argc, char* argv[]) {
       return SDK_FAILURE;
     }
 
-    if (clBinomialOption.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clBinomialOption.verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
@@ -36,6 +36,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <malloc.h>
 
 #include "CLUtil.hpp"
+#include "BinomialOptionCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -62,6 +63,7 @@ class BinomialOption {
   cl_double setupTime;  /**< Time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< Time taken to run kernel and read result back */
+  cl_double hostTime;   /**< Time taken by the host reference pricing */
   cl_int numSamples;    /**< No. of  samples*/
   cl_int samplesPerVectorWidth;  /**< No. of samples per vector width */
   cl_int numSteps;               /**< No. of time steps*/
@@ -79,6 +81,7 @@ class BinomialOption {
   SDKDeviceInfo deviceInfo; /**< Structure to store device information*/
   KernelWorkGroupInfo kernelInfo; /**< Structure to store kernel related info */
   SDKTimer* sampleTimer;          /**< SDKTimer object */
+  BinomialOptionCPU cpuEngine;    /**< Host lattice used by -e */
 
  private:
   float random(float randMax, float randMin);
@@ -92,11 +95,13 @@ class BinomialOption {
   BinomialOption()
       : setupTime(0),
         kernelTime(0),
+        hostTime(0),
         randArray(NULL),
         output(NULL),
         refOutput(NULL),
         devices(NULL),
-        iterations(1) {
+        iterations(1),
+        cpuEngine(RISKFREE, VOLATILITY) {
     numSamples = 256;
     numSteps = 254;
     sampleArgs = new CLCommandArgs();
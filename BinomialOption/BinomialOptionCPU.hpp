@@ -0,0 +1,237 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef BINOMIALOPTIONCPU_H_
+#define BINOMIALOPTIONCPU_H_
+
+#include <CL/cl.h>
+#include <math.h>
+#include <vector>
+#include "SDKMath.hpp"
+#include "SDKThread.hpp"
+
+using namespace appsdk;
+
+/**
+ * Host binomial lattice used to verify BinomialOption and
+ * BinomialOptionMultiGPU.
+ *
+ * BINOMIAL_CPU_LANES options are priced in lockstep, one per SSE lane, two
+ * registers wide so the backward walk has independent work to overlap.
+ * Their leaves are laid out interleaved in a single row of numSteps + 1
+ * groups, which the walk shrinks in place. The row stays in L1
+ * for the usual lattice depths. Batches are split into one contiguous
+ * range per SDKThreadPool thread. Each range owns a row in a scratch
+ * buffer that lives as long as the engine, so repeated calls do not
+ * allocate. Without SSE the lanes are looped over with libm.
+ */
+#define BINOMIAL_CPU_LANES 8 /**< options priced in lockstep */
+
+/**
+ * BinomialOptionCPU
+ * Prices American-style call options on a numSteps binomial lattice. The
+ * option parameters are interpolated from a random number r in [0, 1]
+ * exactly as the kernels do: s = 5..30, x = 1..100, t = 0.25..10 years.
+ */
+class BinomialOptionCPU {
+ public:
+  /**
+   * Constructor
+   * @param riskFree risk free interest rate
+   * @param volatility volatility of the underlying
+   */
+  BinomialOptionCPU(cl_float riskFree, cl_float volatility)
+      : _riskFree(riskFree), _volatility(volatility) {}
+
+  /**
+   * price
+   * @param randArray one random number per option
+   * @param output price of each option
+   * @param numOptions number of options
+   * @param numSteps depth of the lattice
+   */
+  void price(const cl_float *randArray, cl_float *output, cl_int numOptions,
+             cl_int numSteps) {
+    if (numOptions <= 0) {
+      return;
+    }
+    SDKThreadPool &pool = SDKThreadPool::instance();
+    size_t batches =
+        (numOptions + BINOMIAL_CPU_LANES - 1) / BINOMIAL_CPU_LANES;
+    size_t ranges = pool.getNumWorkers() + 1;
+    size_t grain = (batches + ranges - 1) / ranges;
+    ranges = (batches + grain - 1) / grain;
+
+    size_t rowSize = (size_t)(numSteps + 1) * BINOMIAL_CPU_LANES;
+    if (_scratch.size() < ranges * rowSize) {
+      _scratch.resize(ranges * rowSize);
+    }
+
+    Job job;
+    job.engine = this;
+    job.randArray = randArray;
+    job.output = output;
+    job.numOptions = numOptions;
+    job.numSteps = numSteps;
+    job.grain = grain;
+    job.rowSize = rowSize;
+    pool.parallelFor(0, batches, grain, priceRange, &job);
+  }
+
+ private:
+  /**
+   * Job
+   * Arguments of price shared by its tasks
+   */
+  struct Job {
+    BinomialOptionCPU *engine; /**< engine owning the scratch rows */
+    const cl_float *randArray; /**< random number of each option */
+    cl_float *output;          /**< price of each option */
+    cl_int numOptions;         /**< number of options */
+    cl_int numSteps;           /**< depth of the lattice */
+    size_t grain;              /**< batches per range */
+    size_t rowSize;            /**< floats in a lattice row */
+  };
+
+  /**
+   * priceRange
+   * Prices batches [begin, end); the range index selects the scratch row
+   */
+  static void priceRange(size_t begin, size_t end, void *arg) {
+    Job *job = (Job *)arg;
+    cl_float *row = &job->engine->_scratch[(begin / job->grain) * job->rowSize];
+    for (size_t batch = begin; batch < end; batch++) {
+      cl_int first = (cl_int)batch * BINOMIAL_CPU_LANES;
+      cl_int count = job->numOptions - first;
+      if (count > BINOMIAL_CPU_LANES) {
+        count = BINOMIAL_CPU_LANES;
+      }
+      job->engine->priceBatch(job->randArray + first, count, job->numSteps,
+                              row, job->output + first);
+    }
+  }
+
+  /**
+   * priceBatch
+   * Prices up to BINOMIAL_CPU_LANES options in lockstep
+   */
+  void priceBatch(const cl_float *randArray, cl_int count, cl_int numSteps,
+                  cl_float *row, cl_float *output) const {
+    cl_float s[BINOMIAL_CPU_LANES];
+    cl_float x[BINOMIAL_CPU_LANES];
+    cl_float vsdt[BINOMIAL_CPU_LANES];
+    cl_float puByr[BINOMIAL_CPU_LANES];
+    cl_float pdByr[BINOMIAL_CPU_LANES];
+
+    for (int i = 0; i < BINOMIAL_CPU_LANES; ++i) {
+      // Idle lanes repeat the last option
+      cl_float inRand = randArray[(i < count) ? i : count - 1];
+      s[i] = (1.0f - inRand) * 5.0f + inRand * 30.f;
+      x[i] = (1.0f - inRand) * 1.0f + inRand * 100.f;
+      cl_float optionYears = (1.0f - inRand) * 0.25f + inRand * 10.f;
+      cl_float dt = optionYears * (1.0f / (cl_float)numSteps);
+      vsdt[i] = _volatility * sqrtf(dt);
+      cl_float rdt = _riskFree * dt;
+      cl_float r = expf(rdt);
+      cl_float rInv = 1.0f / r;
+      cl_float u = expf(vsdt[i]);
+      cl_float d = 1.0f / u;
+      cl_float pu = (r - d) / (u - d);
+      cl_float pd = 1.0f - pu;
+      puByr[i] = pu * rInv;
+      pdByr[i] = pd * rInv;
+    }
+
+#ifdef __SSE2__
+    const int vectors = BINOMIAL_CPU_LANES / 4;
+    __m128 vs[vectors], vx[vectors], vVsdt[vectors];
+    __m128 vPuByr[vectors], vPdByr[vectors];
+    for (int v = 0; v < vectors; ++v) {
+      vs[v] = _mm_loadu_ps(s + v * 4);
+      vx[v] = _mm_loadu_ps(x + v * 4);
+      vVsdt[v] = _mm_loadu_ps(vsdt + v * 4);
+      vPuByr[v] = _mm_loadu_ps(puByr + v * 4);
+      vPdByr[v] = _mm_loadu_ps(pdByr + v * 4);
+    }
+
+    // Call value max(s(t) - x, 0) at the leaves
+    for (int j = 0; j <= numSteps; j++) {
+      __m128 up = _mm_set1_ps(2.0f * j - numSteps);
+      for (int v = 0; v < vectors; ++v) {
+        __m128 profit = _mm_sub_ps(
+            _mm_mul_ps(vs[v], expSSE(_mm_mul_ps(vVsdt[v], up))), vx[v]);
+        _mm_storeu_ps(row + j * BINOMIAL_CPU_LANES + v * 4,
+                      _mm_max_ps(profit, _mm_setzero_ps()));
+      }
+    }
+
+    // Walk backwards up the tree
+    for (int j = numSteps; j > 0; --j) {
+      __m128 next[vectors];
+      for (int v = 0; v < vectors; ++v) {
+        next[v] = _mm_loadu_ps(row + v * 4);
+      }
+      for (int k = 0; k <= j - 1; ++k) {
+        cl_float *current = row + k * BINOMIAL_CPU_LANES;
+        for (int v = 0; v < vectors; ++v) {
+          __m128 value = next[v];
+          next[v] = _mm_loadu_ps(current + BINOMIAL_CPU_LANES + v * 4);
+          _mm_storeu_ps(current + v * 4,
+                        _mm_add_ps(_mm_mul_ps(vPdByr[v], next[v]),
+                                   _mm_mul_ps(vPuByr[v], value)));
+        }
+      }
+    }
+#else
+    for (int j = 0; j <= numSteps; j++) {
+      for (int i = 0; i < BINOMIAL_CPU_LANES; ++i) {
+        cl_float profit = s[i] * expf(vsdt[i] * (2.0f * j - numSteps)) - x[i];
+        row[j * BINOMIAL_CPU_LANES + i] = profit > 0.0f ? profit : 0.0f;
+      }
+    }
+
+    for (int j = numSteps; j > 0; --j) {
+      for (int k = 0; k <= j - 1; ++k) {
+        cl_float *current = row + k * BINOMIAL_CPU_LANES;
+        cl_float *next = current + BINOMIAL_CPU_LANES;
+        for (int i = 0; i < BINOMIAL_CPU_LANES; ++i) {
+          current[i] = pdByr[i] * next[i] + puByr[i] * current[i];
+        }
+      }
+    }
+#endif
+
+    for (int i = 0; i < count; ++i) {
+      output[i] = row[i];
+    }
+  }
+
+  cl_float _riskFree;              /**< risk free interest rate */
+  cl_float _volatility;            /**< volatility of the underlying */
+  std::vector<cl_float> _scratch;  /**< one lattice row per range */
+};
+
+#endif
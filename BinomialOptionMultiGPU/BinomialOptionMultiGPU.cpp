@@ -160,7 +160,7 @@ int BinomialOptionMultiGPU::setupCL() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed");
 
   // getting device on which to run the sample
@@ -607,77 +607,18 @@ int BinomialOptionMultiGPU::loadBalancing() {
  * length specifies the length of the array
  */
 int BinomialOptionMultiGPU::binomialOptionMultiGPUCPUReference() {
-  refOutput = (float *)malloc(samplesPerVectorWidth * sizeof(cl_float4));
-  CHECK_ALLOCATION(refOutput, "Failed to allocate host memory. (refOutput)");
-
-  float *stepsArray = (float *)malloc((numSteps + 1) * sizeof(cl_float4));
-  CHECK_ALLOCATION(stepsArray, "Failed to allocate host memory. (stepsArray)");
-
-  // Iterate for all samples
-  for (int bid = 0; bid < numSamples; ++bid) {
-    float s[4];
-    float x[4];
-    float vsdt[4];
-    float puByr[4];
-    float pdByr[4];
-    float optionYears[4];
-
-    float inRand[4];
-
-    for (int i = 0; i < 4; ++i) {
-      inRand[i] = randArray[bid + i];
-      s[i] = (1.0f - inRand[i]) * 5.0f + inRand[i] * 30.f;
-      x[i] = (1.0f - inRand[i]) * 1.0f + inRand[i] * 100.f;
-      optionYears[i] = (1.0f - inRand[i]) * 0.25f + inRand[i] * 10.f;
-      float dt = optionYears[i] * (1.0f / (float)numSteps);
-      vsdt[i] = VOLATILITY * sqrtf(dt);
-      float rdt = RISKFREE * dt;
-      float r = expf(rdt);
-      float rInv = 1.0f / r;
-      float u = expf(vsdt[i]);
-      float d = 1.0f / u;
-      float pu = (r - d) / (u - d);
-      float pd = 1.0f - pu;
-      puByr[i] = pu * rInv;
-      pdByr[i] = pd * rInv;
-    }
-
-    /**
-     * Compute values at expiration date:
-     * Call option value at period end is v(t) = s(t) - x
-     * If s(t) is greater than x, or zero otherwise...
-     * The computation is similar for put options
-     */
-    for (int j = 0; j <= numSteps; j++) {
-      for (int i = 0; i < 4; ++i) {
-        float profit = s[i] * expf(vsdt[i] * (2.0f * j - numSteps)) - x[i];
-        stepsArray[j * 4 + i] = profit > 0.0f ? profit : 0.0f;
-      }
-    }
-
-    /**
-     * walk backwards up on the binomial tree of depth numSteps
-     * Reduce the price step by step
-     */
-    for (int j = numSteps; j > 0; --j) {
-      for (int k = 0; k <= j - 1; ++k) {
-        for (int i = 0; i < 4; ++i) {
-          int index_k = k * 4 + i;
-          int index_k_1 = (k + 1) * 4 + i;
-          stepsArray[index_k] =
-              pdByr[i] * stepsArray[index_k_1] + puByr[i] * stepsArray[index_k];
-        }
-      }
-    }
-
-    // Copy the root to result
-    refOutput[bid] = stepsArray[0];
+  if (refOutput == NULL) {
+    refOutput = (float *)malloc(samplesPerVectorWidth * sizeof(cl_float4));
+    CHECK_ALLOCATION(refOutput, "Failed to allocate host memory. (refOutput)");
   }
 
-  if (stepsArray) {
-    free(stepsArray);
-    stepsArray = NULL;
-  }
+  // Option bid is priced from randArray[bid], see BinomialOptionCPU.hpp
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
+  cpuEngine.price(randArray, refOutput, numSamples, numSteps);
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 
   return SDK_SUCCESS;
 }
@@ -744,7 +685,7 @@ struct dataPerGPU {
   int deviceNumber;
 };
 
-void *threadFuncPerGPU(void *data1) {
+static void *threadFuncPerGPU(void *data1) {
   dataPerGPU *data = (dataPerGPU *)data1;
   int deviceNumber = data->deviceNumber;
   BinomialOptionMultiGPU *boObj = data->boObj;
@@ -918,28 +859,36 @@ void *threadFuncPerGPU(void *data1) {
 }
 
 int BinomialOptionMultiGPU::runCLKernelsMultiGPU() {
-  SDKThread *threads = new SDKThread[numGPUDevices];
-  CHECK_ALLOCATION(threads, "Allocation failed!!");
+  /**
+  * One worker per GPU, created on the first call and reused by every
+  * iteration after that
+  */
+  if (gpuPool == NULL) {
+    gpuPool = new SDKThreadPool(numGPUDevices);
+    CHECK_ALLOCATION(gpuPool, "Allocation failed!!");
+  }
+
+  SDKTaskFuture *futures = new SDKTaskFuture[numGPUDevices];
+  CHECK_ALLOCATION(futures, "Allocation failed!!");
 
   /**
-  * Creating one thread per GPU
+  * Queue one task per GPU
   */
   dataPerGPU *data = new dataPerGPU[numGPUDevices];
   for (int i = 0; i < numGPUDevices; i++) {
     data[i].deviceNumber = i;
     data[i].boObj = this;
-    threads[i].create(threadFuncPerGPU, (void *)&data[i]);
+    gpuPool->submit(futures[i], threadFuncPerGPU, (void *)&data[i]);
   }
   /**
-  * Call join() function for synchronization
-  * Main thread will wait for each thread to get completed.
+  * Main thread will wait for each task to get completed.
   */
   for (int i = 0; i < numGPUDevices; i++) {
-    threads[i].join();
+    futures[i].wait();
   }
 
+  delete[] futures;
   delete[] data;
-  delete[] threads;
   return SDK_SUCCESS;
 }
 
@@ -963,12 +912,14 @@ int BinomialOptionMultiGPU::run() {
   sampleTimer->startTimer(timer);
 
   for (int i = 0; i < iterations; i++) {
+    sampleTimer->startIteration();
     if (!noMultiGPUSupport) {
       CHECK_ERROR(runCLKernelsMultiGPU(), SDK_SUCCESS,
                   "OpenCL noMultiGPUSupport failed");
     } else {
       CHECK_ERROR(runCLKernels(), SDK_SUCCESS, "OpenCL Run failed");
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -1012,7 +963,11 @@ void BinomialOptionMultiGPU::printStats() {
     stats[1] = toString(sampleTimer->totalTime, std::dec);
     stats[2] = toString(kernelTime, std::dec);
     stats[3] = toString(numSamples / sampleTimer->totalTime, std::dec);
-    printStatistics(strArray, stats, 4);
+
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Options/sec",
+                            numSamples);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -1077,6 +1032,11 @@ BinomialOptionMultiGPU::~BinomialOptionMultiGPU() {
   FREE(refOutput);
   FREE(devices);
 
+  if (gpuPool) {
+    delete gpuPool;
+    gpuPool = NULL;
+  }
+
   if (!noMultiGPUSupport) {
     if (kernels) {
       delete[] kernels;
@@ -1155,7 +1115,8 @@ int main(int argc, char *argv[]) {
   }
 
   // VerifyResults
-  if (clBinomialOptionMultiGPU.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clBinomialOptionMultiGPU.verifyResults()) !=
+      SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
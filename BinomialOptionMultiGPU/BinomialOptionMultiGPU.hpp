@@ -39,6 +39,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CLUtil.hpp"
 #include "SDKThread.hpp"
+#include "../BinomialOption/BinomialOptionCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -74,6 +75,7 @@ class BinomialOptionMultiGPU {
   cl_double setupTime;  /**< Time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< Time taken to run kernel and read result back */
+  cl_double hostTime;   /**< Time taken by the host reference pricing */
   size_t maxWorkGroupSize;       /**< Max allowed work-items in a group */
   cl_uint maxDimensions;         /**< Max group dimensions allowed */
   size_t *maxWorkItemSizes;      /**< Max work-items sizes in each dimensions */
@@ -114,6 +116,8 @@ class BinomialOptionMultiGPU {
   KernelWorkGroupInfo
       kernelWorkGroupInfo; /**< Structure to store kernel related info */
   SDKTimer *sampleTimer;   /**< SDKTimer object */
+  SDKThreadPool *gpuPool;  /**< Workers that drive one GPU each */
+  BinomialOptionCPU cpuEngine; /**< Host lattice used by -e */
  private:
   /**
   * \brief generate random numbers
@@ -133,12 +137,14 @@ class BinomialOptionMultiGPU {
   BinomialOptionMultiGPU()
       : setupTime(0),
         kernelTime(0),
+        hostTime(0),
         randArray(NULL),
         output(NULL),
         refOutput(NULL),
         maxWorkItemSizes(NULL),
         devices(NULL),
-        iterations(1) {
+        iterations(1),
+        cpuEngine(RISKFREE, VOLATILITY) {
     numSamples = 256;
     numSteps = 254;
     noMultiGPUSupport = false;
@@ -152,6 +158,7 @@ class BinomialOptionMultiGPU {
     devicesInfo = NULL;
     gpuDeviceIDs = NULL;
     cumulativeSumPerGPU = NULL;
+    gpuPool = NULL;
     sampleArgs = new CLCommandArgs();
     sampleTimer = new SDKTimer();
     sampleArgs->sampleVerStr = SAMPLE_VERSION;
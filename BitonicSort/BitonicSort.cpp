@@ -30,7 +30,7 @@ int BitonicSort::setupBitonicSort() {
   cl_uint inputSizeBytes;
 
   // allocate and init memory used by host
-  inputSizeBytes = length * sizeof(cl_uint);
+  inputSizeBytes = paddedLength * sizeof(cl_uint);
 
   int status = mapBuffer(inputBuffer, input, inputSizeBytes,
                          CL_MAP_WRITE_INVALIDATE_REGION);
@@ -39,6 +39,15 @@ int BitonicSort::setupBitonicSort() {
   // random initialisation of input
   fillRandom<cl_uint>(input, length, 1, 0, 255);
 
+  /*
+   * The kernel sorts a power of 2 number of keys. Padding keys sort to the
+   * end of the array, leaving the first length keys as the result.
+   */
+  cl_uint pad = sortFlag ? 0xFFFFFFFF : 0;
+  for (cl_uint i = length; i < paddedLength; ++i) {
+    input[i] = pad;
+  }
+
   if (sampleArgs->verify) {
     verificationInput = (cl_uint *)malloc(length * sizeof(cl_int));
     CHECK_ALLOCATION(verificationInput,
@@ -138,7 +147,7 @@ int BitonicSort::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   retValue = getDevices(context, &devices, sampleArgs->deviceId,
@@ -154,7 +163,7 @@ int BitonicSort::setupCL(void) {
   }
 
   inputBuffer = clCreateBuffer(context, CL_MEM_READ_WRITE,
-                               sizeof(cl_uint) * length, NULL, &status);
+                               sizeof(cl_uint) * paddedLength, NULL, &status);
   CHECK_OPENCL_ERROR(status, "clCreateBuffer failed. (inputBuffer)");
 
   // create a CL program using the kernel source
@@ -189,7 +198,7 @@ int BitonicSort::runCLKernels(void) {
   cl_uint stage;
   cl_uint passOfStage;
 
-  size_t globalThreads[1] = {length / 2};
+  size_t globalThreads[1] = {paddedLength / 2};
   size_t localThreads[1] = {GROUP_SIZE};
 
   status =
@@ -227,10 +236,11 @@ int BitonicSort::runCLKernels(void) {
    */
 
   /*
-   * 2^numStages should be equal to length.
-   * i.e the number of times you halve length to get 1 should be numStages
+   * 2^numStages should be equal to paddedLength.
+   * i.e the number of times you halve paddedLength to get 1 should be
+   * numStages
    */
-  for (temp = length; temp > 1; temp >>= 1) {
+  for (temp = paddedLength; temp > 1; temp >>= 1) {
     ++numStages;
   }
 
@@ -241,16 +251,6 @@ int BitonicSort::runCLKernels(void) {
   CHECK_OPENCL_ERROR(status, "clSetKernelArg failed. (inputBuffer)");
 
   // whether sort is to be in increasing order. CL_TRUE implies increasing
-  if (sortOrder.compare("asc") == 0) {
-    sortFlag = 1;
-  } else if (sortOrder.compare("desc") == 0) {
-    sortFlag = 0;
-  } else {
-    std::cout << "Please input asc or desc,the default sort order is desc!"
-              << std::endl;
-    sortFlag = 0;
-  }
-
   status = clSetKernelArg(kernel, 3, sizeof(cl_uint), (void *)&sortFlag);
   CHECK_OPENCL_ERROR(status, "clSetKernelArg failed. (increasing)");
 
@@ -289,52 +289,15 @@ int BitonicSort::runCLKernels(void) {
   return SDK_SUCCESS;
 }
 
-void BitonicSort::swapIfFirstIsGreater(cl_uint *a, cl_uint *b) {
-  if (*a > *b) {
-    cl_uint temp = *a;
-    *a = *b;
-    *b = temp;
-  }
-}
-
 /*
- * sorts the input array (in place) using the bitonic sort algorithm
+ * sorts the input array (in place) with BitonicSortCPU
  * sorts in increasing order if sortIncreasing is CL_TRUE
  * else sorts in decreasing order
- * length specifies the length of the array
+ * length specifies the length of the array, any length works
  */
 void BitonicSort::bitonicSortCPUReference(cl_uint *input, const cl_uint length,
                                           const cl_bool sortIncreasing) {
-  const cl_uint halfLength = length / 2;
-
-  cl_uint i;
-  for (i = 2; i <= length; i *= 2) {
-    cl_uint j;
-    for (j = i; j > 1; j /= 2) {
-      cl_bool increasing = sortIncreasing;
-      const cl_uint half_j = j / 2;
-
-      cl_uint k;
-      for (k = 0; k < length; k += j) {
-        const cl_uint k_plus_half_j = k + half_j;
-        cl_uint l;
-
-        if (i < length) {
-          if ((k == i) || ((k % i) == 0) && (k != halfLength)) {
-            increasing = !increasing;
-          }
-        }
-
-        for (l = k; l < k_plus_half_j; ++l) {
-          if (increasing) {
-            swapIfFirstIsGreater(&input[l], &input[l + half_j]);
-          } else {
-            swapIfFirstIsGreater(&input[l + half_j], &input[l]);
-          }
-        }
-      }
-    }
-  }
+  BitonicSortCPU::sort(input, length, sortIncreasing != CL_FALSE);
 }
 
 int BitonicSort::initialize() {
@@ -388,12 +351,28 @@ int BitonicSort::setup() {
     std::cout << "Error, iterations cannot be 0 or negative. Exiting..\n";
     exit(0);
   }
-  int i = length & (length - 1);
-  if (i != 0) {
-    std::cout << "\nThe input lentgh must be a power of 2\n" << std::endl;
+  if (length < 1) {
+    std::cout << "\nThe input length must be positive\n" << std::endl;
     return SDK_FAILURE;
   }
 
+  // The device sorts a power of 2 number of keys, see setupBitonicSort
+  paddedLength = 1;
+  while (paddedLength < (cl_uint)length) {
+    paddedLength <<= 1;
+  }
+
+  // whether sort is to be in increasing order. CL_TRUE implies increasing
+  if (sortOrder.compare("asc") == 0) {
+    sortFlag = 1;
+  } else if (sortOrder.compare("desc") == 0) {
+    sortFlag = 0;
+  } else {
+    std::cout << "Please input asc or desc,the default sort order is desc!"
+              << std::endl;
+    sortFlag = 0;
+  }
+
   int timer = sampleTimer->createTimer();
   sampleTimer->resetTimer(timer);
   sampleTimer->startTimer(timer);
@@ -432,9 +411,11 @@ int BitonicSort::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels()) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
   sampleTimer->stopTimer(timer);
   totalKernelTime = (double)(sampleTimer->readTimer(timer));
@@ -502,7 +483,10 @@ void BitonicSort::printStats() {
     stats[2] = toString(sampleTimer->totalTime, std::dec);
     stats[3] = toString((length / sampleTimer->totalTime), std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, referenceKernelTime,
+                            "Host Elements/sec", length);
+
+    sampleTimer->printIterationStats();
   }
 }
 int BitonicSort::cleanup() {
@@ -554,7 +538,7 @@ int main(int argc, char *argv[]) {
       return SDK_FAILURE;
     }
 
-    if (clBitonicSort.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clBitonicSort.verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
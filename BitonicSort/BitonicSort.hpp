@@ -34,6 +34,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "BitonicSortCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -56,6 +57,7 @@ class BitonicSort {
   std::string sortOrder;         /**< Argument to indicate sorting order */
   cl_uint *input;                /**< Input array */
   cl_int length;                 /**< length of the array */
+  cl_uint paddedLength; /**< length rounded up to a power of 2 for the device */
   cl_uint *verificationInput; /**< Input array for reference implementation */
   cl_context context;         /**< CL context */
   cl_device_id *devices;      /**< CL device list */
@@ -80,6 +82,8 @@ class BitonicSort {
     input = NULL;
     verificationInput = NULL;
     length = 32768;
+    paddedLength = 0;
+    referenceKernelTime = 0;
     setupTime = 0;
     totalKernelTime = 0;
     iterations = 1;
@@ -123,13 +127,6 @@ class BitonicSort {
    */
   int runCLKernels();
 
-  /**
-   * Helper to swap two values if first one is greater
-   * @param a an unsigned int value
-   * @param b an unsigned int value
-   */
-  void swapIfFirstIsGreater(cl_uint *a, cl_uint *b);
-
   /**
    * Reference CPU implementation of Bitonic Sort
    * for performance comparison
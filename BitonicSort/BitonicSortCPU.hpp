@@ -0,0 +1,403 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef BITONICSORTCPU_H_
+#define BITONICSORTCPU_H_
+
+#include <CL/cl.h>
+#include <algorithm>
+#include <string.h>
+#include <vector>
+#include "SDKThread.hpp"
+
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host merge sort used as the BitonicSort reference and CPU baseline.
+ *
+ * Blocks of 16 keys are sorted in four SSE registers: a sorting network
+ * sorts the columns, a transpose turns them into four sorted rows and
+ * two levels of bitonic merges join the rows. Sorted runs are then
+ * merged four keys at a time, each step being a bitonic merge of two
+ * registers (Chhugani et al.). Unsigned compares come from SSE4.1 when
+ * available, or from signed compares on keys with the sign bit flipped.
+ *
+ * The input is split into BITONIC_CPU_CHUNK sized chunks which are sorted
+ * independently, one task each. Runs longer than a chunk are merged in
+ * chunk sized slices of the output: the start of a slice in the two
+ * input runs is found by binary search (merge path), so every merge pass
+ * keeps all threads busy. Any length works, and a decreasing sort
+ * reverses the increasing one.
+ */
+#define BITONIC_CPU_BLOCK 16    /**< keys sorted in register */
+#define BITONIC_CPU_CHUNK 8192  /**< keys per task */
+
+/**
+ * BitonicSortCPU
+ * Sorts unsigned keys in place
+ */
+class BitonicSortCPU {
+ public:
+  /**
+   * sort
+   * @param data keys to sort
+   * @param length number of keys
+   * @param increasing sort in increasing order, else decreasing
+   */
+  static void sort(cl_uint *data, size_t length, bool increasing) {
+    if (length > 1) {
+      SDKThreadPool &pool = SDKThreadPool::instance();
+      std::vector<cl_uint> scratch(length);
+      size_t slices = (length + BITONIC_CPU_CHUNK - 1) / BITONIC_CPU_CHUNK;
+
+      Job job;
+      job.src = data;
+      job.dst = &scratch[0];
+      job.length = length;
+      pool.parallelFor(0, slices, 0, sortChunks, &job);
+
+      // Chunks all end up in the same buffer, see sortChunks
+      for (size_t w = BITONIC_CPU_BLOCK; w < BITONIC_CPU_CHUNK; w *= 2) {
+        std::swap(job.src, job.dst);
+      }
+
+      for (job.width = BITONIC_CPU_CHUNK; job.width < length; job.width *= 2) {
+        pool.parallelFor(0, slices, 0, mergeSlices, &job);
+        std::swap(job.src, job.dst);
+      }
+
+      if (job.src != data) {
+        memcpy(data, job.src, length * sizeof(cl_uint));
+      }
+    }
+
+    if (!increasing) {
+      std::reverse(data, data + length);
+    }
+  }
+
+ private:
+  /**
+   * Job
+   * Buffers and run width of the current pass
+   */
+  struct Job {
+    cl_uint *src;  /**< sorted runs */
+    cl_uint *dst;  /**< merged runs */
+    size_t length; /**< number of keys */
+    size_t width;  /**< length of the runs in src */
+  };
+
+  /**
+   * sortChunks
+   * Sorts chunks [begin, end). Every chunk goes through the same number
+   * of passes, whatever its length, so all of them end up in the same
+   * buffer.
+   */
+  static void sortChunks(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    for (size_t c = begin; c < end; ++c) {
+      size_t base = c * BITONIC_CPU_CHUNK;
+      size_t n = std::min((size_t)BITONIC_CPU_CHUNK, job->length - base);
+      cl_uint *a = job->src + base;
+      cl_uint *b = job->dst + base;
+
+      size_t i = 0;
+      for (; i + BITONIC_CPU_BLOCK <= n; i += BITONIC_CPU_BLOCK) {
+        sortBlock(a + i);
+      }
+      insertionSort(a + i, n - i);
+
+      for (size_t w = BITONIC_CPU_BLOCK; w < BITONIC_CPU_CHUNK; w *= 2) {
+        for (size_t p = 0; p < n; p += 2 * w) {
+          size_t na = std::min(w, n - p);
+          size_t nb = std::min(w, n - p - na);
+          merge(a + p, na, a + p + na, nb, b + p);
+        }
+        std::swap(a, b);
+      }
+    }
+  }
+
+  /**
+   * mergeSlices
+   * Output slices [begin, end) of a pass merging runs of job->width keys
+   */
+  static void mergeSlices(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    for (size_t s = begin; s < end; ++s) {
+      size_t first = s * BITONIC_CPU_CHUNK;
+      size_t last = std::min(first + BITONIC_CPU_CHUNK, job->length);
+
+      // Slices never straddle two pairs of runs
+      size_t p = first - first % (2 * job->width);
+      const cl_uint *a = job->src + p;
+      size_t na = std::min(job->width, job->length - p);
+      size_t nb = std::min(job->width, job->length - p - na);
+
+      size_t i0 = split(a, na, a + na, nb, first - p);
+      size_t i1 = split(a, na, a + na, nb, last - p);
+      size_t j0 = first - p - i0;
+      size_t j1 = last - p - i1;
+      merge(a + i0, i1 - i0, a + na + j0, j1 - j0, job->dst + first);
+    }
+  }
+
+  /**
+   * split
+   * Number of keys of a among the first k keys of the merge of a and b
+   */
+  static size_t split(const cl_uint *a, size_t na, const cl_uint *b,
+                      size_t nb, size_t k) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = std::min(k, na);
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (a[mid] <= b[k - mid - 1]) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  /**
+   * insertionSort
+   * For the few keys left after the last full block
+   */
+  static void insertionSort(cl_uint *a, size_t n) {
+    for (size_t i = 1; i < n; ++i) {
+      cl_uint key = a[i];
+      size_t j = i;
+      for (; j > 0 && a[j - 1] > key; --j) {
+        a[j] = a[j - 1];
+      }
+      a[j] = key;
+    }
+  }
+
+  /**
+   * mergeScalar
+   * Merges sorted a and b into out
+   */
+  static void mergeScalar(const cl_uint *a, size_t na, const cl_uint *b,
+                          size_t nb, cl_uint *out) {
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+      *out++ = (b[j] < a[i]) ? b[j++] : a[i++];
+    }
+    memcpy(out, a + i, (na - i) * sizeof(cl_uint));
+    memcpy(out + na - i, b + j, (nb - j) * sizeof(cl_uint));
+  }
+
+#ifdef __SSE2__
+  typedef __m128i Vec;
+
+  /**
+   * load
+   * Four keys, with the sign bit flipped when compares are signed
+   */
+  static inline Vec load(const cl_uint *p) {
+    Vec v = _mm_loadu_si128((const Vec *)p);
+#ifndef __SSE4_1__
+    v = _mm_xor_si128(v, _mm_set1_epi32((int)0x80000000));
+#endif
+    return v;
+  }
+
+  /**
+   * store
+   * Four keys, undoing the flip of load
+   */
+  static inline void store(cl_uint *p, Vec v) {
+#ifndef __SSE4_1__
+    v = _mm_xor_si128(v, _mm_set1_epi32((int)0x80000000));
+#endif
+    _mm_storeu_si128((Vec *)p, v);
+  }
+
+  /**
+   * minmax
+   * Lane wise compare and exchange, the smaller keys end up in a
+   */
+  static inline void minmax(Vec &a, Vec &b) {
+#ifdef __SSE4_1__
+    Vec t = _mm_min_epu32(a, b);
+    b = _mm_max_epu32(a, b);
+    a = t;
+#else
+    Vec d = _mm_and_si128(_mm_xor_si128(a, b), _mm_cmpgt_epi32(a, b));
+    a = _mm_xor_si128(a, d);
+    b = _mm_xor_si128(b, d);
+#endif
+  }
+
+  /**
+   * reverse
+   * Lanes in reverse order
+   */
+  static inline Vec reverse(Vec v) {
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+  }
+
+  /**
+   * bitonic4
+   * Sorts a bitonic sequence of four keys
+   */
+  static inline Vec bitonic4(Vec x) {
+    Vec lo = x, hi = _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+    minmax(lo, hi);
+    x = _mm_unpacklo_epi64(lo, hi);
+
+    lo = x;
+    hi = _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+    minmax(lo, hi);
+    x = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo),
+                                        _mm_castsi128_ps(hi),
+                                        _MM_SHUFFLE(2, 0, 2, 0)));
+    return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 1, 2, 0));
+  }
+
+  /**
+   * merge4
+   * Merges two sorted registers, the four smallest keys end up in a
+   */
+  static inline void merge4(Vec &a, Vec &b) {
+    b = reverse(b);
+    minmax(a, b);
+    a = bitonic4(a);
+    b = bitonic4(b);
+  }
+
+  /**
+   * sortBlock
+   * Sorts BITONIC_CPU_BLOCK keys in register
+   */
+  static void sortBlock(cl_uint *p) {
+    Vec r0 = load(p), r1 = load(p + 4), r2 = load(p + 8), r3 = load(p + 12);
+
+    // Sort the columns, then make them rows
+    minmax(r0, r1);
+    minmax(r2, r3);
+    minmax(r0, r2);
+    minmax(r1, r3);
+    minmax(r1, r2);
+    __m128 t0 = _mm_castsi128_ps(r0), t1 = _mm_castsi128_ps(r1);
+    __m128 t2 = _mm_castsi128_ps(r2), t3 = _mm_castsi128_ps(r3);
+    _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+    r0 = _mm_castps_si128(t0);
+    r1 = _mm_castps_si128(t1);
+    r2 = _mm_castps_si128(t2);
+    r3 = _mm_castps_si128(t3);
+
+    // Two runs of 8
+    merge4(r0, r1);
+    merge4(r2, r3);
+
+    // One run of 16: half cleaner against the reversed second run, then
+    // each half is a bitonic sequence of 8
+    Vec s2 = reverse(r3), s3 = reverse(r2);
+    minmax(r0, s2);
+    minmax(r1, s3);
+    minmax(r0, r1);
+    minmax(s2, s3);
+
+    store(p, bitonic4(r0));
+    store(p + 4, bitonic4(r1));
+    store(p + 8, bitonic4(s2));
+    store(p + 12, bitonic4(s3));
+  }
+
+  /**
+   * merge
+   * Merges sorted a and b into out, four keys at a time
+   */
+  static void merge(const cl_uint *a, size_t na, const cl_uint *b, size_t nb,
+                    cl_uint *out) {
+    if (na < 4 || nb < 4) {
+      mergeScalar(a, na, b, nb, out);
+      return;
+    }
+
+    Vec lo = load(a), hi = load(b);
+    size_t i = 4, j = 4;
+    bool fromA;
+    for (;;) {
+      merge4(lo, hi);
+      store(out, lo);
+      out += 4;
+
+      // The next four keys come from the run with the smaller head
+      fromA = (j == nb) || (i < na && a[i] <= b[j]);
+      if (fromA && i + 4 <= na) {
+        lo = load(a + i);
+        i += 4;
+      } else if (!fromA && j + 4 <= nb) {
+        lo = load(b + j);
+        j += 4;
+      } else {
+        break;
+      }
+    }
+
+    // Fewer than four keys left in the run due next, finish in scalar
+    cl_uint held[4];
+    cl_uint tail[8];
+    store(held, hi);
+    if (fromA) {
+      mergeScalar(held, 4, a + i, na - i, tail);
+      mergeScalar(tail, 4 + na - i, b + j, nb - j, out);
+    } else {
+      mergeScalar(held, 4, b + j, nb - j, tail);
+      mergeScalar(tail, 4 + nb - j, a + i, na - i, out);
+    }
+  }
+#else
+  /**
+   * sortBlock
+   * Sorts BITONIC_CPU_BLOCK keys
+   */
+  static void sortBlock(cl_uint *p) { insertionSort(p, BITONIC_CPU_BLOCK); }
+
+  /**
+   * merge
+   * Merges sorted a and b into out
+   */
+  static void merge(const cl_uint *a, size_t na, const cl_uint *b, size_t nb,
+                    cl_uint *out) {
+    mergeScalar(a, na, b, nb, out);
+  }
+#endif
+};
+
+#endif  // BITONICSORTCPU_H_
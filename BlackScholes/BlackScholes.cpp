@@ -41,54 +41,26 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SIGMA_LOWER_LIMIT 0.01f
 #define SIGMA_UPPER_LIMIT 0.10f
 
-float BlackScholes::phi(float X) {
-  float y, absX, t;
-
-  // the coeffs
-  const float c1 = 0.319381530f;
-  const float c2 = -0.356563782f;
-  const float c3 = 1.781477937f;
-  const float c4 = -1.821255978f;
-  const float c5 = 1.330274429f;
-
-  const float oneBySqrt2pi = 0.398942280f;
-
-  absX = fabs(X);
-  t = 1.0f / (1.0f + 0.2316419f * absX);
-
-  y = 1.0f -
-      oneBySqrt2pi * exp(-X * X / 2.0f) * t *
-          (c1 + t * (c2 + t * (c3 + t * (c4 + t * c5))));
-
-  return (X < 0) ? (1.0f - y) : y;
-}
-
 void BlackScholes::blackScholesCPU() {
-  int y;
-  for (y = 0; y < width * height * 4; ++y) {
-    float d1, d2;
-    float sigmaSqrtT;
-    float KexpMinusRT;
-    float s =
-        S_LOWER_LIMIT * randArray[y] + S_UPPER_LIMIT * (1.0f - randArray[y]);
-    float k =
-        K_LOWER_LIMIT * randArray[y] + K_UPPER_LIMIT * (1.0f - randArray[y]);
-    float t =
-        T_LOWER_LIMIT * randArray[y] + T_UPPER_LIMIT * (1.0f - randArray[y]);
-    float r =
-        R_LOWER_LIMIT * randArray[y] + R_UPPER_LIMIT * (1.0f - randArray[y]);
-    float sigma = SIGMA_LOWER_LIMIT * randArray[y] +
-                  SIGMA_UPPER_LIMIT * (1.0f - randArray[y]);
-
-    sigmaSqrtT = sigma * sqrt(t);
-
-    d1 = (log(s / k) + (r + sigma * sigma / 2.0f) * t) / sigmaSqrtT;
-    d2 = d1 - sigmaSqrtT;
-
-    KexpMinusRT = k * exp(-r * t);
-    hostCallPrice[y] = s * phi(d1) - KexpMinusRT * phi(d2);
-    hostPutPrice[y] = KexpMinusRT * phi(-d2) - s * phi(-d1);
-  }
+  BlackScholesCPULimits<cl_float> limits;
+  limits.sLower = S_LOWER_LIMIT;
+  limits.sUpper = S_UPPER_LIMIT;
+  limits.kLower = K_LOWER_LIMIT;
+  limits.kUpper = K_UPPER_LIMIT;
+  limits.tLower = T_LOWER_LIMIT;
+  limits.tUpper = T_UPPER_LIMIT;
+  limits.rLower = R_LOWER_LIMIT;
+  limits.rUpper = R_UPPER_LIMIT;
+  limits.sigmaLower = SIGMA_LOWER_LIMIT;
+  limits.sigmaUpper = SIGMA_UPPER_LIMIT;
+
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
+  BlackScholesCPU<cl_float>::priceRandom(randArray, limits, hostCallPrice,
+                                        hostPutPrice, width * height * 4);
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 }
 
 int BlackScholes::setupBlackScholes() {
@@ -195,7 +167,7 @@ int BlackScholes::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -463,9 +435,11 @@ int BlackScholes::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -525,7 +499,10 @@ void BlackScholes::printStats() {
     stats[2] = toString(kernelTime, std::dec);
     stats[3] = toString(actualSamples / kernelTime, std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Options/sec",
+                            actualSamples);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -598,7 +575,7 @@ int main(int argc, char *argv[]) {
     }
 
     // Verifty
-    if (clBlackScholes.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clBlackScholes.verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
@@ -33,6 +33,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "BlackScholesCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -54,6 +55,7 @@ class BlackScholes {
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;   /**< time taken by the host reference pricing */
   cl_float *deviceCallPrice;     /**< Array of call price values */
   cl_float *devicePutPrice;      /**< Array of put price values */
   cl_float *hostCallPrice;       /**< Array of call price values */
@@ -83,19 +85,20 @@ class BlackScholes {
                               */
   BlackScholes()
       : samples(256 * 256 * 4),
-        blockSizeX(1),
-        blockSizeY(1),
+        randArray(NULL),
+        maxWorkItemSizes(NULL),
         setupTime(0),
         kernelTime(0),
-        randArray(NULL),
+        hostTime(0),
         deviceCallPrice(NULL),
         devicePutPrice(NULL),
         hostCallPrice(NULL),
         hostPutPrice(NULL),
         devices(NULL),
-        maxWorkItemSizes(NULL),
-        iterations(1),
-        useScalarKernel(false) {
+        useScalarKernel(false),
+        blockSizeX(1),
+        blockSizeY(1),
+        iterations(1) {
     width = 64;
     height = 64;
     sampleArgs = new CLCommandArgs();
@@ -190,11 +193,7 @@ class BlackScholes {
   int verifyResults();
 
  private:
-  //  Abromowitz Stegun approxmimation for PHI on the CPU(Cumulative Normal
-  //  Distribution Function)
-  float phi(float X);
-
-  //  CPU version of black scholes
+  //  CPU version of black scholes, see BlackScholesCPU.hpp
   void blackScholesCPU();
 };
 #endif
@@ -0,0 +1,327 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef BLACKSCHOLESCPU_H_
+#define BLACKSCHOLESCPU_H_
+
+#include <CL/cl.h>
+#include <math.h>
+#include "SDKMath.hpp"
+#include "SDKThread.hpp"
+
+using namespace appsdk;
+
+/**
+ * Host Black-Scholes engine shared by BlackScholes (cl_float) and
+ * BlackScholesDP (cl_double).
+ *
+ * Options are priced from structure-of-arrays inputs, several options per
+ * SSE2 register: 4 for cl_float, 2 for cl_double, with log and exp from
+ * SDKMath.hpp. The Abramowitz-Stegun polynomial for CND is the one the
+ * kernels use, and it is evaluated once per d: CND(-d) is taken from the
+ * same term. Without SSE2, and for the tail of an array, options are
+ * priced one at a time with libm.
+ */
+#define BLACKSCHOLES_CPU_BLOCK 1024 /**< options priced per task */
+
+/**
+ * BlackScholesCPULimits
+ * Ranges the option parameters are interpolated over from a random
+ * number r in [0, 1]: value = lower * r + upper * (1 - r)
+ */
+template <typename T>
+struct BlackScholesCPULimits {
+  T sLower, sUpper;         /**< spot price */
+  T kLower, kUpper;         /**< strike price */
+  T tLower, tUpper;         /**< time to expiry */
+  T rLower, rUpper;         /**< risk free rate */
+  T sigmaLower, sigmaUpper; /**< volatility */
+};
+
+/**
+ * BlackScholesScalar
+ * One option at a time, with libm
+ */
+template <typename T>
+struct BlackScholesScalar {
+  typedef T Vec;
+  typedef bool Mask;
+  enum { WIDTH = 1 };
+
+  static Vec load(const T *p) { return *p; }
+  static void store(T *p, Vec a) { *p = a; }
+  static Vec set(T a) { return a; }
+  static Vec add(Vec a, Vec b) { return a + b; }
+  static Vec sub(Vec a, Vec b) { return a - b; }
+  static Vec mul(Vec a, Vec b) { return a * b; }
+  static Vec div(Vec a, Vec b) { return a / b; }
+  static Vec sqrt(Vec a) { return ::sqrt(a); }
+  static Vec abs(Vec a) { return ::fabs(a); }
+  static Vec exp(Vec a) { return ::exp(a); }
+  static Vec log(Vec a) { return ::log(a); }
+  static Mask less(Vec a, Vec b) { return a < b; }
+  static Vec select(Mask m, Vec a, Vec b) { return m ? a : b; }
+};
+
+/**
+ * BlackScholesLanes
+ * Widest lane type available for T
+ */
+template <typename T>
+struct BlackScholesLanes {
+  typedef BlackScholesScalar<T> type;
+};
+
+#ifdef __SSE2__
+/**
+ * BlackScholesSSEFloat
+ * Four cl_float options per __m128
+ */
+struct BlackScholesSSEFloat {
+  typedef __m128 Vec;
+  typedef __m128 Mask;
+  enum { WIDTH = 4 };
+
+  static Vec load(const cl_float *p) { return _mm_loadu_ps(p); }
+  static void store(cl_float *p, Vec a) { _mm_storeu_ps(p, a); }
+  static Vec set(cl_float a) { return _mm_set1_ps(a); }
+  static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+  static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+  static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+  static Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+  static Vec sqrt(Vec a) { return _mm_sqrt_ps(a); }
+  static Vec abs(Vec a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  static Mask less(Vec a, Vec b) { return _mm_cmplt_ps(a, b); }
+  static Vec select(Mask m, Vec a, Vec b) {
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+  }
+  static Vec exp(Vec a) { return expSSE(a); }
+  static Vec log(Vec a) { return logSSE(a); }
+};
+
+/**
+ * BlackScholesSSEDouble
+ * Two cl_double options per __m128d
+ */
+struct BlackScholesSSEDouble {
+  typedef __m128d Vec;
+  typedef __m128d Mask;
+  enum { WIDTH = 2 };
+
+  static Vec load(const cl_double *p) { return _mm_loadu_pd(p); }
+  static void store(cl_double *p, Vec a) { _mm_storeu_pd(p, a); }
+  static Vec set(cl_double a) { return _mm_set1_pd(a); }
+  static Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+  static Vec sub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+  static Vec mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+  static Vec div(Vec a, Vec b) { return _mm_div_pd(a, b); }
+  static Vec sqrt(Vec a) { return _mm_sqrt_pd(a); }
+  static Vec abs(Vec a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+  static Mask less(Vec a, Vec b) { return _mm_cmplt_pd(a, b); }
+  static Vec select(Mask m, Vec a, Vec b) {
+    return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+  }
+  static Vec exp(Vec a) { return expSSE(a); }
+  static Vec log(Vec a) { return logSSE(a); }
+};
+
+template <>
+struct BlackScholesLanes<cl_float> {
+  typedef BlackScholesSSEFloat type;
+};
+
+template <>
+struct BlackScholesLanes<cl_double> {
+  typedef BlackScholesSSEDouble type;
+};
+#endif
+
+/**
+ * BlackScholesCPU
+ * Prices European call and put options on the host
+ */
+template <typename T>
+class BlackScholesCPU {
+ public:
+  /**
+   * price
+   * Prices count options on the calling thread
+   * @param s spot prices
+   * @param k strike prices
+   * @param t times to expiry
+   * @param r risk free rates
+   * @param sigma volatilities
+   * @param callPrice call price of each option
+   * @param putPrice put price of each option
+   * @param count number of options
+   */
+  static void price(const T *s, const T *k, const T *t, const T *r,
+                    const T *sigma, T *callPrice, T *putPrice,
+                    size_t count) {
+    size_t done = priceLanes<typename BlackScholesLanes<T>::type>(
+        s, k, t, r, sigma, callPrice, putPrice, count);
+    if (done < count) {
+      priceLanes<BlackScholesScalar<T> >(s + done, k + done, t + done,
+                                         r + done, sigma + done,
+                                         callPrice + done, putPrice + done,
+                                         count - done);
+    }
+  }
+
+  /**
+   * priceRandom
+   * Prices count options whose parameters are interpolated from
+   * randArray over limits, in blocks spread over SDKThreadPool
+   * @param randArray one random number in [0, 1] per option
+   * @param limits parameter ranges
+   * @param callPrice call price of each option
+   * @param putPrice put price of each option
+   * @param count number of options
+   */
+  static void priceRandom(const T *randArray,
+                          const BlackScholesCPULimits<T> &limits,
+                          T *callPrice, T *putPrice, size_t count) {
+    Job job;
+    job.randArray = randArray;
+    job.limits = &limits;
+    job.callPrice = callPrice;
+    job.putPrice = putPrice;
+    SDKThreadPool::instance().parallelFor(0, count, BLACKSCHOLES_CPU_BLOCK,
+                                          priceBlocks, &job);
+  }
+
+ private:
+  /**
+   * Job
+   * Arguments of priceRandom shared by its tasks
+   */
+  struct Job {
+    const T *randArray;                     /**< input random numbers */
+    const BlackScholesCPULimits<T> *limits; /**< parameter ranges */
+    T *callPrice;                           /**< call prices */
+    T *putPrice;                            /**< put prices */
+  };
+
+  /**
+   * cnd
+   * Abramowitz-Stegun cumulative normal distribution of x and of -x
+   */
+  template <class L>
+  static void cnd(typename L::Vec x, typename L::Vec &cndX,
+                  typename L::Vec &cndMinusX) {
+    typedef typename L::Vec Vec;
+    const Vec zero = L::set((T)0);
+    const Vec one = L::set((T)1);
+
+    Vec t = L::div(one, L::add(one, L::mul(L::set((T)0.2316419), L::abs(x))));
+    Vec poly =
+        L::add(L::set((T)-1.821255978), L::mul(t, L::set((T)1.330274429)));
+    poly = L::add(L::set((T)1.781477937), L::mul(t, poly));
+    poly = L::add(L::set((T)-0.356563782), L::mul(t, poly));
+    poly = L::add(L::set((T)0.319381530), L::mul(t, poly));
+
+    Vec expX = L::exp(L::mul(L::mul(L::sub(zero, x), x), L::set((T)0.5)));
+    Vec y = L::sub(
+        one, L::mul(L::mul(L::mul(L::set((T)0.398942280), expX), t), poly));
+    Vec oneMinusY = L::sub(one, y);
+
+    cndX = L::select(L::less(x, zero), oneMinusY, y);
+    cndMinusX = L::select(L::less(zero, x), oneMinusY, y);
+  }
+
+  /**
+   * priceLanes
+   * Prices whole groups of L::WIDTH options
+   * @return number of options priced
+   */
+  template <class L>
+  static size_t priceLanes(const T *s, const T *k, const T *t, const T *r,
+                           const T *sigma, T *callPrice, T *putPrice,
+                           size_t count) {
+    typedef typename L::Vec Vec;
+    const Vec zero = L::set((T)0);
+    const Vec half = L::set((T)0.5);
+
+    size_t i = 0;
+    for (; i + L::WIDTH <= count; i += L::WIDTH) {
+      Vec vs = L::load(s + i);
+      Vec vk = L::load(k + i);
+      Vec vt = L::load(t + i);
+      Vec vr = L::load(r + i);
+      Vec vsigma = L::load(sigma + i);
+
+      Vec sigmaSqrtT = L::mul(vsigma, L::sqrt(vt));
+      Vec d1 = L::add(L::log(L::div(vs, vk)),
+                      L::mul(L::add(vr, L::mul(L::mul(vsigma, vsigma), half)),
+                             vt));
+      d1 = L::div(d1, sigmaSqrtT);
+      Vec d2 = L::sub(d1, sigmaSqrtT);
+      Vec kExpMinusRT = L::mul(vk, L::exp(L::mul(L::sub(zero, vr), vt)));
+
+      Vec cndD1, cndMinusD1, cndD2, cndMinusD2;
+      cnd<L>(d1, cndD1, cndMinusD1);
+      cnd<L>(d2, cndD2, cndMinusD2);
+
+      L::store(callPrice + i,
+               L::sub(L::mul(vs, cndD1), L::mul(kExpMinusRT, cndD2)));
+      L::store(putPrice + i,
+               L::sub(L::mul(kExpMinusRT, cndMinusD2), L::mul(vs, cndMinusD1)));
+    }
+    return i;
+  }
+
+  /**
+   * priceBlocks
+   * Interpolates the parameters of options [begin, end) a block at a time
+   * and prices them
+   */
+  static void priceBlocks(size_t begin, size_t end, void *arg) {
+    Job *job = (Job *)arg;
+    const BlackScholesCPULimits<T> &limits = *job->limits;
+    T s[BLACKSCHOLES_CPU_BLOCK], k[BLACKSCHOLES_CPU_BLOCK];
+    T t[BLACKSCHOLES_CPU_BLOCK], r[BLACKSCHOLES_CPU_BLOCK];
+    T sigma[BLACKSCHOLES_CPU_BLOCK];
+
+    for (size_t block = begin; block < end; block += BLACKSCHOLES_CPU_BLOCK) {
+      size_t n = (end - block < BLACKSCHOLES_CPU_BLOCK)
+                     ? end - block
+                     : (size_t)BLACKSCHOLES_CPU_BLOCK;
+      const T *rand = job->randArray + block;
+      for (size_t i = 0; i < n; i++) {
+        T x = rand[i];
+        s[i] = limits.sLower * x + limits.sUpper * (1 - x);
+        k[i] = limits.kLower * x + limits.kUpper * (1 - x);
+        t[i] = limits.tLower * x + limits.tUpper * (1 - x);
+        r[i] = limits.rLower * x + limits.rUpper * (1 - x);
+        sigma[i] = limits.sigmaLower * x + limits.sigmaUpper * (1 - x);
+      }
+      price(s, k, t, r, sigma, job->callPrice + block, job->putPrice + block,
+            n);
+    }
+  }
+};
+
+#endif
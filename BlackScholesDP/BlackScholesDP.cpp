@@ -44,54 +44,26 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SIGMA_LOWER_LIMIT 0.01
 #define SIGMA_UPPER_LIMIT 0.10
 
-double BlackScholesDP::phi(double X) {
-  double y, absX, t;
-
-  // the coeffs
-  const double c1 = 0.319381530;
-  const double c2 = -0.356563782;
-  const double c3 = 1.781477937;
-  const double c4 = -1.821255978;
-  const double c5 = 1.330274429;
-
-  const double oneBySqrt2pi = 0.398942280;
-
-  absX = fabs(X);
-  t = 1.0 / (1.0 + 0.2316419 * absX);
-
-  y = 1.0 -
-      oneBySqrt2pi * exp(-X * X / 2.0) * t *
-          (c1 + t * (c2 + t * (c3 + t * (c4 + t * c5))));
-
-  return (X < 0) ? (1.0 - y) : y;
-}
-
 void BlackScholesDP::blackScholesDPCPU() {
-  int y;
-  for (y = 0; y < width * height * 4; ++y) {
-    double d1, d2;
-    double sigmaSqrtT;
-    double KexpMinusRT;
-    double s =
-        S_LOWER_LIMIT * randArray[y] + S_UPPER_LIMIT * (1.0 - randArray[y]);
-    double k =
-        K_LOWER_LIMIT * randArray[y] + K_UPPER_LIMIT * (1.0 - randArray[y]);
-    double t =
-        T_LOWER_LIMIT * randArray[y] + T_UPPER_LIMIT * (1.0 - randArray[y]);
-    double r =
-        R_LOWER_LIMIT * randArray[y] + R_UPPER_LIMIT * (1.0 - randArray[y]);
-    double sigma = SIGMA_LOWER_LIMIT * randArray[y] +
-                   SIGMA_UPPER_LIMIT * (1.0 - randArray[y]);
-
-    sigmaSqrtT = sigma * sqrt(t);
-
-    d1 = (log(s / k) + (r + sigma * sigma / 2.0) * t) / sigmaSqrtT;
-    d2 = d1 - sigmaSqrtT;
-
-    KexpMinusRT = k * exp(-r * t);
-    hostCallPrice[y] = s * phi(d1) - KexpMinusRT * phi(d2);
-    hostPutPrice[y] = KexpMinusRT * phi(-d2) - s * phi(-d1);
-  }
+  BlackScholesCPULimits<cl_double> limits;
+  limits.sLower = S_LOWER_LIMIT;
+  limits.sUpper = S_UPPER_LIMIT;
+  limits.kLower = K_LOWER_LIMIT;
+  limits.kUpper = K_UPPER_LIMIT;
+  limits.tLower = T_LOWER_LIMIT;
+  limits.tUpper = T_UPPER_LIMIT;
+  limits.rLower = R_LOWER_LIMIT;
+  limits.rUpper = R_UPPER_LIMIT;
+  limits.sigmaLower = SIGMA_LOWER_LIMIT;
+  limits.sigmaUpper = SIGMA_UPPER_LIMIT;
+
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
+  BlackScholesCPU<cl_double>::priceRandom(randArray, limits, hostCallPrice,
+                                       hostPutPrice, width * height * 4);
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 }
 
 int BlackScholesDP::setupBlackScholesDP() {
@@ -202,7 +174,7 @@ int BlackScholesDP::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -497,9 +469,11 @@ int BlackScholesDP::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -559,7 +533,10 @@ void BlackScholesDP::printStats() {
     stats[2] = toString(kernelTime, std::dec);
     stats[3] = toString(actualSamples / sampleTimer->totalTime, std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Options/sec",
+                            actualSamples);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -634,7 +611,7 @@ int main(int argc, char *argv[]) {
     }
 
     // Verifty
-    if (clBlackScholesDP.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clBlackScholesDP.verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
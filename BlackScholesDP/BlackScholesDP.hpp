@@ -33,6 +33,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "../BlackScholes/BlackScholesCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -52,6 +53,7 @@ class BlackScholesDP {
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;   /**< time taken by the host reference pricing */
   cl_double *deviceCallPrice;    /**< Array of call price values */
   cl_double *devicePutPrice;     /**< Array of put price values */
   cl_double *hostCallPrice;      /**< Array of call price values */
@@ -80,16 +82,17 @@ class BlackScholesDP {
    */
   BlackScholesDP()
       : samples(256 * 256 * 4),
-        blockSizeX(1),
-        blockSizeY(1),
+        randArray(NULL),
         setupTime(0),
         kernelTime(0),
-        randArray(NULL),
+        hostTime(0),
         deviceCallPrice(NULL),
         devicePutPrice(NULL),
         hostCallPrice(NULL),
         hostPutPrice(NULL),
         devices(NULL),
+        blockSizeX(1),
+        blockSizeY(1),
         iterations(1) {
     width = 64;
     height = 64;
@@ -185,13 +188,7 @@ class BlackScholesDP {
 
  private:
   /**
-   *  Abromowitz Stegun approxmimation for PHI on the CPU(Cumulative Normal
-   * Distribution Function)
-   */
-  double phi(double X);
-
-  /**
-   *  CPU version of black scholes
+   *  CPU version of black scholes, see BlackScholesCPU.hpp
    */
   void blackScholesDPCPU();
 };
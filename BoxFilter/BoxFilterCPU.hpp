@@ -0,0 +1,399 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef BOXFILTERCPU_H_
+#define BOXFILTERCPU_H_
+
+#include <CL/cl.h>
+#include <algorithm>
+#include <vector>
+#include "SDKThread.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host box filters used to verify BoxFilterSAT and BoxFilterSeparable.
+ *
+ * Both produce exactly what the direct window sums produce: pixels whose
+ * box fits in the image get the truncated channel sums divided by the
+ * filter size, other pixels are left unchanged. The cost per pixel does
+ * not depend on the filter width.
+ *
+ * - sat: builds a 64-bit summed-area table with a zero border, first a
+ *   prefix along every row, then a running sum down bands of
+ *   BF_CPU_BAND columns, one contiguous row segment per step. Each box is
+ *   then four lookups.
+ * - separable: a sliding window along every row into a temporary image,
+ *   then a sliding window down bands of columns, adding the row entering
+ *   the window and subtracting the row leaving it.
+ *
+ * Rows and bands are tasks on the SDKThreadPool. A pixel's channels are
+ * processed together in SSE registers and divided in double precision,
+ * which truncates exactly for sums below 2^31.
+ */
+#define BF_CPU_BAND 64  /**< columns per column-pass task */
+#define BF_CPU_ROWS 16  /**< rows per row-pass task */
+
+/**
+ * BoxFilterCPU
+ * Summed-area table and separable box filters of a uchar4 image
+ */
+class BoxFilterCPU {
+ public:
+  /**
+   * sat
+   * Box filter through a summed-area table
+   * @param output filtered image, pixels outside the apron are untouched
+   * @param input image to filter
+   * @param width pixels per row
+   * @param height rows
+   * @param filterWidth box width, the sums are divided by its square
+   */
+  static void sat(cl_uchar4 *output, const cl_uchar4 *input, cl_uint width,
+                  cl_uint height, cl_uint filterWidth) {
+    Job job(output, input, width, height, filterWidth);
+    job.divisor = filterWidth * filterWidth;
+    std::vector<cl_ulong> table((size_t)(width + 1) * (height + 1) * 4, 0);
+    job.table = &table[0];
+
+    SDKThreadPool &pool = SDKThreadPool::instance();
+    pool.parallelFor(0, tasks(height, BF_CPU_ROWS), 1, satRows, &job);
+    pool.parallelFor(0, tasks(width + 1, BF_CPU_BAND), 1, satColumns, &job);
+    if (job.apron(width) && job.apron(height)) {
+      pool.parallelFor(0, tasks(height, BF_CPU_ROWS), 1, satBoxes, &job);
+    }
+  }
+
+  /**
+   * separable
+   * Box filter as a horizontal then a vertical sliding window
+   * @param output filtered image, pixels outside the apron are untouched
+   * @param input image to filter
+   * @param width pixels per row
+   * @param height rows
+   * @param filterWidth box width, each pass divides by it
+   */
+  static void separable(cl_uchar4 *output, const cl_uchar4 *input,
+                        cl_uint width, cl_uint height, cl_uint filterWidth) {
+    Job job(output, input, width, height, filterWidth);
+    job.divisor = filterWidth;
+    std::vector<cl_uchar4> temp((size_t)width * height);
+    job.temp = &temp[0];
+
+    SDKThreadPool &pool = SDKThreadPool::instance();
+    pool.parallelFor(0, tasks(height, BF_CPU_ROWS), 1, slideRows, &job);
+    if (job.apron(height)) {
+      pool.parallelFor(0, tasks(width, BF_CPU_BAND), 1, slideColumns, &job);
+    }
+  }
+
+ private:
+  /**
+   * Job
+   * Images and filter shared by all tasks
+   */
+  struct Job {
+    cl_uchar4 *output;      /**< filtered image */
+    const cl_uchar4 *input; /**< image to filter */
+    size_t width;           /**< pixels per row */
+    size_t height;          /**< rows */
+    size_t radius;          /**< pixels on each side of the centre */
+    cl_uint divisor;        /**< divisor of the box sums */
+    cl_ulong *table;        /**< summed-area table, (width + 1) x (height + 1) */
+    cl_uchar4 *temp;        /**< horizontally filtered image */
+
+    Job(cl_uchar4 *output, const cl_uchar4 *input, cl_uint width,
+        cl_uint height, cl_uint filterWidth)
+        : output(output),
+          input(input),
+          width(width),
+          height(height),
+          radius((filterWidth - 1) / 2),
+          divisor(1),
+          table(NULL),
+          temp(NULL) {}
+
+    // Whether a box fits along a dimension of this size
+    bool apron(size_t size) const { return 2 * radius < size; }
+  };
+
+  static size_t tasks(size_t size, size_t grain) {
+    return (size + grain - 1) / grain;
+  }
+
+#ifdef __SSE2__
+  typedef __m128i Sum; /**< four 32-bit channel sums */
+
+  static inline Sum zero() { return _mm_setzero_si128(); }
+  static inline Sum add(Sum a, Sum b) { return _mm_add_epi32(a, b); }
+  static inline Sum sub(Sum a, Sum b) { return _mm_sub_epi32(a, b); }
+
+  static inline Sum load(const cl_uchar4 &p) {
+    __m128i z = _mm_setzero_si128();
+    __m128i v = _mm_cvtsi32_si128(*(const int *)&p);
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, z), z);
+  }
+
+  // Truncated quotient, exact in double for sums below 2^31
+  static inline void store(cl_uchar4 &p, Sum s, cl_uint divisor) {
+    __m128d d = _mm_set1_pd((double)divisor);
+    __m128i lo = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(s), d));
+    __m128i hi = _mm_cvttpd_epi32(
+        _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(s, 8)), d));
+    __m128i v = _mm_unpacklo_epi64(lo, hi);
+    v = _mm_packs_epi32(v, v);
+    *(int *)&p = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+  }
+#else
+  struct Sum {
+    cl_int s[4];
+  };
+
+  static inline Sum zero() {
+    Sum r = {{0, 0, 0, 0}};
+    return r;
+  }
+  static inline Sum add(Sum a, Sum b) {
+    for (int k = 0; k < 4; ++k) a.s[k] += b.s[k];
+    return a;
+  }
+  static inline Sum sub(Sum a, Sum b) {
+    for (int k = 0; k < 4; ++k) a.s[k] -= b.s[k];
+    return a;
+  }
+  static inline Sum load(const cl_uchar4 &p) {
+    Sum r;
+    for (int k = 0; k < 4; ++k) r.s[k] = p.s[k];
+    return r;
+  }
+  static inline void store(cl_uchar4 &p, Sum s, cl_uint divisor) {
+    for (int k = 0; k < 4; ++k) p.s[k] = (cl_uchar)(s.s[k] / (cl_int)divisor);
+  }
+#endif
+
+  /**
+   * satRows
+   * Prefix sums of the rows of tasks [begin, end) into table rows 1..height
+   */
+  static void satRows(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    const size_t stride = (job->width + 1) * 4;
+
+    for (size_t y = begin * BF_CPU_ROWS;
+         y < end * BF_CPU_ROWS && y < job->height; ++y) {
+      const cl_uchar4 *in = job->input + y * job->width;
+      cl_ulong *row = job->table + (y + 1) * stride + 4;
+#ifdef __SSE2__
+      const __m128i z = _mm_setzero_si128();
+      __m128i c01 = z, c23 = z;
+      for (size_t x = 0; x < job->width; ++x) {
+        __m128i v = _mm_unpacklo_epi16(
+            _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int *)&in[x]), z),
+            z);
+        c01 = _mm_add_epi64(c01, _mm_unpacklo_epi32(v, z));
+        c23 = _mm_add_epi64(c23, _mm_unpackhi_epi32(v, z));
+        _mm_storeu_si128((__m128i *)(row + 4 * x), c01);
+        _mm_storeu_si128((__m128i *)(row + 4 * x + 2), c23);
+      }
+#else
+      cl_ulong c[4] = {0, 0, 0, 0};
+      for (size_t x = 0; x < job->width; ++x) {
+        for (int k = 0; k < 4; ++k) {
+          c[k] += in[x].s[k];
+          row[4 * x + k] = c[k];
+        }
+      }
+#endif
+    }
+  }
+
+  /**
+   * satColumns
+   * Adds each table row to the next, down bands [begin, end) of columns
+   */
+  static void satColumns(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    const size_t stride = (job->width + 1) * 4;
+    size_t x0 = begin * BF_CPU_BAND * 4;
+    size_t x1 = end * BF_CPU_BAND * 4 < stride ? end * BF_CPU_BAND * 4 : stride;
+
+    for (size_t y = 2; y <= job->height; ++y) {
+      const cl_ulong *above = job->table + (y - 1) * stride;
+      cl_ulong *row = job->table + y * stride;
+#ifdef __SSE2__
+      for (size_t k = x0; k < x1; k += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(above + k));
+        __m128i r = _mm_loadu_si128((const __m128i *)(row + k));
+        _mm_storeu_si128((__m128i *)(row + k), _mm_add_epi64(a, r));
+      }
+#else
+      for (size_t k = x0; k < x1; ++k) {
+        row[k] += above[k];
+      }
+#endif
+    }
+  }
+
+  /**
+   * satBoxes
+   * Four-corner box sums for the apron pixels of rows in tasks [begin, end)
+   */
+  static void satBoxes(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    const size_t stride = (job->width + 1) * 4;
+    const size_t r = job->radius;
+    const size_t y0 = begin * BF_CPU_ROWS > r ? begin * BF_CPU_ROWS : r;
+    const size_t y1 = end * BF_CPU_ROWS < job->height - r
+                          ? end * BF_CPU_ROWS
+                          : job->height - r;
+#ifdef __SSE2__
+    // Boxes narrower than this sum below 2^31 and divide in registers
+    const size_t side = 2 * r + 1;
+    const bool narrow = 255.0 * side * side < 2147483648.0;
+#endif
+
+    for (size_t y = y0; y < y1; ++y) {
+      // Table row y + r + 1 closes the box, row y - r opens it
+      const cl_ulong *bottom = job->table + (y + r + 1) * stride;
+      const cl_ulong *top = job->table + (y - r) * stride;
+      cl_uchar4 *out = job->output + y * job->width;
+
+      for (size_t x = r; x < job->width - r; ++x) {
+        size_t right = (x + r + 1) * 4;
+        size_t left = (x - r) * 4;
+#ifdef __SSE2__
+        if (narrow) {
+          __m128i lo = _mm_sub_epi64(
+              _mm_add_epi64(
+                  _mm_loadu_si128((const __m128i *)(bottom + right)),
+                  _mm_loadu_si128((const __m128i *)(top + left))),
+              _mm_add_epi64(
+                  _mm_loadu_si128((const __m128i *)(bottom + left)),
+                  _mm_loadu_si128((const __m128i *)(top + right))));
+          __m128i hi = _mm_sub_epi64(
+              _mm_add_epi64(
+                  _mm_loadu_si128((const __m128i *)(bottom + right + 2)),
+                  _mm_loadu_si128((const __m128i *)(top + left + 2))),
+              _mm_add_epi64(
+                  _mm_loadu_si128((const __m128i *)(bottom + left + 2)),
+                  _mm_loadu_si128((const __m128i *)(top + right + 2))));
+          // Low halves of the 64-bit sums as four 32-bit lanes
+          __m128i s = _mm_unpacklo_epi64(
+              _mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 1, 2, 0)),
+              _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 1, 2, 0)));
+          store(out[x], s, job->divisor);
+          continue;
+        }
+#endif
+        for (int k = 0; k < 4; ++k) {
+          cl_ulong s = bottom[right + k] - bottom[left + k] -
+                       top[right + k] + top[left + k];
+          out[x].s[k] = (cl_uchar)(s / job->divisor);
+        }
+      }
+    }
+  }
+
+  /**
+   * slideRows
+   * Horizontal window of the rows of tasks [begin, end) into temp, zero
+   * outside the apron
+   */
+  static void slideRows(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    const size_t width = job->width;
+    const size_t r = job->radius;
+    cl_uchar4 blank;
+    blank.s[0] = blank.s[1] = blank.s[2] = blank.s[3] = 0;
+
+    for (size_t y = begin * BF_CPU_ROWS;
+         y < end * BF_CPU_ROWS && y < job->height; ++y) {
+      const cl_uchar4 *in = job->input + y * width;
+      cl_uchar4 *out = job->temp + y * width;
+
+      if (!job->apron(width)) {
+        std::fill(out, out + width, blank);
+        continue;
+      }
+      std::fill(out, out + r, blank);
+      std::fill(out + width - r, out + width, blank);
+
+      Sum s = zero();
+      for (size_t x = 0; x < 2 * r; ++x) {
+        s = add(s, load(in[x]));
+      }
+      for (size_t x = r; x < width - r; ++x) {
+        s = add(s, load(in[x + r]));
+        store(out[x], s, job->divisor);
+        s = sub(s, load(in[x - r]));
+      }
+    }
+  }
+
+  /**
+   * slideColumns
+   * Vertical window of temp down bands [begin, end) of columns
+   */
+  static void slideColumns(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    const size_t width = job->width;
+    const size_t r = job->radius;
+    Sum s[BF_CPU_BAND];
+
+    for (size_t band = begin; band < end; ++band) {
+      size_t x0 = band * BF_CPU_BAND;
+      size_t n = width - x0 < BF_CPU_BAND ? width - x0 : BF_CPU_BAND;
+      const cl_uchar4 *in = job->temp + x0;
+      cl_uchar4 *out = job->output + x0;
+
+      for (size_t k = 0; k < n; ++k) {
+        s[k] = zero();
+      }
+      for (size_t y = 0; y < 2 * r; ++y) {
+        const cl_uchar4 *row = in + y * width;
+        for (size_t k = 0; k < n; ++k) {
+          s[k] = add(s[k], load(row[k]));
+        }
+      }
+      for (size_t y = r; y < job->height - r; ++y) {
+        const cl_uchar4 *enter = in + (y + r) * width;
+        const cl_uchar4 *leave = in + (y - r) * width;
+        cl_uchar4 *dst = out + y * width;
+        for (size_t k = 0; k < n; ++k) {
+          s[k] = add(s[k], load(enter[k]));
+          store(dst[k], s[k], job->divisor);
+          s[k] = sub(s[k], load(leave[k]));
+        }
+      }
+    }
+  }
+};
+
+#endif  // BOXFILTERCPU_H_
@@ -163,7 +163,7 @@ int BoxFilterSAT::setupCL() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -534,9 +534,11 @@ int BoxFilterSAT::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Set kernel arguments and run kernel
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -604,30 +606,16 @@ int BoxFilterSAT::cleanup() {
 
 void BoxFilterSAT::boxFilterCPUReference() {
   std::cout << "Verifying results...";
-  int t = (filterWidth - 1) / 2;
-  int filterSize = filterWidth * filterWidth;
-
-  for (int y = 0; y < (int)height; y++) {
-    for (int x = 0; x < (int)width; x++) {
-      // Only threads inside apron will calculate their pixel value
-      if (x >= t && x < (int)(width - t) && y >= t && y < (int)(height - t)) {
-        cl_int4 sum = {0, 0, 0, 0};
-        // For all pixels inside box
-        for (int y1 = -t; y1 <= t; y1++) {
-          for (int x1 = -t; x1 <= t; x1++) {
-            sum.s[0] += inputImageData[x + x1 + (y + y1) * width].s[0];
-            sum.s[1] += inputImageData[x + x1 + (y + y1) * width].s[1];
-            sum.s[2] += inputImageData[x + x1 + (y + y1) * width].s[2];
-            sum.s[3] += inputImageData[x + x1 + (y + y1) * width].s[3];
-          }
-        }
-        verificationOutput[x + y * width].s[0] = sum.s[0] / filterSize;
-        verificationOutput[x + y * width].s[1] = sum.s[1] / filterSize;
-        verificationOutput[x + y * width].s[2] = sum.s[2] / filterSize;
-        verificationOutput[x + y * width].s[3] = sum.s[3] / filterSize;
-      }
-    }
-  }
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
+
+  // Summed-area table, four lookups per pixel whatever the filter width
+  BoxFilterCPU::sat(verificationOutput, inputImageData, width, height,
+                    filterWidth);
+
+  sampleTimer->stopTimer(timer);
+  hostTime = (double)(sampleTimer->readTimer(timer));
   std::cout << "done!" << std::endl;
 }
 
@@ -653,9 +641,10 @@ int BoxFilterSAT::verifyResults() {
 
 void BoxFilterSAT::printStats() {
   if (sampleArgs->timing) {
-    std::string strArray[4] =
-
-        {"Width", "Height", "Time(sec)", "[Transfer+Kernel]Time(sec)"};
+    std::string strArray[4] = {"Width",
+                               "Height",
+                               "Time(sec)",
+                               "[Transfer+Kernel]Time(sec)"};
     std::string stats[4];
 
     sampleTimer->totalTime = setupTime + kernelTime;
@@ -665,7 +654,10 @@ void BoxFilterSAT::printStats() {
     stats[2] = toString(sampleTimer->totalTime, std::dec);
     stats[3] = toString(kernelTime, std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Pixels/sec",
+                            width * height);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -689,7 +681,7 @@ int BoxFilterSAT::runSATversion(int argc, char *argv[]) {
       return SDK_FAILURE;
     }
 
-    if (verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
@@ -132,7 +132,7 @@ int BoxFilterSeparable::setupCL() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -411,9 +411,11 @@ int BoxFilterSeparable::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Set kernel arguments and run kernel
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -471,58 +473,17 @@ int BoxFilterSeparable::cleanup() {
 
 int BoxFilterSeparable::boxFilterCPUReference() {
   std::cout << "Verifying results...";
-  int t = (filterWidth - 1) / 2;
-  int filterSize = filterWidth;
-
-  cl_uchar4* tempData = (cl_uchar4*)malloc(width * height * 4);
-  if (tempData == NULL) {
-    std::cout << "Memory Allocation error.\n";
-    return SDK_FAILURE;
-  }
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
 
-  memset(tempData, 0, width * height * sizeof(cl_uchar4));
-
-  // Horizontal filter
-  for (int y = 0; y < (int)height; y++) {
-    for (int x = 0; x < (int)width; x++) {
-      // Only threads inside horizontal apron will calculate output value
-      if (x >= t && x < (int)(width - t)) {
-        cl_int4 sum = {0, 0, 0, 0};
-        for (int x1 = -t; x1 <= t; x1++) {
-          sum.s[0] += inputImageData[x + x1 + y * width].s[0];
-          sum.s[1] += inputImageData[x + x1 + y * width].s[1];
-          sum.s[2] += inputImageData[x + x1 + y * width].s[2];
-          sum.s[3] += inputImageData[x + x1 + y * width].s[3];
-        }
-        tempData[x + y * width].s[0] = sum.s[0] / filterSize;
-        tempData[x + y * width].s[1] = sum.s[1] / filterSize;
-        tempData[x + y * width].s[2] = sum.s[2] / filterSize;
-        tempData[x + y * width].s[3] = sum.s[3] / filterSize;
-      }
-    }
-  }
+  // Sliding windows along the rows then down the columns
+  BoxFilterCPU::separable(verificationOutput, inputImageData, width, height,
+                          filterWidth);
 
-  // Vertical filter
-  for (int y = 0; y < (int)height; y++) {
-    for (int x = 0; x < (int)width; x++) {
-      // Only threads inside vertical apron will calculate output value
-      if (y >= t && y < (int)(height - t)) {
-        cl_int4 sum = {0, 0, 0, 0};
-        for (int y1 = -t; y1 <= t; y1++) {
-          sum.s[0] += tempData[x + (y + y1) * width].s[0];
-          sum.s[1] += tempData[x + (y + y1) * width].s[1];
-          sum.s[2] += tempData[x + (y + y1) * width].s[2];
-          sum.s[3] += tempData[x + (y + y1) * width].s[3];
-        }
-        verificationOutput[x + y * width].s[0] = sum.s[0] / filterSize;
-        verificationOutput[x + y * width].s[1] = sum.s[1] / filterSize;
-        verificationOutput[x + y * width].s[2] = sum.s[2] / filterSize;
-        verificationOutput[x + y * width].s[3] = sum.s[3] / filterSize;
-      }
-    }
-  }
+  sampleTimer->stopTimer(timer);
+  hostTime = (double)(sampleTimer->readTimer(timer));
 
-  FREE(tempData);
   return SDK_SUCCESS;
 }
 
@@ -562,7 +523,10 @@ void BoxFilterSeparable::printStats() {
     stats[2] = toString(sampleTimer->totalTime, std::dec);
     stats[3] = toString(kernelTime, std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Pixels/sec",
+                            width * height);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -586,7 +550,7 @@ int BoxFilterSeparable::runSeparableVersion(int argc, char* argv[]) {
       return SDK_FAILURE;
     }
 
-    if (verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
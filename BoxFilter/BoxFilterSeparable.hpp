@@ -34,6 +34,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "BoxFilterCPU.hpp"
 #include "SDKBitMap.hpp"
 
 using namespace appsdk;
@@ -55,6 +56,7 @@ class BoxFilterSeparable {
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;   /**< time taken by the host reference */
   cl_uchar4* inputImageData;  /**< Input bitmap data to device */
   cl_uchar4* outputImageData; /**< Output from device */
   cl_context context;         /**< CL context */
@@ -114,6 +116,7 @@ class BoxFilterSeparable {
     blockSizeX = GROUP_SIZE;
     blockSizeY = 1;
     iterations = 1;
+    hostTime = 0;
     filterWidth = FILTER_WIDTH;
     sampleArgs = new CLCommandArgs();
     sampleTimer = new SDKTimer();
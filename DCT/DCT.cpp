@@ -104,7 +104,7 @@ int DCT::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -303,71 +303,13 @@ int DCT::runCLKernels(void) {
   return SDK_SUCCESS;
 }
 
-cl_uint DCT::getIdx(cl_uint blockIdx, cl_uint blockIdy, cl_uint localIdx,
-                    cl_uint localIdy, cl_uint blockWidth, cl_uint globalWidth) {
-  cl_uint globalIdx = blockIdx * blockWidth + localIdx;
-  cl_uint globalIdy = blockIdy * blockWidth + localIdy;
-  return (globalIdy * globalWidth + globalIdx);
-}
-
 /*
  * Reference implementation of the Discrete Cosine Transform on the CPU
  */
 void DCT::DCTCPUReference(cl_float *verificationOutput, const cl_float *input,
-                          const cl_float *dct8x8, const cl_uint width,
-                          const cl_uint height, const cl_uint numBlocksX,
-                          const cl_uint numBlocksY, const cl_uint inverse) {
-  cl_float *temp = (cl_float *)malloc(width * height * sizeof(cl_float));
-
-  // for each block in the image
-  for (cl_uint blockIdy = 0; blockIdy < numBlocksY; ++blockIdy)
-    for (cl_uint blockIdx = 0; blockIdx < numBlocksX; ++blockIdx) {
-      //  First calculate A^T * X for FDCT or A * X for iDCT
-      for (cl_uint j = 0; j < blockWidth; ++j)
-        for (cl_uint i = 0; i < blockWidth; ++i) {
-          cl_uint index = getIdx(blockIdx, blockIdy, i, j, blockWidth, width);
-          cl_float tmp = 0.0f;
-          for (cl_uint k = 0; k < blockWidth; ++k) {
-            // multiply with dct (j,k)
-            cl_uint index1 = j * blockWidth + k;
-            // input(i,k)
-            cl_uint index2 =
-                getIdx(blockIdx, blockIdy, i, k, blockWidth, width);
-
-            if (inverse)
-              tmp += dct8x8[index1] * input[index2];
-            else
-              tmp += dct8x8_trans[index1] * input[index2];
-          }
-          temp[index] = tmp;
-        }
-
-      // And now for FDCT, multiply the result of previous step with A i.e.
-      // calculate (A^T * X) * A for FDCT or
-      // for iDCT multiply the result of previous step with A^T i.e. calculate
-      // (A * X) * A^T
-      for (cl_uint j = 0; j < blockWidth; ++j)
-        for (cl_uint i = 0; i < blockWidth; ++i) {
-          cl_uint index = getIdx(blockIdx, blockIdy, i, j, blockWidth, width);
-          cl_float tmp = 0.0f;
-          for (cl_uint k = 0; k < blockWidth; ++k) {
-            // input(j,k)
-            cl_uint index1 =
-                getIdx(blockIdx, blockIdy, k, j, blockWidth, width);
-
-            // multiply with dct (k,i)
-            cl_uint index2 = k * blockWidth + i;
-
-            if (inverse)
-              tmp += temp[index1] * dct8x8_trans[index2];
-            else
-              tmp += temp[index1] * dct8x8[index2];
-          }
-          verificationOutput[index] = tmp;
-        }
-    }
-
-  free(temp);
+                          const cl_uint width, const cl_uint height,
+                          const cl_uint inverse) {
+  DCTCPU<>::transform(verificationOutput, input, width, height, inverse);
 }
 
 int DCT::initialize() {
@@ -467,9 +409,11 @@ int DCT::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -495,8 +439,7 @@ int DCT::verifyResults() {
 
     sampleTimer->resetTimer(refTimer);
     sampleTimer->startTimer(refTimer);
-    DCTCPUReference(verificationOutput, input, dct8x8, width, height,
-                    width / blockWidth, height / blockWidth, inverse);
+    DCTCPUReference(verificationOutput, input, width, height, inverse);
 
     sampleTimer->stopTimer(refTimer);
     referenceKernelTime = sampleTimer->readTimer(refTimer);
@@ -526,7 +469,11 @@ void DCT::printStats() {
     stats[2] = toString(sampleTimer->totalTime, std::dec);
     stats[3] = toString(totalKernelTime, std::dec);
 
-    printStatistics(strArray, stats, 4);
+    cl_uint blocks = (width / blockWidth) * (height / blockWidth);
+    printStatisticsWithHost(strArray, stats, 4, referenceKernelTime,
+                            "Host Blocks/sec", blocks);
+
+    sampleTimer->printIterationStats();
   }
 }
 int DCT::cleanup() {
@@ -588,7 +535,7 @@ int main(int argc, char *argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clDCT.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clDCT.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
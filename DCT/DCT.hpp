@@ -34,6 +34,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "DCTCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -118,6 +119,7 @@ class DCT {
     inverse = 0;
     setupTime = 0;
     totalKernelTime = 0;
+    referenceKernelTime = 0;
     iterations = 1;
     sampleArgs = new CLCommandArgs();
     sampleTimer = new SDKTimer();
@@ -146,36 +148,18 @@ class DCT {
    */
   int runCLKernels();
 
-  /**
-   * Given the blockindices and localIndicies this
-   * function calculate the global index
-   * @param blockIdx index of the block horizontally
-   * @param blockIdy index of the block vertically
-   * @param localidx index of the element relative to the block horizontally
-   * @param localIdy index of the element relative to the block vertically
-   * @param blockWidth width of each block which is 8
-   * @param globalWidth Width of the input matrix
-   * @return ID in x dimension
-   */
-  cl_uint getIdx(cl_uint blockIdx, cl_uint blockIdy, cl_uint localIdx,
-                 cl_uint localIdy, cl_uint blockWidth, cl_uint globalWidth);
-
   /**
    * Reference CPU implementation of Discrete Cosine Transform
-   * for performance comparison
+   * for performance comparison, see DCTCPU.hpp
    * @param output output of the DCT8x8 transform
    * @param input  input array
-   * @param dct8x8 8x8 cosine function base used to calculate DCT8x8
    * @param width width of the input matrix
    * @param height height of the input matrix
-   * @param numBlocksX number of blocks horizontally
-   * @param numBlocksY number of blocks vertically
    * @param inverse  flag to perform inverse DCT
    */
   void DCTCPUReference(cl_float *output, const cl_float *input,
-                       const cl_float *dct8x8, const cl_uint width,
-                       const cl_uint height, const cl_uint numBlocksX,
-                       const cl_uint numBlocksY, const cl_uint inverse);
+                       const cl_uint width, const cl_uint height,
+                       const cl_uint inverse);
   /**
    * Override from SDKSample. Print sample stats.
    */
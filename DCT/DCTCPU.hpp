@@ -0,0 +1,311 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef DCTCPU_H_
+#define DCTCPU_H_
+
+#include <CL/cl.h>
+#include "SDKThread.hpp"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host 8x8 DCT used to verify the DCT sample.
+ *
+ * Computes Y = C * X * C^T (forward) or X = C^T * Y * C (inverse) for every
+ * 8x8 block, with C the orthonormal DCT-II matrix the kernel uploads as
+ * dct8x8_trans. Each 1D transform is the Loeffler factorization also used
+ * by the IJG "islow" DCT: an even/odd butterfly, 3 multiplies for the even
+ * half and 9 for the odd half, instead of 64. The constants are the
+ * IJG ones scaled to ck = cos(k * pi / 16) / 2, so that both passes come
+ * out orthonormal.
+ *
+ * A block is held as eight rows of eight lanes, so the column pass is
+ * plain lane-wise arithmetic. The block is transposed in registers for
+ * the row pass and transposed back before it is stored. Every block goes
+ * straight from input to output without an image-sized temporary, and
+ * rows of blocks are spread over SDKThreadPool.
+ */
+#define DCT_CPU_WIDTH 8 /**< width and height of a block */
+
+/**
+ * DCTScalar
+ * A row of a block as an array
+ */
+struct DCTScalar {
+  struct Vec {
+    cl_float s[DCT_CPU_WIDTH];
+  };
+
+  static Vec load(const cl_float *p) {
+    Vec r;
+    for (int c = 0; c < DCT_CPU_WIDTH; ++c) r.s[c] = p[c];
+    return r;
+  }
+  static void store(cl_float *p, Vec a) {
+    for (int c = 0; c < DCT_CPU_WIDTH; ++c) p[c] = a.s[c];
+  }
+  static Vec add(Vec a, Vec b) {
+    for (int c = 0; c < DCT_CPU_WIDTH; ++c) a.s[c] += b.s[c];
+    return a;
+  }
+  static Vec sub(Vec a, Vec b) {
+    for (int c = 0; c < DCT_CPU_WIDTH; ++c) a.s[c] -= b.s[c];
+    return a;
+  }
+  static Vec mul(Vec a, cl_float b) {
+    for (int c = 0; c < DCT_CPU_WIDTH; ++c) a.s[c] *= b;
+    return a;
+  }
+  static void transpose(Vec *v) {
+    for (int r = 0; r < DCT_CPU_WIDTH; ++r) {
+      for (int c = r + 1; c < DCT_CPU_WIDTH; ++c) {
+        cl_float t = v[r].s[c];
+        v[r].s[c] = v[c].s[r];
+        v[c].s[r] = t;
+      }
+    }
+  }
+};
+
+#ifdef __SSE__
+/**
+ * DCTSSE
+ * A row of a block as two SSE registers
+ */
+struct DCTSSE {
+  struct Vec {
+    __m128 lo;
+    __m128 hi;
+  };
+
+  static Vec load(const cl_float *p) {
+    Vec r;
+    r.lo = _mm_loadu_ps(p);
+    r.hi = _mm_loadu_ps(p + 4);
+    return r;
+  }
+  static void store(cl_float *p, Vec a) {
+    _mm_storeu_ps(p, a.lo);
+    _mm_storeu_ps(p + 4, a.hi);
+  }
+  static Vec add(Vec a, Vec b) {
+    a.lo = _mm_add_ps(a.lo, b.lo);
+    a.hi = _mm_add_ps(a.hi, b.hi);
+    return a;
+  }
+  static Vec sub(Vec a, Vec b) {
+    a.lo = _mm_sub_ps(a.lo, b.lo);
+    a.hi = _mm_sub_ps(a.hi, b.hi);
+    return a;
+  }
+  static Vec mul(Vec a, cl_float b) {
+    __m128 k = _mm_set1_ps(b);
+    a.lo = _mm_mul_ps(a.lo, k);
+    a.hi = _mm_mul_ps(a.hi, k);
+    return a;
+  }
+
+  /**
+   * transpose
+   * Transposes the four 4x4 quadrants and swaps the off-diagonal two
+   */
+  static void transpose(Vec *v) {
+    _MM_TRANSPOSE4_PS(v[0].lo, v[1].lo, v[2].lo, v[3].lo);
+    _MM_TRANSPOSE4_PS(v[4].hi, v[5].hi, v[6].hi, v[7].hi);
+    _MM_TRANSPOSE4_PS(v[0].hi, v[1].hi, v[2].hi, v[3].hi);
+    _MM_TRANSPOSE4_PS(v[4].lo, v[5].lo, v[6].lo, v[7].lo);
+    for (int r = 0; r < 4; ++r) {
+      __m128 t = v[r].hi;
+      v[r].hi = v[r + 4].lo;
+      v[r + 4].lo = t;
+    }
+  }
+};
+
+typedef DCTSSE DCTLanes;
+#else
+typedef DCTScalar DCTLanes;
+#endif
+
+/**
+ * DCTCPU
+ * Fast forward and inverse 8x8 DCT of a width x height image, both
+ * multiples of DCT_CPU_WIDTH
+ */
+template <class L = DCTLanes>
+class DCTCPU {
+ public:
+  typedef typename L::Vec Vec;
+
+  /**
+   * transform
+   * @param output transformed image
+   * @param input image to transform, must not alias output
+   * @param width width of the image
+   * @param height height of the image
+   * @param inverse nonzero for the inverse DCT
+   */
+  static void transform(cl_float *output, const cl_float *input,
+                        cl_uint width, cl_uint height, cl_uint inverse) {
+    Job job;
+    job.output = output;
+    job.input = input;
+    job.width = width;
+    job.inverse = inverse;
+    SDKThreadPool::instance().parallelFor(0, height / DCT_CPU_WIDTH, 0,
+                                          transformRows, &job);
+  }
+
+  /**
+   * forward1D
+   * v = C * v, the DCT of each lane along the eight rows
+   */
+  static void forward1D(Vec *v) {
+    Vec s07 = L::add(v[0], v[7]), d07 = L::sub(v[0], v[7]);
+    Vec s16 = L::add(v[1], v[6]), d16 = L::sub(v[1], v[6]);
+    Vec s25 = L::add(v[2], v[5]), d25 = L::sub(v[2], v[5]);
+    Vec s34 = L::add(v[3], v[4]), d34 = L::sub(v[3], v[4]);
+
+    // Even half
+    Vec e0 = L::add(s07, s34), e3 = L::sub(s07, s34);
+    Vec e1 = L::add(s16, s25), e2 = L::sub(s16, s25);
+    v[0] = L::mul(L::add(e0, e1), 0.353553391f);   // c4
+    v[4] = L::mul(L::sub(e0, e1), 0.353553391f);   // c4
+    Vec z = L::mul(L::add(e2, e3), 0.191341716f);  // c6
+    v[2] = L::add(z, L::mul(e3, 0.270598050f));    // c2 - c6
+    v[6] = L::sub(z, L::mul(e2, 0.653281482f));    // c2 + c6
+
+    // Odd half
+    odd(d34, d25, d16, d07, v[7], v[5], v[3], v[1]);
+  }
+
+  /**
+   * inverse1D
+   * v = C^T * v, the inverse DCT of each lane along the eight rows
+   */
+  static void inverse1D(Vec *v) {
+    // Even half
+    Vec z = L::mul(L::add(v[2], v[6]), 0.191341716f);   // c6
+    Vec e2 = L::sub(z, L::mul(v[6], 0.653281482f));     // c2 + c6
+    Vec e3 = L::add(z, L::mul(v[2], 0.270598050f));     // c2 - c6
+    Vec e0 = L::mul(L::add(v[0], v[4]), 0.353553391f);  // c4
+    Vec e1 = L::mul(L::sub(v[0], v[4]), 0.353553391f);  // c4
+    Vec s07 = L::add(e0, e3), s34 = L::sub(e0, e3);
+    Vec s16 = L::add(e1, e2), s25 = L::sub(e1, e2);
+
+    // Odd half, the same network with its inputs and outputs swapped
+    Vec d07, d16, d25, d34;
+    odd(v[7], v[5], v[3], v[1], d34, d25, d16, d07);
+
+    v[0] = L::add(s07, d07);
+    v[7] = L::sub(s07, d07);
+    v[1] = L::add(s16, d16);
+    v[6] = L::sub(s16, d16);
+    v[2] = L::add(s25, d25);
+    v[5] = L::sub(s25, d25);
+    v[3] = L::add(s34, d34);
+    v[4] = L::sub(s34, d34);
+  }
+
+ private:
+  /**
+   * Job
+   * Image shared by all rows of blocks
+   */
+  struct Job {
+    cl_float *output;      /**< transformed image */
+    const cl_float *input; /**< image to transform */
+    cl_uint width;         /**< width of the image */
+    cl_uint inverse;       /**< nonzero for the inverse DCT */
+  };
+
+  /**
+   * odd
+   * Odd half of the 1D transform. Its matrix is symmetric, so the
+   * forward transform maps (d34, d25, d16, d07) to (y7, y5, y3, y1) and
+   * the inverse maps (y7, y5, y3, y1) back to (d34, d25, d16, d07).
+   */
+  static void odd(Vec t4, Vec t5, Vec t6, Vec t7, Vec &o4, Vec &o5, Vec &o6,
+                  Vec &o7) {
+    Vec z1 = L::add(t4, t7);
+    Vec z2 = L::add(t5, t6);
+    Vec z3 = L::add(t4, t6);
+    Vec z4 = L::add(t5, t7);
+    Vec z5 = L::mul(L::add(z3, z4), 0.415734806f);  // c3
+    t4 = L::mul(t4, 0.105582121f);                  // -c1 + c3 + c5 - c7
+    t5 = L::mul(t5, 0.725887491f);                  // c1 + c3 - c5 + c7
+    t6 = L::mul(t6, 1.086367402f);                  // c1 + c3 + c5 - c7
+    t7 = L::mul(t7, 0.530797169f);                  // c1 + c3 - c5 - c7
+    z1 = L::mul(z1, -0.318189645f);                 // c7 - c3
+    z2 = L::mul(z2, -0.906127446f);                 // -c1 - c3
+    z3 = L::add(L::mul(z3, -0.693519923f), z5);     // -c3 - c5
+    z4 = L::add(L::mul(z4, -0.137949690f), z5);     // c5 - c3
+    o4 = L::add(t4, L::add(z1, z3));
+    o5 = L::add(t5, L::add(z2, z4));
+    o6 = L::add(t6, L::add(z2, z3));
+    o7 = L::add(t7, L::add(z1, z4));
+  }
+
+  /**
+   * transformRows
+   * Transforms the rows of blocks [rowBegin, rowEnd)
+   */
+  static void transformRows(size_t rowBegin, size_t rowEnd, void *arg) {
+    const Job *job = (const Job *)arg;
+    const cl_uint width = job->width;
+    Vec v[DCT_CPU_WIDTH];
+    for (size_t by = rowBegin; by < rowEnd; ++by) {
+      size_t rowOffset = by * DCT_CPU_WIDTH * width;
+      for (cl_uint bx = 0; bx < width; bx += DCT_CPU_WIDTH) {
+        const cl_float *in = job->input + rowOffset + bx;
+        for (int r = 0; r < DCT_CPU_WIDTH; ++r) {
+          v[r] = L::load(in + r * width);
+        }
+        if (job->inverse) {
+          inverse1D(v);
+          L::transpose(v);
+          inverse1D(v);
+        } else {
+          forward1D(v);
+          L::transpose(v);
+          forward1D(v);
+        }
+        L::transpose(v);
+        cl_float *out = job->output + rowOffset + bx;
+        for (int r = 0; r < DCT_CPU_WIDTH; ++r) {
+          L::store(out + r * width, v[r]);
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -93,7 +93,7 @@ int DeviceFission::setupCLPlatform() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  rContext = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  rContext = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -635,7 +635,7 @@ int main(int argc, char* argv[]) {
       return SDK_FAILURE;
     }
     // VerifyResults
-    if (clDeviceFission.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clDeviceFission.verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
     // Cleanup
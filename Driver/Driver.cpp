@@ -0,0 +1,225 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "Driver.hpp"
+
+#include <fstream>
+#include <sstream>
+
+const SDKSampleEntry *Driver::findSample(std::string name) {
+  // Accept the path of a sample executable, as written in benchmark.ini
+  size_t slash = name.find_last_of("/\\");
+  if (slash != std::string::npos) {
+    name = name.substr(slash + 1);
+  }
+  const char *suffixes[] = {".exe", "_static", "_dynamic"};
+  for (int i = 0; i < 3; i++) {
+    std::string suffix = suffixes[i];
+    if (name.size() > suffix.size() &&
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) ==
+            0) {
+      name.erase(name.size() - suffix.size());
+    }
+  }
+
+  std::vector<SDKSampleEntry> &registry = sampleRegistry();
+  for (size_t i = 0; i < registry.size(); i++) {
+    if (registry[i].name == name) {
+      return &registry[i];
+    }
+  }
+  return NULL;
+}
+
+void Driver::usage() {
+  std::cout << "Usage: Driver [--root <dir>] [--report <file>] "
+            << "<jobfile | - | Sample [options]>\n"
+            << "       Driver --list\n\n"
+            << "Each line of the job file is a sample name, or the path of "
+            << "a sample executable,\nfollowed by its options. '-' reads "
+            << "jobs from stdin. Lines starting with '#'\nare ignored. "
+            << "--report runs every job with -t and appends its statistics "
+            << "to <file>.\n\n"
+            << "Samples:" << std::endl;
+  std::vector<SDKSampleEntry> &registry = sampleRegistry();
+  for (size_t i = 0; i < registry.size(); i++) {
+    std::cout << "  " << registry[i].name << std::endl;
+  }
+}
+
+int Driver::parseCommandLine(int argc, char **argv) {
+  rootPath = getPath() + "../";
+
+  int i = 1;
+  for (; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--root" && i + 1 < argc) {
+      rootPath = argv[++i];
+      if (rootPath.empty() || rootPath[rootPath.size() - 1] != '/') {
+        rootPath += "/";
+      }
+    } else if (arg == "--report" && i + 1 < argc) {
+      reportFile = argv[++i];
+    } else if (arg == "--list") {
+      listSamples = true;
+    } else if (arg == "-h" || arg == "--help") {
+      usage();
+      return SDK_EXPECTED_FAILURE;
+    } else {
+      break;
+    }
+  }
+
+  if (listSamples) {
+    return SDK_SUCCESS;
+  }
+
+  if (i >= argc) {
+    usage();
+    return SDK_FAILURE;
+  }
+
+  // A registered sample name starts a single job, anything else is a file
+  if (findSample(argv[i]) != NULL) {
+    std::vector<std::string> job;
+    for (; i < argc; i++) {
+      job.push_back(argv[i]);
+    }
+    jobs.push_back(job);
+    return SDK_SUCCESS;
+  }
+
+  jobFile = argv[i];
+  return readJobFile();
+}
+
+int Driver::readJobFile() {
+  std::ifstream file;
+  std::istream *in = &std::cin;
+  if (jobFile != "-") {
+    file.open(jobFile.c_str());
+    if (!file.is_open()) {
+      error("Cannot open job file " + jobFile);
+      return SDK_FAILURE;
+    }
+    in = &file;
+  }
+
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(*in, line)) {
+    lineNumber++;
+    std::istringstream tokens(line);
+    std::vector<std::string> job;
+    std::string token;
+    while (tokens >> token) {
+      job.push_back(token);
+    }
+    if (job.empty() || job[0][0] == '#') {
+      continue;
+    }
+    if (findSample(job[0]) == NULL) {
+      std::ostringstream message;
+      message << jobFile << ":" << lineNumber << ": unknown sample " << job[0];
+      error(message.str());
+      return SDK_FAILURE;
+    }
+    jobs.push_back(job);
+  }
+  return SDK_SUCCESS;
+}
+
+int Driver::run() {
+  if (listSamples) {
+    std::vector<SDKSampleEntry> &registry = sampleRegistry();
+    for (size_t i = 0; i < registry.size(); i++) {
+      std::cout << registry[i].name << std::endl;
+    }
+    return SDK_SUCCESS;
+  }
+
+  // Contexts and programs are shared by jobs using the same device and
+  // kernels, so only the first of them pays for creation and the build
+  SDKCLCache::instance().enable();
+
+  int failed = 0;
+  int timer = sampleTimer->createTimer();
+  for (size_t i = 0; i < jobs.size(); i++) {
+    const SDKSampleEntry *entry = findSample(jobs[i][0]);
+
+    std::vector<std::string> args = jobs[i];
+    args[0] = entry->name;
+    if (!reportFile.empty()) {
+      args.push_back("-t");
+      args.push_back("--report");
+      args.push_back(reportFile);
+    }
+    std::vector<char *> argv;
+    for (size_t j = 0; j < args.size(); j++) {
+      argv.push_back(const_cast<char *>(args[j].c_str()));
+    }
+    argv.push_back(NULL);
+
+    std::cout << "\n[" << (i + 1) << "/" << jobs.size() << "] "
+              << entry->name << std::endl;
+
+    setSamplePath(rootPath + entry->dir + "/");
+    SDKSample *sample = entry->create();
+    sampleTimer->resetTimer(timer);
+    sampleTimer->startTimer(timer);
+    int status = sample->runJob((int)args.size(), &argv[0]);
+    sampleTimer->stopTimer(timer);
+    delete sample;
+    setSamplePath("");
+
+    // Flush the job's report record before the next job starts filling it
+    SDKReport::instance().emit();
+
+    if (status != SDK_SUCCESS) {
+      failed++;
+    }
+    std::cout << "[" << (i + 1) << "/" << jobs.size() << "] " << entry->name
+              << ((status == SDK_SUCCESS) ? " PASSED" : " FAILED") << " in "
+              << sampleTimer->readTimer(timer) << " sec" << std::endl;
+  }
+
+  SDKCLCache::instance().release();
+
+  std::cout << "\n" << (jobs.size() - failed) << " of " << jobs.size()
+            << " jobs passed" << std::endl;
+  return (failed == 0) ? SDK_SUCCESS : SDK_FAILURE;
+}
+
+int main(int argc, char *argv[]) {
+  Driver driver;
+
+  int status = driver.parseCommandLine(argc, argv);
+  if (status != SDK_SUCCESS) {
+    return (status == SDK_EXPECTED_FAILURE) ? SDK_SUCCESS : SDK_FAILURE;
+  }
+
+  return driver.run();
+}
@@ -0,0 +1,215 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef DRIVER_H_
+#define DRIVER_H_
+
+#include <vector>
+#include <string>
+#include "CLUtil.hpp"
+
+using namespace appsdk;
+
+/**
+ * SDKSample
+ * Common interface of a sample linked into the driver. One object runs one
+ * job: initialize, parse the job's options, setup, run, verifyResults,
+ * cleanup and printStats, the same sequence the sample's own main() uses.
+ */
+class SDKSample {
+ public:
+  virtual ~SDKSample() {}
+
+  /**
+   * Run one job of the sample
+   * @param argc number of job arguments, including the sample name
+   * @param argv job arguments
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  virtual int runJob(int argc, char **argv) = 0;
+};
+
+/**
+ * SDKSampleAdapter
+ * Drives any sample class exposing initialize/setup/run/verifyResults/
+ * cleanup/printStats/genBinaryImage and a public sampleArgs
+ */
+template <class T>
+class SDKSampleAdapter : public SDKSample {
+ public:
+  int runJob(int argc, char **argv) {
+    T sample;
+    if (sample.initialize() != SDK_SUCCESS) {
+      return SDK_FAILURE;
+    }
+    if (sample.sampleArgs->parseCommandLine(argc, argv) != SDK_SUCCESS) {
+      return SDK_FAILURE;
+    }
+    if (sample.sampleArgs->isDumpBinaryEnabled()) {
+      return sample.genBinaryImage();
+    }
+    int status = sample.setup();
+    if (status != SDK_SUCCESS) {
+      return (status == SDK_EXPECTED_FAILURE) ? SDK_SUCCESS : SDK_FAILURE;
+    }
+    if (sample.run() != SDK_SUCCESS) {
+      return SDK_FAILURE;
+    }
+    if (reportVerification(sample.verifyResults()) != SDK_SUCCESS) {
+      return SDK_FAILURE;
+    }
+    if (sample.cleanup() != SDK_SUCCESS) {
+      return SDK_FAILURE;
+    }
+    sample.printStats();
+    return SDK_SUCCESS;
+  }
+};
+
+/**
+ * SDKMainAdapter
+ * Runs a sample through its own (renamed) main(), for samples whose main()
+ * does more than the standard sequence
+ */
+template <int (*MainFunc)(int, char **)>
+class SDKMainAdapter : public SDKSample {
+ public:
+  int runJob(int argc, char **argv) { return MainFunc(argc, argv); }
+};
+
+/**
+ * SDKSampleEntry
+ * struct describing a registered sample
+ */
+struct SDKSampleEntry {
+  std::string name;         /**< name used in job lists */
+  std::string dir;          /**< directory holding kernels and inputs */
+  SDKSample *(*create)();   /**< factory for one job object */
+};
+
+/**
+ * sampleRegistry
+ * @return list of all samples linked into the driver
+ */
+inline std::vector<SDKSampleEntry> &sampleRegistry() {
+  static std::vector<SDKSampleEntry> registry;
+  return registry;
+}
+
+/**
+ * SDKSampleRegistrar
+ * Adds a sample to the registry during static initialization
+ */
+class SDKSampleRegistrar {
+ public:
+  SDKSampleRegistrar(const char *name, const char *dir,
+                     SDKSample *(*create)()) {
+    SDKSampleEntry entry;
+    entry.name = name;
+    entry.dir = dir;
+    entry.create = create;
+    sampleRegistry().push_back(entry);
+  }
+};
+
+/**
+ * Register sample class Class under name, with kernels and inputs in dir
+ */
+#define REGISTER_SDK_SAMPLE(name, Class, dir)                           \
+  static SDKSample *create##name() {                                    \
+    return new SDKSampleAdapter<Class>();                               \
+  }                                                                     \
+  static SDKSampleRegistrar registrar##name(#name, dir, create##name);
+
+/**
+ * Register a sample run through its renamed main function
+ */
+#define REGISTER_SDK_SAMPLE_MAIN(name, mainFunc, dir)                   \
+  static SDKSample *create##name() {                                    \
+    return new SDKMainAdapter<mainFunc>();                              \
+  }                                                                     \
+  static SDKSampleRegistrar registrar##name(#name, dir, create##name);
+
+/**
+ * Driver
+ * Class runs a list of (sample, options) jobs in one process, so the
+ * OpenCL platform, contexts and built programs are shared between them
+ */
+class Driver {
+  std::string rootPath;       /**< directory containing the sample dirs */
+  std::string jobFile;        /**< file listing one job per line */
+  std::string reportFile;     /**< report file passed on to every job */
+  bool listSamples;           /**< print the registered samples and exit */
+  std::vector<std::vector<std::string> > jobs; /**< parsed job list */
+  SDKTimer *sampleTimer;      /**< SDKTimer object */
+
+ public:
+  /**
+   * Constructor
+   * Initialize member variables
+   */
+  Driver() {
+    sampleTimer = new SDKTimer();
+    listSamples = false;
+  }
+
+  /**
+   * Destructor
+   */
+  ~Driver() { delete sampleTimer; }
+
+  /**
+   * Parse the driver's own options and the jobs given on the command line
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  int parseCommandLine(int argc, char **argv);
+
+  /**
+   * Read jobs from jobFile. Each line is a sample name (or the path of a
+   * sample executable, as in benchmark.ini) followed by its options.
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  int readJobFile();
+
+  /**
+   * Run all jobs
+   * @return SDK_SUCCESS if every job passed, SDK_FAILURE otherwise
+   */
+  int run();
+
+  /**
+   * Print usage and the registered samples
+   */
+  void usage();
+
+  /**
+   * Find a sample by name
+   * @return registry entry or NULL
+   */
+  const SDKSampleEntry *findSample(std::string name);
+};
+
+#endif
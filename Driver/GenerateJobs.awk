@@ -0,0 +1,23 @@
+# Writes one wrapper unit per line of Samples.lst into the directory
+# given as -v out=<dir>. Each unit compiles a sample's sources with main
+# renamed and registers it with the driver.
+/^[ \t]*(#|$)/ { next }
+{
+  name = $1; dir = $2; cls = $3
+  file = out "/" name "Job.cpp"
+  print "// Generated from Samples.lst, do not edit" > file
+  print "#define main " name "_main" > file
+  for (i = 4; i <= NF; i++) {
+    print "#include \"../../" dir "/" $i "\"" > file
+  }
+  print "#undef main" > file
+  print "" > file
+  print "#include \"Driver.hpp\"" > file
+  print "" > file
+  if (cls == "main") {
+    print "REGISTER_SDK_SAMPLE_MAIN(" name ", " name "_main, \"" dir "\")" > file
+  } else {
+    print "REGISTER_SDK_SAMPLE(" name ", " cls ", \"" dir "\")" > file
+  }
+  close(file)
+}
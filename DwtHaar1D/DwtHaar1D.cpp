@@ -162,7 +162,7 @@ int DwtHaar1D::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -464,9 +464,11 @@ int DwtHaar1D::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -519,6 +521,8 @@ void DwtHaar1D::printStats() {
     stats[2] = toString(kernelTime, std::dec);
 
     printStatistics(strArray, stats, 3);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -586,7 +590,7 @@ int main(int argc, char* argv[]) {
   }
 
   // Verify
-  if (clDwtHaar1D.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clDwtHaar1D.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
@@ -106,7 +106,7 @@ int FastWalshTransform::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -250,26 +250,8 @@ int FastWalshTransform::runCLKernels(void) {
  */
 void FastWalshTransform::fastWalshTransformCPUReference(cl_float *vinput,
                                                         const cl_uint length) {
-  // for each pass of the algorithm
-  for (cl_uint step = 1; step < length; step <<= 1) {
-    // length of each block
-    cl_uint jump = step << 1;
-    // for each blocks
-    for (cl_uint group = 0; group < step; ++group) {
-      // for each pair of elements with in the block
-      for (cl_uint pair = group; pair < length; pair += jump) {
-        // find its partner
-        cl_uint match = pair + step;
-
-        cl_float T1 = vinput[pair];
-        cl_float T2 = vinput[match];
-
-        // store the sum and difference of the numbers in the same locations
-        vinput[pair] = T1 + T2;
-        vinput[match] = T1 - T2;
-      }
-    }
-  }
+  // Same passes as the kernel, see FastWalshTransformCPU.hpp
+  FastWalshTransformCPU::transform(vinput, length);
 }
 
 int FastWalshTransform::initialize() {
@@ -307,9 +289,14 @@ int FastWalshTransform::initialize() {
 
 int FastWalshTransform::setup() {
   // make sure the length is the power of 2
-  if (isPowerOf2(length)) {
+  if (isPowerOf2(length) != SDK_SUCCESS) {
     length = roundToPowerOf2(length);
   }
+  if (isPowerOf2(length) != SDK_SUCCESS) {
+    std::cout << "Error: signal length must be a power of 2 up to 2^30"
+              << std::endl;
+    return SDK_FAILURE;
+  }
 
   if (setupFastWalshTransform() != SDK_SUCCESS) {
     return SDK_FAILURE;
@@ -348,9 +335,11 @@ int FastWalshTransform::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -403,7 +392,9 @@ void FastWalshTransform::printStats() {
     stats[1] = toString(sampleTimer->totalTime, std::dec);
     stats[2] = toString(totalKernelTime, std::dec);
 
-    printStatistics(strArray, stats, 3);
+    printStatisticsWithHost(strArray, stats, 3, referenceKernelTime);
+
+    sampleTimer->printIterationStats();
   }
 }
 int FastWalshTransform::cleanup() {
@@ -462,7 +453,7 @@ int main(int argc, char *argv[]) {
   }
 
   // VerifyResults
-  if (clFastWalshTransform.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clFastWalshTransform.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
@@ -34,6 +34,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "FastWalshTransformCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -83,6 +84,7 @@ class FastWalshTransform {
     verificationInput = NULL;
     setupTime = 0;
     totalKernelTime = 0;
+    referenceKernelTime = 0;
     iterations = 1;
     sampleArgs = new CLCommandArgs();
     sampleTimer = new SDKTimer();
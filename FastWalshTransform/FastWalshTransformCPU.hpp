@@ -0,0 +1,244 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef FASTWALSHTRANSFORMCPU_H_
+#define FASTWALSHTRANSFORMCPU_H_
+
+#include <CL/cl.h>
+#include <algorithm>
+#include "SDKThread.hpp"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host Walsh-Hadamard transform used to verify FastWalshTransform.
+ *
+ * The passes of the reference (step = 1, 2, 4, ... length / 2) are kept in
+ * order, and every butterfly still computes the same sum and difference,
+ * so results are bit exact with it. Only the memory traversal changes:
+ *
+ * - Steps below FWHT_CPU_BLOCK run block by block, one block per task,
+ *   so the block stays in L1 through all of them. Steps 1 and 2 are
+ *   done in register with shuffles.
+ * - Larger steps are grouped FWHT_CPU_ROWS at a time. For one group,
+ *   the elements form FWHT_CPU_ROWS rows a step apart. A strip
+ *   FWHT_CPU_STRIP columns wide goes through all steps of the group
+ *   while it is in cache. Strips are independent tasks.
+ *
+ * Two steps are merged into one radix-4 pass where possible, four
+ * columns per SSE register. Vectors of a batch are stored back to back
+ * and are transformed together, which keeps all threads busy for short
+ * vectors as well.
+ */
+#define FWHT_CPU_BLOCK 4096 /**< elements transformed in L1 per task */
+#define FWHT_CPU_ROWS 64    /**< rows of a strip, steps grouped by 6 */
+#define FWHT_CPU_STRIP 64   /**< columns of a strip */
+
+/**
+ * FastWalshTransformCPU
+ * In place, unnormalized Walsh-Hadamard transform
+ */
+class FastWalshTransformCPU {
+ public:
+  /**
+   * transform
+   * @param v count vectors of length elements, one after the other
+   * @param length length of each vector, a power of 2
+   * @param count number of vectors
+   */
+  static void transform(cl_float *v, size_t length, size_t count = 1) {
+    if (length < 4) {
+      for (size_t b = 0; b < count; ++b) {
+        butterflies(v + b * length, 1, 1, length, 1);
+      }
+      return;
+    }
+
+    SDKThreadPool &pool = SDKThreadPool::instance();
+    size_t total = length * count;
+    Job job;
+    job.v = v;
+    job.block = std::min(length, (size_t)FWHT_CPU_BLOCK);
+    pool.parallelFor(0, total / job.block, 0, transformBlocks, &job);
+
+    for (size_t step = job.block; step < length; step *= job.rows) {
+      job.step = step;
+      job.rows = std::min(length / step, (size_t)FWHT_CPU_ROWS);
+      job.strip = std::min(step, (size_t)FWHT_CPU_STRIP);
+      pool.parallelFor(0, total / (job.rows * job.strip), 0, transformStrips,
+                       &job);
+    }
+  }
+
+ private:
+  /**
+   * Job
+   * The vectors and the current group of steps
+   */
+  struct Job {
+    cl_float *v;  /**< all vectors */
+    size_t block; /**< elements per block */
+    size_t step;  /**< first step of the group */
+    size_t rows;  /**< rows of a strip */
+    size_t strip; /**< columns of a strip */
+  };
+
+  /**
+   * butterflies
+   * Steps [rowStep, rows) of the rows x width matrix at v, with a row
+   * pitch of stride, column by column
+   */
+  static void butterflies(cl_float *v, size_t stride, size_t rowStep,
+                          size_t rows, size_t width) {
+    size_t s = rowStep;
+    while (s < rows) {
+      if (4 * s <= rows) {
+        radix4(v, stride, s, rows, width);
+        s *= 4;
+      } else {
+        radix2(v, stride, s, rows, width);
+        s *= 2;
+      }
+    }
+  }
+
+  /**
+   * radix2
+   * Step s: rows r and r + s
+   */
+  static void radix2(cl_float *v, size_t stride, size_t s, size_t rows,
+                     size_t width) {
+    for (size_t g = 0; g < rows; g += 2 * s) {
+      for (size_t r = g; r < g + s; ++r) {
+        cl_float *a = v + r * stride;
+        cl_float *b = a + s * stride;
+        size_t c = 0;
+#ifdef __SSE__
+        for (; c + 4 <= width; c += 4) {
+          __m128 x = _mm_loadu_ps(a + c), y = _mm_loadu_ps(b + c);
+          _mm_storeu_ps(a + c, _mm_add_ps(x, y));
+          _mm_storeu_ps(b + c, _mm_sub_ps(x, y));
+        }
+#endif
+        for (; c < width; ++c) {
+          cl_float x = a[c], y = b[c];
+          a[c] = x + y;
+          b[c] = x - y;
+        }
+      }
+    }
+  }
+
+  /**
+   * radix4
+   * Steps s and 2s together: rows r, r + s, r + 2s and r + 3s
+   */
+  static void radix4(cl_float *v, size_t stride, size_t s, size_t rows,
+                     size_t width) {
+    for (size_t g = 0; g < rows; g += 4 * s) {
+      for (size_t r = g; r < g + s; ++r) {
+        cl_float *a = v + r * stride;
+        cl_float *b = a + s * stride;
+        cl_float *c = b + s * stride;
+        cl_float *d = c + s * stride;
+        size_t k = 0;
+#ifdef __SSE__
+        for (; k + 4 <= width; k += 4) {
+          __m128 a0 = _mm_loadu_ps(a + k), b0 = _mm_loadu_ps(b + k);
+          __m128 c0 = _mm_loadu_ps(c + k), d0 = _mm_loadu_ps(d + k);
+          __m128 a1 = _mm_add_ps(a0, b0), b1 = _mm_sub_ps(a0, b0);
+          __m128 c1 = _mm_add_ps(c0, d0), d1 = _mm_sub_ps(c0, d0);
+          _mm_storeu_ps(a + k, _mm_add_ps(a1, c1));
+          _mm_storeu_ps(b + k, _mm_add_ps(b1, d1));
+          _mm_storeu_ps(c + k, _mm_sub_ps(a1, c1));
+          _mm_storeu_ps(d + k, _mm_sub_ps(b1, d1));
+        }
+#endif
+        for (; k < width; ++k) {
+          cl_float a1 = a[k] + b[k], b1 = a[k] - b[k];
+          cl_float c1 = c[k] + d[k], d1 = c[k] - d[k];
+          a[k] = a1 + c1;
+          b[k] = b1 + d1;
+          c[k] = a1 - c1;
+          d[k] = b1 - d1;
+        }
+      }
+    }
+  }
+
+  /**
+   * transformBlocks
+   * All steps below the block size for blocks [blockBegin, blockEnd)
+   */
+  static void transformBlocks(size_t blockBegin, size_t blockEnd, void *arg) {
+    const Job *job = (const Job *)arg;
+    for (size_t blk = blockBegin; blk < blockEnd; ++blk) {
+      cl_float *v = job->v + blk * job->block;
+
+      // Steps 1 and 2 within each group of four
+#ifdef __SSE__
+      const __m128 odd = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+      const __m128 high = _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f);
+      for (size_t i = 0; i < job->block; i += 4) {
+        __m128 x = _mm_loadu_ps(v + i);
+        __m128 lo = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 hi = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 1, 1));
+        x = _mm_add_ps(lo, _mm_xor_ps(hi, odd));
+        lo = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 1, 0));
+        hi = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 2, 3, 2));
+        _mm_storeu_ps(v + i, _mm_add_ps(lo, _mm_xor_ps(hi, high)));
+      }
+#else
+      radix4(v, 1, 1, job->block, 1);
+#endif
+
+      // Steps 4 to block / 2, rows of four
+      butterflies(v, 4, 1, job->block / 4, 4);
+    }
+  }
+
+  /**
+   * transformStrips
+   * The current group of steps for strips [stripBegin, stripEnd)
+   */
+  static void transformStrips(size_t stripBegin, size_t stripEnd,
+                              void *arg) {
+    const Job *job = (const Job *)arg;
+    const size_t stripsPerRow = job->step / job->strip;
+    for (size_t i = stripBegin; i < stripEnd; ++i) {
+      size_t group = i / stripsPerRow;
+      size_t column = (i % stripsPerRow) * job->strip;
+      cl_float *v = job->v + group * job->step * job->rows + column;
+      butterflies(v, job->step, 1, job->rows, job->strip);
+    }
+  }
+};
+
+#endif
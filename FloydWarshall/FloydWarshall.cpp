@@ -145,7 +145,7 @@ int FloydWarshall::setupCL(void) {
    */
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -355,40 +355,61 @@ cl_uint FloydWarshall::minimum(cl_uint a, cl_uint b) { return (b < a) ? b : a; }
 void FloydWarshall::floydWarshallCPUReference(cl_uint *pathDistanceMatrix,
                                               cl_uint *pathMatrix,
                                               const cl_uint numNodes) {
-  cl_uint distanceYtoX, distanceYtoK, distanceKtoX, indirectDistance;
+  floydWarshallCPU(pathDistanceMatrix, pathMatrix, numNodes);
+}
 
-  /*
-   * pathDistanceMatrix is the adjacency matrix(square) with
-   * the dimension equal to the number of nodes in the graph.
-   */
-  cl_uint width = numNodes;
-  cl_uint yXwidth;
+int FloydWarshall::runCPUBenchmark() {
+  int timer = sampleTimer->createTimer();
 
-  /*
-   * for each intermediate node k in the graph find the shortest distance
-   *between
-   * the nodes i and j and update as
-   *
-   * ShortestPath(i,j,k) = min(ShortestPath(i,j,k-1), ShortestPath(i,k,k-1) +
-   *ShortestPath(k,j,k-1))
-   */
-  for (cl_uint k = 0; k < numNodes; ++k) {
-    for (cl_uint y = 0; y < numNodes; ++y) {
-      yXwidth = y * numNodes;
-      for (cl_uint x = 0; x < numNodes; ++x) {
-        distanceYtoX = pathDistanceMatrix[yXwidth + x];
-        distanceYtoK = pathDistanceMatrix[yXwidth + k];
-        distanceKtoX = pathDistanceMatrix[k * width + x];
-
-        indirectDistance = distanceYtoK + distanceKtoX;
-
-        if (indirectDistance < distanceYtoX) {
-          pathDistanceMatrix[yXwidth + x] = indirectDistance;
-          pathMatrix[yXwidth + x] = k;
-        }
+  for (cl_uint nodes = FLOYDWARSHALL_CPU_BLOCK;; nodes *= 2) {
+    nodes = minimum(nodes, numNodes);
+    size_t matrixSize = nodes * nodes;
+    std::vector<cl_uint> distance(matrixSize), path(matrixSize);
+    std::vector<cl_uint> blockedDistance, blockedPath;
+
+    fillRandom<cl_uint>(&distance[0], nodes, nodes, 0, MAXDISTANCE);
+    for (cl_uint i = 0; i < nodes; ++i) {
+      distance[i * nodes + i] = 0;
+      for (cl_uint j = 0; j < nodes; ++j) {
+        path[i * nodes + j] = i;
       }
     }
+    blockedDistance = distance;
+    blockedPath = path;
+
+    sampleTimer->resetTimer(timer);
+    sampleTimer->startTimer(timer);
+    floydWarshallCPUUnblocked(&distance[0], &path[0], nodes);
+    sampleTimer->stopTimer(timer);
+    double unblockedTime = sampleTimer->readTimer(timer);
+
+    sampleTimer->resetTimer(timer);
+    sampleTimer->startTimer(timer);
+    floydWarshallCPU(&blockedDistance[0], &blockedPath[0], nodes);
+    sampleTimer->stopTimer(timer);
+    double blockedTime = sampleTimer->readTimer(timer);
+
+    if (distance != blockedDistance) {
+      std::cout << "Blocked reference mismatch at " << nodes << " nodes"
+                << std::endl;
+      return SDK_FAILURE;
+    }
+
+    std::string strArray[4] = {"Nodes", "Unblocked(sec)", "Blocked(sec)",
+                               "Speedup"};
+    std::string stats[4];
+    stats[0] = toString(nodes, std::dec);
+    stats[1] = toString(unblockedTime, std::dec);
+    stats[2] = toString(blockedTime, std::dec);
+    stats[3] = toString(unblockedTime / blockedTime, std::dec);
+    printStatistics(strArray, stats, 4);
+
+    if (nodes == (cl_uint)numNodes) {
+      break;
+    }
   }
+
+  return SDK_SUCCESS;
 }
 
 int FloydWarshall::initialize() {
@@ -420,6 +441,19 @@ int FloydWarshall::initialize() {
   sampleArgs->AddOption(num_iterations);
   delete num_iterations;
 
+  Option *cpu_bench = new Option;
+  CHECK_ALLOCATION(cpu_bench, "Memory allocation error.\n");
+
+  cpu_bench->_sVersion = "";
+  cpu_bench->_lVersion = "cpuBench";
+  cpu_bench->_description =
+      "Time blocked against unblocked host reference for node counts up to -x";
+  cpu_bench->_type = CA_NO_ARGUMENT;
+  cpu_bench->_value = &cpuBench;
+
+  sampleArgs->AddOption(cpu_bench);
+  delete cpu_bench;
+
   return SDK_SUCCESS;
 }
 
@@ -466,9 +500,11 @@ int FloydWarshall::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -480,6 +516,10 @@ int FloydWarshall::run() {
     printArray<cl_uint>("Output Path Matrix", pathMatrix, numNodes, 1);
   }
 
+  if (cpuBench) {
+    return runCPUBenchmark();
+  }
+
   return SDK_SUCCESS;
 }
 
@@ -528,6 +568,8 @@ void FloydWarshall::printStats() {
     stats[2] = toString(totalKernelTime, std::dec);
 
     printStatistics(strArray, stats, 3);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -590,7 +632,7 @@ int main(int argc, char *argv[]) {
   }
 
   // VerifyResults
-  if (clFloydWarshall.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clFloydWarshall.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
@@ -39,6 +39,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "FloydWarshallCPU.hpp"
 
 using namespace appsdk;
 
@@ -79,6 +80,7 @@ class FloydWarshall {
   KernelWorkGroupInfo
       kernelInfo; /**< KernelWorkGroupInfo object to hold kernel properties */
   SDKTimer *sampleTimer; /**< SDKTimer object */
+  bool cpuBench;         /**< Sweep node counts on the host references */
 
  public:
   CLCommandArgs *sampleArgs; /**< CLCommand argument class */
@@ -98,6 +100,7 @@ class FloydWarshall {
     totalKernelTime = 0;
     iterations = 1;
     blockSize = 16;
+    cpuBench = false;
     sampleArgs = new CLCommandArgs();
     sampleTimer = new SDKTimer();
     sampleArgs->sampleVerStr = SAMPLE_VERSION;
@@ -137,8 +140,16 @@ class FloydWarshall {
    */
   cl_uint minimum(cl_uint a, cl_uint b);
 
+  /**
+   * Time the blocked host reference against the unblocked one for node
+   * counts doubling from FLOYDWARSHALL_CPU_BLOCK up to numNodes
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  int runCPUBenchmark();
+
   /**
    * Reference CPU implementation of FloydWarshall PathFinding
+   * (blocked and multithreaded, see FloydWarshallCPU.hpp)
    * for performance comparison
    * @param pathDistanceMatrix Distance between nodes of a graph
    * @param intermediate node between two nodes of a graph
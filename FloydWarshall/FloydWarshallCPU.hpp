@@ -0,0 +1,210 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef FLOYDWARSHALLCPU_H_
+#define FLOYDWARSHALLCPU_H_
+
+#include <CL/cl.h>
+#include "SDKThread.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host Floyd-Warshall used to verify the FloydWarshall sample.
+ *
+ * The blocked version splits the matrix into FLOYDWARSHALL_CPU_BLOCK^2
+ * tiles and, for each block K of intermediate nodes, updates
+ *   1. the diagonal tile (K, K),
+ *   2. the tiles of row K and column K, which only read tile (K, K),
+ *   3. all remaining tiles, which only read row K and column K.
+ * Tiles of phases 2 and 3 are independent and are spread across threads.
+ * pathDistanceMatrix ends up identical to the unblocked version. Where a
+ * pair has several shortest paths, pathMatrix may name a different (but
+ * equally short) intermediate node.
+ */
+#define FLOYDWARSHALL_CPU_BLOCK 64 /**< tile width and height in nodes */
+
+/**
+ * floydWarshallCPUTile
+ * Relaxes rows [y0, y1) x columns [x0, x1) through nodes [k0, k1)
+ */
+static void floydWarshallCPUTile(cl_uint *pathDistanceMatrix,
+                                 cl_uint *pathMatrix, cl_uint numNodes,
+                                 cl_uint k0, cl_uint k1, cl_uint y0,
+                                 cl_uint y1, cl_uint x0, cl_uint x1) {
+  for (cl_uint k = k0; k < k1; ++k) {
+    const cl_uint *distanceK = pathDistanceMatrix + k * numNodes;
+    for (cl_uint y = y0; y < y1; ++y) {
+      cl_uint *distanceY = pathDistanceMatrix + y * numNodes;
+      cl_uint *pathY = pathMatrix + y * numNodes;
+      cl_uint distanceYtoK = distanceY[k];
+      cl_uint x = x0;
+#ifdef __SSE2__
+      // Distances stay far below 2^31, so signed compares are exact
+      __m128i yToK = _mm_set1_epi32((int)distanceYtoK);
+      __m128i kIndex = _mm_set1_epi32((int)k);
+      for (; x + 4 <= x1; x += 4) {
+        __m128i direct = _mm_loadu_si128((__m128i *)(distanceY + x));
+        __m128i indirect = _mm_add_epi32(
+            yToK, _mm_loadu_si128((const __m128i *)(distanceK + x)));
+        __m128i shorter = _mm_cmplt_epi32(indirect, direct);
+        _mm_storeu_si128((__m128i *)(distanceY + x),
+                         _mm_or_si128(_mm_and_si128(shorter, indirect),
+                                      _mm_andnot_si128(shorter, direct)));
+        __m128i path = _mm_loadu_si128((__m128i *)(pathY + x));
+        _mm_storeu_si128((__m128i *)(pathY + x),
+                         _mm_or_si128(_mm_and_si128(shorter, kIndex),
+                                      _mm_andnot_si128(shorter, path)));
+      }
+#endif
+      for (; x < x1; ++x) {
+        cl_uint indirectDistance = distanceYtoK + distanceK[x];
+        bool shorter = indirectDistance < distanceY[x];
+        distanceY[x] = shorter ? indirectDistance : distanceY[x];
+        pathY[x] = shorter ? k : pathY[x];
+      }
+    }
+  }
+}
+
+/**
+ * floydWarshallCPUUnblocked
+ * Textbook k-y-x Floyd-Warshall on the whole matrix, the baseline of the
+ * FloydWarshall --cpuBench sweep
+ */
+static void floydWarshallCPUUnblocked(cl_uint *pathDistanceMatrix,
+                                      cl_uint *pathMatrix,
+                                      const cl_uint numNodes) {
+  for (cl_uint k = 0; k < numNodes; ++k) {
+    for (cl_uint y = 0; y < numNodes; ++y) {
+      cl_uint yXwidth = y * numNodes;
+      for (cl_uint x = 0; x < numNodes; ++x) {
+        cl_uint indirectDistance = pathDistanceMatrix[yXwidth + k] +
+                                   pathDistanceMatrix[k * numNodes + x];
+        if (indirectDistance < pathDistanceMatrix[yXwidth + x]) {
+          pathDistanceMatrix[yXwidth + x] = indirectDistance;
+          pathMatrix[yXwidth + x] = k;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * FloydWarshallCPUArgs
+ * Block step shared by the tiles of phase 2 or 3
+ */
+struct FloydWarshallCPUArgs {
+  cl_uint *pathDistanceMatrix; /**< path distance array */
+  cl_uint *pathMatrix;         /**< path array */
+  cl_uint numNodes;            /**< number of nodes in the graph */
+  cl_uint numBlocks;           /**< tiles per matrix row */
+  cl_uint blockK;              /**< block of intermediate nodes */
+  int phase;                   /**< 2 for row/column K, 3 for the rest */
+};
+
+/**
+ * floydWarshallCPUPhase
+ * Updates tiles [tileBegin, tileEnd) of the phase. Phase 2 numbers the
+ * tiles of row K then those of column K, phase 3 numbers the remaining
+ * tiles row by row; tile K,K itself is skipped by both.
+ */
+static void floydWarshallCPUPhase(size_t tileBegin, size_t tileEnd,
+                                  void *arg) {
+  FloydWarshallCPUArgs *args = (FloydWarshallCPUArgs *)arg;
+  const cl_uint n = args->numNodes;
+  const cl_uint others = args->numBlocks - 1;
+  const cl_uint blockK = args->blockK;
+  const cl_uint k0 = blockK * FLOYDWARSHALL_CPU_BLOCK;
+  const cl_uint k1 = std::min(k0 + FLOYDWARSHALL_CPU_BLOCK, n);
+  for (size_t tile = tileBegin; tile < tileEnd; ++tile) {
+    cl_uint blockY, blockX;
+    if (args->phase == 2) {
+      cl_uint i = (cl_uint)(tile % others);
+      cl_uint other = (i < blockK) ? i : i + 1;
+      blockY = (tile < others) ? blockK : other;
+      blockX = (tile < others) ? other : blockK;
+    } else {
+      cl_uint y = (cl_uint)(tile / others);
+      cl_uint x = (cl_uint)(tile % others);
+      blockY = (y < blockK) ? y : y + 1;
+      blockX = (x < blockK) ? x : x + 1;
+    }
+    cl_uint y0 = blockY * FLOYDWARSHALL_CPU_BLOCK;
+    cl_uint x0 = blockX * FLOYDWARSHALL_CPU_BLOCK;
+    floydWarshallCPUTile(args->pathDistanceMatrix, args->pathMatrix, n, k0,
+                         k1, y0, std::min(y0 + FLOYDWARSHALL_CPU_BLOCK, n),
+                         x0, std::min(x0 + FLOYDWARSHALL_CPU_BLOCK, n));
+  }
+}
+
+/**
+ * floydWarshallCPU
+ * Blocked, multithreaded Floyd-Warshall. The tiles of each phase are
+ * shared out by SDKThreadPool.
+ * @param pathDistanceMatrix adjacency matrix, replaced by the shortest
+ * distances
+ * @param pathMatrix intermediate node of each shortest path
+ * @param numNodes number of nodes in the graph
+ * @param numThreads number of ranges each phase is split into, 0 for one
+ * tile per range
+ */
+static void floydWarshallCPU(cl_uint *pathDistanceMatrix, cl_uint *pathMatrix,
+                             const cl_uint numNodes,
+                             cl_uint numThreads = 0) {
+  const cl_uint numBlocks =
+      (numNodes + FLOYDWARSHALL_CPU_BLOCK - 1) / FLOYDWARSHALL_CPU_BLOCK;
+  const cl_uint others = numBlocks - 1;
+  SDKThreadPool &pool = SDKThreadPool::instance();
+
+  FloydWarshallCPUArgs args;
+  args.pathDistanceMatrix = pathDistanceMatrix;
+  args.pathMatrix = pathMatrix;
+  args.numNodes = numNodes;
+  args.numBlocks = numBlocks;
+
+  for (cl_uint blockK = 0; blockK < numBlocks; ++blockK) {
+    cl_uint k0 = blockK * FLOYDWARSHALL_CPU_BLOCK;
+    cl_uint k1 = std::min(k0 + FLOYDWARSHALL_CPU_BLOCK, numNodes);
+    floydWarshallCPUTile(pathDistanceMatrix, pathMatrix, numNodes, k0, k1,
+                         k0, k1, k0, k1);
+
+    args.blockK = blockK;
+    for (int phase = 2; phase <= 3; ++phase) {
+      cl_uint tiles = (phase == 2) ? 2 * others : others * others;
+      cl_uint grain =
+          (numThreads == 0) ? 1 : (tiles + numThreads - 1) / numThreads;
+      args.phase = phase;
+      pool.parallelFor(0, tiles, grain, floydWarshallCPUPhase, &args);
+    }
+  }
+}
+
+#endif
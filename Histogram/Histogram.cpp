@@ -34,11 +34,12 @@ int Histogram::calculateHostBin() {
   CHECK_ERROR(status, SDK_SUCCESS,
               "Failed to map device buffer.(dataBuf in calcHostBin)");
 
-  for (int i = 0; i < height; ++i) {
-    for (int j = 0; j < width; ++j) {
-      hostBin[data[i * width + j]]++;
-    }
-  }
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
+  HistogramCPU<cl_uint>::count(data, width * height, hostBin, binSize);
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 
   status = unmapBuffer(dataBuf, data);
   CHECK_ERROR(status, SDK_SUCCESS,
@@ -79,6 +80,15 @@ int Histogram::setupHistogram() {
     data[i] = rand() % (cl_uint)(binSize);
   }
 
+  // Heavily skewed input: 7 of every 8 values fall into the middle bin
+  if (skewed) {
+    for (i = 0; i < width * height; i++) {
+      if (rand() % 8) {
+        data[i] = binSize / 2;
+      }
+    }
+  }
+
   status = unmapBuffer(dataBuf, data);
   CHECK_ERROR(status, SDK_SUCCESS, "Failed to unmap device buffer.(dataBuf)");
 
@@ -142,7 +152,7 @@ int Histogram::setupCL(void) {
    */
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -385,6 +395,19 @@ int Histogram::initialize() {
   sampleArgs->AddOption(vector_option);
   delete vector_option;
 
+  Option* skewed_option = new Option;
+  CHECK_ALLOCATION(skewed_option, "Memory allocation error.\n");
+
+  skewed_option->_sVersion = "";
+  skewed_option->_lVersion = "skewed";
+  skewed_option->_description =
+      "Generate heavily skewed input, 7/8 of the values in one bin";
+  skewed_option->_type = CA_NO_ARGUMENT;
+  skewed_option->_value = &skewed;
+
+  sampleArgs->AddOption(skewed_option);
+  delete skewed_option;
+
   return SDK_SUCCESS;
 }
 
@@ -443,9 +466,11 @@ int Histogram::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -511,7 +536,10 @@ void Histogram::printStats() {
     stats[3] = toString(avgKernelTime, std::dec);
     stats[4] = toString(((width * height) / avgKernelTime), std::dec);
 
-    printStatistics(strArray, stats, 5);
+    printStatisticsWithHost(strArray, stats, 5, hostTime, "Host Elements/sec",
+                            width * height);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -580,7 +608,7 @@ int main(int argc, char* argv[]) {
   }
 
   // Verify
-  if (clHistogram.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clHistogram.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
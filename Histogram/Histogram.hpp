@@ -34,6 +34,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "HistogramCPU.hpp"
 
 using namespace appsdk;
 
@@ -68,6 +69,7 @@ class Histogram {
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;   /**< time taken by the host histogram */
 
   cl_ulong totalLocalMemory; /**< Max local memory allowed */
   cl_ulong usedLocalMemory;  /**< Used local memory by kernel */
@@ -84,6 +86,7 @@ class Histogram {
   int iterations;  /**< Number of iterations for kernel execution */
   bool scalar;     /**< scalar kernel */
   bool vector;     /**< vector kernel */
+  bool skewed;     /**< put most of the input in a single bin */
   int vectorWidth; /**< vector width used by the kernel*/
   size_t globalThreads;
   size_t localThreads;
@@ -106,20 +109,22 @@ class Histogram {
   Histogram()
       : binSize(BIN_SIZE),
         groupSize(GROUP_SIZE),
-        setupTime(0),
-        kernelTime(0),
         subHistgCnt(SUB_HISTOGRAM_COUNT),
-        groupIterations(GROUP_ITERATIONS),
         data(NULL),
         hostBin(NULL),
         midDeviceBin(NULL),
         deviceBin(NULL),
+        setupTime(0),
+        kernelTime(0),
+        hostTime(0),
         devices(NULL),
-        byteRWSupport(true),
         iterations(1),
         scalar(false),
         vector(false),
-        vectorWidth(0) {
+        skewed(false),
+        vectorWidth(0),
+        groupIterations(GROUP_ITERATIONS),
+        byteRWSupport(true) {
     /* Set default values for width and height */
     width = WIDTH;
     height = HEIGHT;
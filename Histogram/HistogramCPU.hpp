@@ -0,0 +1,136 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef HISTOGRAMCPU_H_
+#define HISTOGRAMCPU_H_
+
+#include <CL/cl.h>
+#include <string.h>
+#include <vector>
+#include "SDKThread.hpp"
+
+using namespace appsdk;
+
+/**
+ * Host histogram used to verify Histogram.
+ *
+ * The input is split into one contiguous range per SDKThreadPool thread
+ * and every range counts into a private sub-histogram, so threads never
+ * share a counter. Within a range, consecutive elements go to
+ * HISTOGRAM_CPU_COPIES interleaved copies of each bin. A run of equal
+ * values, the common case for skewed data, then increments different
+ * counters instead of waiting on the previous increment of the same
+ * one. The copies and sub-histograms are summed at the end. Bin counts
+ * above HISTOGRAM_CPU_COPY_BINS outgrow L1 with copies and use one.
+ */
+#define HISTOGRAM_CPU_COPIES 4       /**< copies of each bin per thread */
+#define HISTOGRAM_CPU_COPY_BINS 4096 /**< most bins that get copies */
+
+/**
+ * HistogramCPU
+ * Histogram of 8, 16 or 32-bit values
+ */
+template <typename T>
+class HistogramCPU {
+ public:
+  /**
+   * count
+   * @param data input values, each below numBins
+   * @param n number of values
+   * @param bins numBins counters, overwritten with the histogram
+   * @param numBins number of bins
+   */
+  static void count(const T *data, size_t n, cl_uint *bins, cl_uint numBins) {
+    SDKThreadPool &pool = SDKThreadPool::instance();
+    size_t ranges = pool.getNumWorkers() + 1;
+    if (ranges > n / HISTOGRAM_CPU_COPIES + 1) {
+      ranges = n / HISTOGRAM_CPU_COPIES + 1;
+    }
+
+    Job job;
+    job.data = data;
+    job.n = n;
+    job.ranges = ranges;
+    job.numBins = numBins;
+    job.copies = (numBins <= HISTOGRAM_CPU_COPY_BINS) ? HISTOGRAM_CPU_COPIES
+                                                       : 1;
+    job.counts.assign(ranges * job.copies * numBins, 0);
+    pool.parallelFor(0, ranges, 1, countRanges, &job);
+
+    // Merge the copies of every range
+    memset(bins, 0, numBins * sizeof(cl_uint));
+    for (size_t r = 0; r < ranges; ++r) {
+      const cl_uint *counts = &job.counts[r * job.copies * numBins];
+      for (cl_uint b = 0; b < numBins; ++b) {
+        for (cl_uint c = 0; c < job.copies; ++c) {
+          bins[b] += counts[b * job.copies + c];
+        }
+      }
+    }
+  }
+
+ private:
+  /**
+   * Job
+   * Input and sub-histograms shared by all ranges
+   */
+  struct Job {
+    const T *data;               /**< input values */
+    size_t n;                    /**< number of values */
+    size_t ranges;               /**< number of ranges */
+    cl_uint numBins;             /**< number of bins */
+    cl_uint copies;              /**< copies of each bin */
+    std::vector<cl_uint> counts; /**< copies * numBins per range */
+  };
+
+  /**
+   * countRanges
+   * Counts ranges [rangeBegin, rangeEnd) into their sub-histograms
+   */
+  static void countRanges(size_t rangeBegin, size_t rangeEnd, void *arg) {
+    Job *job = (Job *)arg;
+    const cl_uint copies = job->copies;
+    for (size_t r = rangeBegin; r < rangeEnd; ++r) {
+      const T *data = job->data + job->n * r / job->ranges;
+      const T *end = job->data + job->n * (r + 1) / job->ranges;
+      cl_uint *counts = &job->counts[r * copies * job->numBins];
+      if (copies == HISTOGRAM_CPU_COPIES) {
+        for (; data + HISTOGRAM_CPU_COPIES <= end;
+             data += HISTOGRAM_CPU_COPIES) {
+          counts[data[0] * HISTOGRAM_CPU_COPIES]++;
+          counts[data[1] * HISTOGRAM_CPU_COPIES + 1]++;
+          counts[data[2] * HISTOGRAM_CPU_COPIES + 2]++;
+          counts[data[3] * HISTOGRAM_CPU_COPIES + 3]++;
+        }
+      }
+      for (; data < end; ++data) {
+        counts[*data * copies]++;
+      }
+    }
+  }
+};
+
+#endif
@@ -122,7 +122,7 @@ int LUD::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -395,19 +395,8 @@ int LUD::runCLKernels(void) {
 }
 
 void LUD::LUDCPUReference(float* matrixCPU, const cl_uint effectiveDimension) {
-  for (unsigned int d = 0; d < effectiveDimension - 1; d++) {
-    for (unsigned i = d + 1; i < effectiveDimension; i++) {
-      float ratio = matrixCPU[i * effectiveDimension + d] /
-                    matrixCPU[d * effectiveDimension + d];
-      for (unsigned int j = d; j < effectiveDimension; j++) {
-        matrixCPU[i * effectiveDimension + j] -=
-            matrixCPU[d * effectiveDimension + j] * ratio;
-        if (j == d) {
-          matrixCPU[i * effectiveDimension + j] = ratio;
-        }
-      }
-    }
-  }
+  // The kernels do not pivot, so neither does the reference
+  LUDecompositionCPU::factorize(matrixCPU, effectiveDimension);
 }
 
 int LUD::initialize() {
@@ -478,9 +467,11 @@ int LUD::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -522,7 +513,7 @@ int LUD::verifyResults() {
 
 void LUD::printStats() {
   if (sampleArgs->timing) {
-    std::string strArray[4] = {"WxH", "Time(sec)",
+    std::string strArray[3] = {"WxH", "Time(sec)",
                                "[Transfer+Kernel]Time(sec)"};
     std::string stats[3];
 
@@ -533,7 +524,9 @@ void LUD::printStats() {
     stats[1] = toString(sampleTimer->totalTime, std::dec);
     stats[2] = toString(totalKernelTime, std::dec);
 
-    printStatistics(strArray, stats, 3);
+    printStatisticsWithHost(strArray, stats, 3, referenceKernelTime);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -606,7 +599,7 @@ int main(int argc, char* argv[]) {
     }
 
     // VerifyResults
-    if (clLUDecompose.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clLUDecompose.verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
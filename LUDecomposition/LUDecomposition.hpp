@@ -32,6 +32,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "CLUtil.hpp"
+#include "LUDecompositionCPU.hpp"
 
 using namespace appsdk;
 
@@ -94,6 +95,7 @@ class LUD {
     blockSize = effectiveDimension / 4;
     setupTime = 0;
     totalKernelTime = 0;
+    referenceKernelTime = 0;
     iterations = 1;
     sampleArgs = new CLCommandArgs();
     sampleTimer = new SDKTimer();
@@ -130,11 +132,11 @@ class LUD {
   int runCLKernels();
 
   /**
-   * Reference CPU implementation of matrix transpose
-   * @param output stores the transpose of the input
-   * @param input  input matrix
-   * @param width  width of the input matrix
-   * @param height height of the array
+   * Reference CPU implementation of LU decomposition, see
+   * LUDecompositionCPU.hpp
+   * @param matrixCPU input matrix, overwritten with L and U packed
+   * together the way the kernels write them
+   * @param effectiveDimension dimension of the matrix
    */
   void LUDCPUReference(float *matrixCPU, const cl_uint effectiveDimension);
 
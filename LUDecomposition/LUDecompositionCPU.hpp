@@ -0,0 +1,255 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef LUDECOMPOSITIONCPU_H_
+#define LUDECOMPOSITIONCPU_H_
+
+#include <CL/cl.h>
+#include <math.h>
+#include <algorithm>
+#include "SDKThread.hpp"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host LU factorization used to verify LUDecomposition.
+ *
+ * Right-looking and blocked: each LUD_CPU_PANEL wide panel of columns is
+ * factorized on its own, the matching rows of U right of it are solved
+ * against the panel's unit lower triangle, and the trailing matrix is
+ * then updated with one GEMM shaped A22 -= L21 * U12. That update holds
+ * nearly all of the flops. It is split across SDKThreadPool in ranges
+ * of LUD_CPU_ROWS rows and runs LUD_CPU_ROWS x LUD_CPU_COLS register
+ * tiles over LUD_CPU_BLOCK_N wide slices of U12.
+ *
+ * The result is packed like the kernels write it: U on and above the
+ * diagonal, the multipliers of the unit lower L below it. Without
+ * pivoting every element sees the same operations in the same order as
+ * the unblocked Doolittle loop.
+ */
+#define LUD_CPU_PANEL 64     /**< columns factorized per panel */
+#define LUD_CPU_ROWS 4       /**< rows of A22 in a register tile */
+#define LUD_CPU_COLS 8       /**< columns of A22 in a register tile */
+#define LUD_CPU_BLOCK_N 256  /**< width of a U12 slice kept in cache */
+
+/**
+ * LUDecompositionCPU
+ * In place LU factorization of a row major n x n matrix
+ */
+class LUDecompositionCPU {
+ public:
+  /**
+   * factorize
+   * @param a matrix, overwritten with L and U packed together
+   * @param n dimension of the matrix
+   * @param pivots NULL for no pivoting, as the kernels do. Otherwise n
+   * entries receive the partial pivoting row swaps: row i was exchanged
+   * with row pivots[i] >= i, in order, which gives P * A = L * U
+   */
+  static void factorize(cl_float *a, cl_uint n, cl_uint *pivots = NULL) {
+    for (cl_uint k0 = 0; k0 < n; k0 += LUD_CPU_PANEL) {
+      cl_uint k1 = std::min(k0 + LUD_CPU_PANEL, n);
+      factorizePanel(a, n, k0, k1, pivots);
+      if (k1 == n) {
+        break;
+      }
+      solveU12(a, n, k0, k1);
+
+      Update update;
+      update.a = a;
+      update.n = n;
+      update.k0 = k0;
+      update.k1 = k1;
+      cl_uint tiles = (n - k1 + LUD_CPU_ROWS - 1) / LUD_CPU_ROWS;
+      SDKThreadPool::instance().parallelFor(0, tiles, 0, updateRows,
+                                            &update);
+    }
+  }
+
+ private:
+  /**
+   * Update
+   * Trailing update of the panel [k0, k1)
+   */
+  struct Update {
+    cl_float *a; /**< matrix */
+    cl_uint n;   /**< dimension of the matrix */
+    cl_uint k0;  /**< first column of the panel */
+    cl_uint k1;  /**< one past the last column of the panel */
+  };
+
+  /**
+   * factorizePanel
+   * Unblocked LU of the columns [k0, k1), rows k0 and below. Columns
+   * right of the panel are only touched by row swaps.
+   */
+  static void factorizePanel(cl_float *a, cl_uint n, cl_uint k0, cl_uint k1,
+                             cl_uint *pivots) {
+    for (cl_uint d = k0; d < k1; d++) {
+      if (pivots != NULL) {
+        cl_uint p = d;
+        cl_float best = fabsf(a[d * n + d]);
+        for (cl_uint i = d + 1; i < n; i++) {
+          cl_float v = fabsf(a[i * n + d]);
+          if (v > best) {
+            best = v;
+            p = i;
+          }
+        }
+        pivots[d] = p;
+        if (p != d) {
+          std::swap_ranges(a + d * n, a + (d + 1) * n, a + p * n);
+        }
+      }
+
+      const cl_float *rowD = a + d * n;
+      for (cl_uint i = d + 1; i < n; i++) {
+        cl_float *rowI = a + i * n;
+        cl_float ratio = rowI[d] / rowD[d];
+        rowI[d] = ratio;
+        for (cl_uint j = d + 1; j < k1; j++) {
+          rowI[j] -= rowD[j] * ratio;
+        }
+      }
+    }
+  }
+
+  /**
+   * solveU12
+   * Rows [k0, k1) right of the panel: U12 = inverse(L11) * A12, a forward
+   * substitution with the panel's unit lower triangle
+   */
+  static void solveU12(cl_float *a, cl_uint n, cl_uint k0, cl_uint k1) {
+    for (cl_uint d = k0; d < k1; d++) {
+      const cl_float *rowD = a + d * n;
+      for (cl_uint i = d + 1; i < k1; i++) {
+        cl_float *rowI = a + i * n;
+        cl_float ratio = rowI[d];
+        for (cl_uint j = k1; j < n; j++) {
+          rowI[j] -= rowD[j] * ratio;
+        }
+      }
+    }
+  }
+
+  /**
+   * updateTile
+   * c[0..rows)[0..cols) -= l[0..rows)[k0..k1) * u[k0..k1)[0..cols), where
+   * c, l and u all have a row pitch of n. Full tiles (rows ==
+   * LUD_CPU_ROWS, cols == LUD_CPU_COLS) are kept in registers, edges use
+   * the scalar loop.
+   */
+  static void updateTile(cl_float *c, const cl_float *l, const cl_float *u,
+                         cl_uint n, cl_uint k0, cl_uint k1, cl_uint rows,
+                         cl_uint cols) {
+#ifdef __SSE__
+    if (rows == LUD_CPU_ROWS && cols == LUD_CPU_COLS) {
+      __m128 c00 = _mm_loadu_ps(c), c01 = _mm_loadu_ps(c + 4);
+      __m128 c10 = _mm_loadu_ps(c + n), c11 = _mm_loadu_ps(c + n + 4);
+      __m128 c20 = _mm_loadu_ps(c + 2 * n);
+      __m128 c21 = _mm_loadu_ps(c + 2 * n + 4);
+      __m128 c30 = _mm_loadu_ps(c + 3 * n);
+      __m128 c31 = _mm_loadu_ps(c + 3 * n + 4);
+      for (cl_uint k = k0; k < k1; k++) {
+        __m128 u0 = _mm_loadu_ps(u + k * n);
+        __m128 u1 = _mm_loadu_ps(u + k * n + 4);
+        __m128 l0 = _mm_set1_ps(l[k]);
+        c00 = _mm_sub_ps(c00, _mm_mul_ps(u0, l0));
+        c01 = _mm_sub_ps(c01, _mm_mul_ps(u1, l0));
+        __m128 l1 = _mm_set1_ps(l[n + k]);
+        c10 = _mm_sub_ps(c10, _mm_mul_ps(u0, l1));
+        c11 = _mm_sub_ps(c11, _mm_mul_ps(u1, l1));
+        __m128 l2 = _mm_set1_ps(l[2 * n + k]);
+        c20 = _mm_sub_ps(c20, _mm_mul_ps(u0, l2));
+        c21 = _mm_sub_ps(c21, _mm_mul_ps(u1, l2));
+        __m128 l3 = _mm_set1_ps(l[3 * n + k]);
+        c30 = _mm_sub_ps(c30, _mm_mul_ps(u0, l3));
+        c31 = _mm_sub_ps(c31, _mm_mul_ps(u1, l3));
+      }
+      _mm_storeu_ps(c, c00);
+      _mm_storeu_ps(c + 4, c01);
+      _mm_storeu_ps(c + n, c10);
+      _mm_storeu_ps(c + n + 4, c11);
+      _mm_storeu_ps(c + 2 * n, c20);
+      _mm_storeu_ps(c + 2 * n + 4, c21);
+      _mm_storeu_ps(c + 3 * n, c30);
+      _mm_storeu_ps(c + 3 * n + 4, c31);
+      return;
+    }
+#endif
+    cl_float acc[LUD_CPU_ROWS][LUD_CPU_COLS];
+    for (cl_uint r = 0; r < rows; r++) {
+      for (cl_uint j = 0; j < cols; j++) {
+        acc[r][j] = c[r * n + j];
+      }
+    }
+    for (cl_uint k = k0; k < k1; k++) {
+      const cl_float *uRow = u + k * n;
+      for (cl_uint r = 0; r < rows; r++) {
+        cl_float lVal = l[r * n + k];
+        for (cl_uint j = 0; j < cols; j++) {
+          acc[r][j] -= uRow[j] * lVal;
+        }
+      }
+    }
+    for (cl_uint r = 0; r < rows; r++) {
+      for (cl_uint j = 0; j < cols; j++) {
+        c[r * n + j] = acc[r][j];
+      }
+    }
+  }
+
+  /**
+   * updateRows
+   * A22 -= L21 * U12 for the register tiles of rows [tileBegin, tileEnd)
+   * below the panel
+   */
+  static void updateRows(size_t tileBegin, size_t tileEnd, void *arg) {
+    const Update *update = (const Update *)arg;
+    const cl_uint n = update->n;
+    const cl_uint k0 = update->k0;
+    const cl_uint k1 = update->k1;
+    cl_float *a = update->a;
+    const cl_uint rowBegin = k1 + (cl_uint)tileBegin * LUD_CPU_ROWS;
+    const cl_uint rowEnd = std::min(k1 + (cl_uint)tileEnd * LUD_CPU_ROWS, n);
+    for (cl_uint n0 = k1; n0 < n; n0 += LUD_CPU_BLOCK_N) {
+      cl_uint n1 = std::min(n0 + LUD_CPU_BLOCK_N, n);
+      for (cl_uint i = rowBegin; i < rowEnd; i += LUD_CPU_ROWS) {
+        cl_uint rows = std::min((cl_uint)LUD_CPU_ROWS, rowEnd - i);
+        for (cl_uint j = n0; j < n1; j += LUD_CPU_COLS) {
+          cl_uint cols = std::min((cl_uint)LUD_CPU_COLS, n1 - j);
+          updateTile(a + i * n + j, a + i * n, a + j, n, k0, k1, rows, cols);
+        }
+      }
+    }
+  }
+};
+
+#endif
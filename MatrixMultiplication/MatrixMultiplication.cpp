@@ -116,7 +116,7 @@ int MatrixMultiplication::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -393,13 +393,26 @@ int MatrixMultiplication::runCLKernels(void) {
 void MatrixMultiplication::matrixMultiplicationCPUReference(
     cl_float* output, cl_float* input0, cl_float* input1, const cl_uint y,
     const cl_uint x, const cl_uint z) {
-  for (cl_uint i = 0; i < y; i++) {
-    for (cl_uint j = 0; j < z; j++) {
-      for (cl_uint k = 0; k < x; k++) {
-        output[i * z + j] += (input0[i * x + k] * input1[k * z + j]);
-      }
-    }
+  gemmCPU(output, input0, input1, y, x, z);
+}
+
+int MatrixMultiplication::runCPUBenchmark() {
+  cl_float* cpuOutput = (cl_float*)malloc(height0 * width1 * sizeof(cl_float));
+  CHECK_ALLOCATION(cpuOutput, "Failed to allocate host memory. (cpuOutput)");
+
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  for (int i = 0; i < iterations; i++) {
+    memset(cpuOutput, 0, height0 * width1 * sizeof(cl_float));
+    sampleTimer->startTimer(timer);
+    matrixMultiplicationCPUReference(cpuOutput, input0, input1, height0,
+                                     width0, width1);
+    sampleTimer->stopTimer(timer);
   }
+  cpuTime = (double)(sampleTimer->readTimer(timer)) / iterations;
+
+  free(cpuOutput);
+  return SDK_SUCCESS;
 }
 
 int MatrixMultiplication::initialize() {
@@ -471,6 +484,17 @@ int MatrixMultiplication::initialize() {
   sampleArgs->AddOption(appGflops_option);
   delete appGflops_option;
 
+  Option* cpuGflops_option = new Option;
+  CHECK_ALLOCATION(cpuGflops_option, "Memory Allocation error.\n");
+  cpuGflops_option->_sVersion = "";
+  cpuGflops_option->_lVersion = "cpuGflops";
+  cpuGflops_option->_description =
+      "Also time the host GEMM used for verification and print its GFLOPS";
+  cpuGflops_option->_type = CA_NO_ARGUMENT;
+  cpuGflops_option->_value = &eCpuGFLOPS;
+  sampleArgs->AddOption(cpuGflops_option);
+  delete cpuGflops_option;
+
   return SDK_SUCCESS;
 }
 
@@ -540,7 +564,9 @@ int MatrixMultiplication::run() {
   kernelTime = 0;
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     int kernelRun = runCLKernels();
+    sampleTimer->stopIteration();
     if (kernelRun != SDK_SUCCESS) {
       return kernelRun;
     }
@@ -554,6 +580,10 @@ int MatrixMultiplication::run() {
     printArray<cl_float>("Output", output, width1, 1);
   }
 
+  if (eCpuGFLOPS) {
+    return runCPUBenchmark();
+  }
+
   return SDK_SUCCESS;
 }
 
@@ -619,6 +649,26 @@ void MatrixMultiplication::printStats() {
 
       printStatistics(strArray, stats, 4);
     }
+
+    if (eCpuGFLOPS) {
+      std::string strArray[3] = {"CPU Threads", "CPU Time(sec)",
+                                 "CPU GFLOPS"};
+      std::string stats[3];
+
+      double flops = 2.0 * width0 * width1 * height0;
+      double perf = (flops / cpuTime) * 1e-9;
+      std::cout << "CPU GFlops achieved : " << perf << std::endl
+                << std::endl;
+
+      stats[0] = toString(getNumCPUCores(), std::dec);
+      stats[1] = toString(cpuTime, std::dec);
+      stats[2] = toString(perf, std::dec);
+
+      printStatistics(strArray, stats, 3);
+    }
+
+    // Distribution of the per-iteration [transfer+kernel] time
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -683,7 +733,8 @@ int main(int argc, char* argv[]) {
     }
 
     // VerifyResults
-    if (clMatrixMultiplication.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clMatrixMultiplication.verifyResults()) !=
+        SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
@@ -33,6 +33,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "MatrixMultiplicationCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -81,6 +82,8 @@ class MatrixMultiplication {
   SDKDeviceInfo deviceInfo;   /**< Structure to store device information*/
   KernelWorkGroupInfo kernelInfo; /**< Structure to store kernel related info */
   bool eAppGFLOPS;
+  bool eCpuGFLOPS;  /**< Benchmark the host GEMM used for verification */
+  cl_double cpuTime; /**< Time for one host GEMM */
 
   SDKTimer *sampleTimer; /**< SDKTimer object */
 
@@ -109,6 +112,8 @@ class MatrixMultiplication {
     iterations = 1;
     lds = 0;
     eAppGFLOPS = false;
+    eCpuGFLOPS = false;
+    cpuTime = 0;
   }
 
   /**
@@ -146,8 +151,15 @@ class MatrixMultiplication {
    */
   int runCLKernels();
 
+  /**
+   * Time the host GEMM over the same number of iterations as the kernel
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  int runCPUBenchmark();
+
   /**
    * Reference CPU implementation of Matrix Multiplication
+   * (multithreaded and cache blocked, see MatrixMultiplicationCPU.hpp)
    * @param output stores the output of the multiplied matrices depthxheight
    * @param input0 input matrix of size width x height
    * @param input1 input matrix of size depth x width
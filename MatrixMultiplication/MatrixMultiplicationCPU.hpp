@@ -0,0 +1,189 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef MATRIXMULTIPLICATIONCPU_H_
+#define MATRIXMULTIPLICATIONCPU_H_
+
+#include <CL/cl.h>
+#include "SDKThread.hpp"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host GEMM used to verify MatrixMultiplication: C += A * B with A of
+ * height x width, B of width x depth and C of height x depth, all row
+ * major. Rows of C are split between the threads of SDKThreadPool; each
+ * range of rows walks
+ * GEMM_CPU_BLOCK_K x GEMM_CPU_BLOCK_N panels of B, which stay in cache
+ * while a GEMM_CPU_ROWS x 8 register tile of C is updated from them.
+ */
+#define GEMM_CPU_ROWS 4      /**< rows of C in a register tile */
+#define GEMM_CPU_COLS 8      /**< columns of C in a register tile */
+#define GEMM_CPU_BLOCK_K 128 /**< depth of a B panel */
+#define GEMM_CPU_BLOCK_N 256 /**< width of a B panel */
+
+/**
+ * GemmCPUArgs
+ * Operands shared by all ranges of rows of C
+ */
+struct GemmCPUArgs {
+  cl_float *output;      /**< C */
+  const cl_float *input0; /**< A */
+  const cl_float *input1; /**< B */
+  cl_uint height;        /**< height of A and C */
+  cl_uint width;         /**< width of A and height of B */
+  cl_uint depth;         /**< width of B and C */
+};
+
+/**
+ * gemmCPUTile
+ * C[0..rows)[0..GEMM_CPU_COLS) += A[0..rows)[k0..k1) * B[k0..k1)[0..cols)
+ * for a full tile (rows == GEMM_CPU_ROWS, cols == GEMM_CPU_COLS) in
+ * registers, otherwise with the scalar edge loop
+ */
+static void gemmCPUTile(cl_float *c, const cl_float *a, const cl_float *b,
+                        cl_uint width, cl_uint depth, cl_uint k0, cl_uint k1,
+                        cl_uint rows, cl_uint cols) {
+#ifdef __SSE__
+  if (rows == GEMM_CPU_ROWS && cols == GEMM_CPU_COLS) {
+    __m128 c00 = _mm_loadu_ps(c), c01 = _mm_loadu_ps(c + 4);
+    __m128 c10 = _mm_loadu_ps(c + depth), c11 = _mm_loadu_ps(c + depth + 4);
+    __m128 c20 = _mm_loadu_ps(c + 2 * depth);
+    __m128 c21 = _mm_loadu_ps(c + 2 * depth + 4);
+    __m128 c30 = _mm_loadu_ps(c + 3 * depth);
+    __m128 c31 = _mm_loadu_ps(c + 3 * depth + 4);
+    for (cl_uint k = k0; k < k1; k++) {
+      __m128 b0 = _mm_loadu_ps(b + k * depth);
+      __m128 b1 = _mm_loadu_ps(b + k * depth + 4);
+      __m128 a0 = _mm_set1_ps(a[k]);
+      c00 = _mm_add_ps(c00, _mm_mul_ps(a0, b0));
+      c01 = _mm_add_ps(c01, _mm_mul_ps(a0, b1));
+      __m128 a1 = _mm_set1_ps(a[width + k]);
+      c10 = _mm_add_ps(c10, _mm_mul_ps(a1, b0));
+      c11 = _mm_add_ps(c11, _mm_mul_ps(a1, b1));
+      __m128 a2 = _mm_set1_ps(a[2 * width + k]);
+      c20 = _mm_add_ps(c20, _mm_mul_ps(a2, b0));
+      c21 = _mm_add_ps(c21, _mm_mul_ps(a2, b1));
+      __m128 a3 = _mm_set1_ps(a[3 * width + k]);
+      c30 = _mm_add_ps(c30, _mm_mul_ps(a3, b0));
+      c31 = _mm_add_ps(c31, _mm_mul_ps(a3, b1));
+    }
+    _mm_storeu_ps(c, c00);
+    _mm_storeu_ps(c + 4, c01);
+    _mm_storeu_ps(c + depth, c10);
+    _mm_storeu_ps(c + depth + 4, c11);
+    _mm_storeu_ps(c + 2 * depth, c20);
+    _mm_storeu_ps(c + 2 * depth + 4, c21);
+    _mm_storeu_ps(c + 3 * depth, c30);
+    _mm_storeu_ps(c + 3 * depth + 4, c31);
+    return;
+  }
+#endif
+  cl_float acc[GEMM_CPU_ROWS][GEMM_CPU_COLS];
+  for (cl_uint r = 0; r < rows; r++) {
+    for (cl_uint j = 0; j < cols; j++) {
+      acc[r][j] = c[r * depth + j];
+    }
+  }
+  for (cl_uint k = k0; k < k1; k++) {
+    const cl_float *bRow = b + k * depth;
+    for (cl_uint r = 0; r < rows; r++) {
+      cl_float aVal = a[r * width + k];
+      for (cl_uint j = 0; j < cols; j++) {
+        acc[r][j] += aVal * bRow[j];
+      }
+    }
+  }
+  for (cl_uint r = 0; r < rows; r++) {
+    for (cl_uint j = 0; j < cols; j++) {
+      c[r * depth + j] = acc[r][j];
+    }
+  }
+}
+
+/**
+ * gemmCPURows
+ * Computes the rows of C in register tiles [tileBegin, tileEnd)
+ */
+static void gemmCPURows(size_t tileBegin, size_t tileEnd, void *arg) {
+  GemmCPUArgs *args = (GemmCPUArgs *)arg;
+  const cl_uint width = args->width;
+  const cl_uint depth = args->depth;
+  const cl_uint rowBegin = (cl_uint)tileBegin * GEMM_CPU_ROWS;
+  const cl_uint rowEnd =
+      std::min((cl_uint)tileEnd * GEMM_CPU_ROWS, args->height);
+  for (cl_uint n0 = 0; n0 < depth; n0 += GEMM_CPU_BLOCK_N) {
+    cl_uint n1 = std::min(n0 + GEMM_CPU_BLOCK_N, depth);
+    for (cl_uint k0 = 0; k0 < width; k0 += GEMM_CPU_BLOCK_K) {
+      cl_uint k1 = std::min(k0 + GEMM_CPU_BLOCK_K, width);
+      for (cl_uint i = rowBegin; i < rowEnd; i += GEMM_CPU_ROWS) {
+        cl_uint rows = std::min((cl_uint)GEMM_CPU_ROWS, rowEnd - i);
+        for (cl_uint j = n0; j < n1; j += GEMM_CPU_COLS) {
+          cl_uint cols = std::min((cl_uint)GEMM_CPU_COLS, n1 - j);
+          gemmCPUTile(args->output + i * depth + j,
+                      args->input0 + i * width, args->input1 + j, width,
+                      depth, k0, k1, rows, cols);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * gemmCPU
+ * Multithreaded, cache blocked C += A * B
+ * @param output C, height x depth
+ * @param input0 A, height x width
+ * @param input1 B, width x depth
+ * @param height height of A and C
+ * @param width width of A and height of B
+ * @param depth width of B and C
+ * @param numThreads number of ranges the rows are split into, 0 to let
+ * SDKThreadPool pick
+ */
+static void gemmCPU(cl_float *output, const cl_float *input0,
+                    const cl_float *input1, cl_uint height, cl_uint width,
+                    cl_uint depth, cl_uint numThreads = 0) {
+  GemmCPUArgs args;
+  args.output = output;
+  args.input0 = input0;
+  args.input1 = input1;
+  args.height = height;
+  args.width = width;
+  args.depth = depth;
+
+  // Whole register tiles per range
+  cl_uint tiles = (height + GEMM_CPU_ROWS - 1) / GEMM_CPU_ROWS;
+  cl_uint grain =
+      (numThreads == 0) ? 0 : (tiles + numThreads - 1) / numThreads;
+  SDKThreadPool::instance().parallelFor(0, tiles, grain, gemmCPURows, &args);
+}
+
+#endif
@@ -44,7 +44,12 @@ int MatrixTranspose::setupMatrixTranspose() {
   CHECK_ALLOCATION(output, "Failed to allocate host memory. (output)");
 
   if (sampleArgs->verify) {
-    verificationOutput = (cl_float*)malloc(inputSizeBytes);
+    // Cache line aligned, so the reference can stream its output
+#if defined(_WIN32)
+    verificationOutput = (cl_float*)_aligned_malloc(inputSizeBytes, 64);
+#else
+    verificationOutput = (cl_float*)memalign(64, inputSizeBytes);
+#endif
     CHECK_ALLOCATION(verificationOutput,
                      "Failed to allocate host memory. (verificationOutput)");
   }
@@ -112,7 +117,7 @@ int MatrixTranspose::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
 
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
@@ -323,10 +328,10 @@ void MatrixTranspose::matrixTransposeCPUReference(cl_float* output,
                                                   cl_float* input,
                                                   const cl_uint width,
                                                   const cl_uint height) {
-  for (cl_uint j = 0; j < height; j++) {
-    for (cl_uint i = 0; i < width; i++) {
-      output[i * height + j] = input[j * width + i];
-    }
+  if (output == input) {
+    parallelTransposeInPlace(output, width);
+  } else {
+    parallelTranspose(output, input, width, height);
   }
 }
 
@@ -382,6 +387,22 @@ int MatrixTranspose::initialize() {
   sampleArgs->AddOption(num_iterations);
   delete num_iterations;
 
+  Option* inPlaceParam = new Option;
+  if (!inPlaceParam) {
+    error("Memory allocation error.\n");
+    return SDK_FAILURE;
+  }
+
+  inPlaceParam->_sVersion = "";
+  inPlaceParam->_lVersion = "inplace";
+  inPlaceParam->_description =
+      "Transpose the host reference in place instead of into a second buffer";
+  inPlaceParam->_type = CA_NO_ARGUMENT;
+  inPlaceParam->_value = &inPlace;
+
+  sampleArgs->AddOption(inPlaceParam);
+  delete inPlaceParam;
+
   return SDK_SUCCESS;
 }
 
@@ -436,9 +457,11 @@ int MatrixTranspose::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -456,12 +479,19 @@ int MatrixTranspose::run() {
 int MatrixTranspose::verifyResults() {
   if (sampleArgs->verify) {
     /*
-     * reference implementation
+     * reference implementation, in place on a copy of input (the matrix is
+     * square) if requested
      */
+    cl_float* refInput = input;
+    if (inPlace) {
+      memcpy(verificationOutput, input, width * height * sizeof(cl_float));
+      refInput = verificationOutput;
+    }
+
     int refTimer = sampleTimer->createTimer();
     sampleTimer->resetTimer(refTimer);
     sampleTimer->startTimer(refTimer);
-    matrixTransposeCPUReference(verificationOutput, input, width, height);
+    matrixTransposeCPUReference(verificationOutput, refInput, width, height);
     sampleTimer->stopTimer(refTimer);
     referenceKernelTime = sampleTimer->readTimer(refTimer);
 
@@ -489,10 +519,14 @@ void MatrixTranspose::printStats() {
     stats[1] = toString(sampleTimer->totalTime, std::dec);
     stats[2] = toString(totalKernelTime, std::dec);
 
-    double kernelSpeed = height * width * sizeof(float) * 2 / totalNDRangeTime;
-    stats[3] = toString(kernelSpeed, std::dec);
+    // bytes per nanosecond is GB/s
+    double bytes = height * width * sizeof(float) * 2;
+    stats[3] = toString(bytes / totalNDRangeTime, std::dec);
+
+    printStatisticsWithHost(strArray, stats, 4, referenceKernelTime,
+                            "Host Speed(GB/s)", bytes / 1e9);
 
-    printStatistics(strArray, stats, 4);
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -521,7 +555,11 @@ int MatrixTranspose::cleanup() {
   // release program resources (input memory etc.)
   FREE(input);
   FREE(output);
+#ifdef _WIN32
+  ALIGNED_FREE(verificationOutput);
+#else
   FREE(verificationOutput);
+#endif
   FREE(devices);
 
   return SDK_SUCCESS;
@@ -557,7 +595,8 @@ int main(int argc, char* argv[]) {
 
     else {
       // Verifty
-      if (clMatrixTranspose.verifyResults() == SDK_FAILURE) {
+      if (reportVerification(clMatrixTranspose.verifyResults()) ==
+          SDK_FAILURE) {
         return SDK_FAILURE;
       }
     }
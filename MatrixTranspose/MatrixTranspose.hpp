@@ -31,7 +31,9 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <malloc.h>
 #include "CLUtil.hpp"
+#include "SDKTranspose.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -70,6 +72,7 @@ class MatrixTranspose {
   cl_ulong availableLocalMemory;
   cl_ulong neededLocalMemory;
   int iterations;           /**< Number of iterations for kernel execution */
+  bool inPlace;             /**< Transpose the reference in place */
   SDKDeviceInfo deviceInfo; /**< SDKDeviceInfo class object */
   KernelWorkGroupInfo kernelInfo; /**< KernelWorkGroupInfo class Object */
 
@@ -99,7 +102,9 @@ class MatrixTranspose {
     height = 64;
     setupTime = 0;
     totalKernelTime = 0;
+    referenceKernelTime = 0;
     iterations = 1;
+    inPlace = false;
   }
 
   /**
@@ -131,9 +136,11 @@ class MatrixTranspose {
   int runCLKernels();
 
   /**
-   * Reference CPU implementation of matrix transpose
+   * Reference CPU implementation of matrix transpose, on the host thread
+   * pool with SDKTranspose.hpp
    * @param output stores the transpose of the input
-   * @param input  input matrix
+   * @param input  input matrix; if it is output, the (square) matrix is
+   *               transposed in place
    * @param width  width of the input matrix
    * @param height height of the array
    */
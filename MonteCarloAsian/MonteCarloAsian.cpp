@@ -173,7 +173,7 @@ int MonteCarloAsian::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType() failed.");
 
   status = getDevices(context, &devices, sampleArgs->deviceId,
@@ -1159,9 +1159,11 @@ int MonteCarloAsian::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -1189,305 +1191,36 @@ void MonteCarloAsian::printStats() {
     stats[3] =
         toString((noOfTraj * (noOfSum - 1) * steps) / avgKernelTime, std::dec);
 
-    printStatistics(strArray, stats, 4);
-  }
-}
-
-void MonteCarloAsian::lshift128(unsigned int* input, unsigned int shift,
-                                unsigned int* output) {
-  unsigned int invshift = 32u - shift;
-
-  output[0] = input[0] << shift;
-  output[1] = (input[1] << shift) | (input[0] >> invshift);
-  output[2] = (input[2] << shift) | (input[1] >> invshift);
-  output[3] = (input[3] << shift) | (input[2] >> invshift);
-}
-
-void MonteCarloAsian::rshift128(unsigned int* input, unsigned int shift,
-                                unsigned int* output) {
-  unsigned int invshift = 32u - shift;
-  output[3] = input[3] >> shift;
-  output[2] = (input[2] >> shift) | (input[0] >> invshift);
-  output[1] = (input[1] >> shift) | (input[1] >> invshift);
-  output[0] = (input[0] >> shift) | (input[2] >> invshift);
-}
-
-void MonteCarloAsian::generateRand(unsigned int* seed, float* gaussianRand1,
-                                   float* gaussianRand2,
-                                   unsigned int* nextRand) {
-  unsigned int mulFactor = 4;
-  unsigned int temp[8][4];
-  unsigned int state1[4] = {seed[0], seed[1], seed[2], seed[3]};
-  unsigned int state2[4] = {0u, 0u, 0u, 0u};
-  unsigned int state3[4] = {0u, 0u, 0u, 0u};
-  unsigned int state4[4] = {0u, 0u, 0u, 0u};
-  unsigned int state5[4] = {0u, 0u, 0u, 0u};
-  unsigned int stateMask = 1812433253u;
-  unsigned int thirty = 30u;
-  unsigned int mask4[4] = {stateMask, stateMask, stateMask, stateMask};
-  unsigned int thirty4[4] = {thirty, thirty, thirty, thirty};
-  unsigned int one4[4] = {1u, 1u, 1u, 1u};
-  unsigned int two4[4] = {2u, 2u, 2u, 2u};
-  unsigned int three4[4] = {3u, 3u, 3u, 3u};
-  unsigned int four4[4] = {4u, 4u, 4u, 4u};
-
-  unsigned int r1[4] = {0u, 0u, 0u, 0u};
-  unsigned int r2[4] = {0u, 0u, 0u, 0u};
-
-  unsigned int a[4] = {0u, 0u, 0u, 0u};
-  unsigned int b[4] = {0u, 0u, 0u, 0u};
-
-  unsigned int e[4] = {0u, 0u, 0u, 0u};
-  unsigned int f[4] = {0u, 0u, 0u, 0u};
-  unsigned int thirteen = 13u;
-  unsigned int fifteen = 15u;
-  unsigned int shift = 8u * 3u;
-
-  unsigned int mask11 = 0xfdff37ffu;
-  unsigned int mask12 = 0xef7f3f7du;
-  unsigned int mask13 = 0xff777b7du;
-  unsigned int mask14 = 0x7ff7fb2fu;
-  const float one = 1.0f;
-  const float intMax = 4294967296.0f;
-  const float PI = 3.14159265358979f;
-  const float two = 2.0f;
-
-  float r[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-  float phi[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-
-  float temp1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-  float temp2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-  // Initializing states.
-  for (int c = 0; c < 4; ++c) {
-    state2[c] = mask4[c] * (state1[c] ^ (state1[c] >> thirty4[c])) + one4[c];
-    state3[c] = mask4[c] * (state2[c] ^ (state2[c] >> thirty4[c])) + two4[c];
-    state4[c] = mask4[c] * (state3[c] ^ (state3[c] >> thirty4[c])) + three4[c];
-    state5[c] = mask4[c] * (state4[c] ^ (state4[c] >> thirty4[c])) + four4[c];
-  }
-  unsigned int i = 0;
-  for (i = 0; i < mulFactor; ++i) {
-    switch (i) {
-      case 0:
-        for (int c = 0; c < 4; ++c) {
-          r1[c] = state4[c];
-          r2[c] = state5[c];
-          a[c] = state1[c];
-          b[c] = state3[c];
-        }
-        break;
-      case 1:
-        for (int c = 0; c < 4; ++c) {
-          r1[c] = r2[c];
-          r2[c] = temp[0][c];
-          a[c] = state2[c];
-          b[c] = state4[c];
-        }
-        break;
-      case 2:
-        for (int c = 0; c < 4; ++c) {
-          r1[c] = r2[c];
-          r2[c] = temp[1][c];
-          a[c] = state3[c];
-          b[c] = state5[c];
-        }
-        break;
-      case 3:
-        for (int c = 0; c < 4; ++c) {
-          r1[c] = r2[c];
-          r2[c] = temp[2][c];
-          a[c] = state4[c];
-          b[c] = state1[c];
-        }
-        break;
-      default:
-        break;
-    }
-    lshift128(a, shift, e);
-    rshift128(r1, shift, f);
-
-    temp[i][0] =
-        a[0] ^ e[0] ^ ((b[0] >> thirteen) & mask11) ^ f[0] ^ (r2[0] << fifteen);
-    temp[i][1] =
-        a[1] ^ e[1] ^ ((b[1] >> thirteen) & mask12) ^ f[1] ^ (r2[1] << fifteen);
-    temp[i][2] =
-        a[2] ^ e[2] ^ ((b[2] >> thirteen) & mask13) ^ f[2] ^ (r2[2] << fifteen);
-    temp[i][3] =
-        a[3] ^ e[3] ^ ((b[3] >> thirteen) & mask14) ^ f[3] ^ (r2[3] << fifteen);
-  }
+    printStatisticsWithHost(strArray, stats, 4, hostTime,
+                            "Host Samples used /sec",
+                            noOfTraj * (noOfSum - 1) * steps);
 
-  for (int c = 0; c < 4; ++c) {
-    temp1[c] = temp[0][c] * one / intMax;
-    temp2[c] = temp[1][c] * one / intMax;
-  }
-
-  for (int c = 0; c < 4; ++c) {
-    // Applying Box Mullar Transformations.
-    r[c] = sqrt((-two) * log(temp1[c]));
-    phi[c] = two * PI * temp2[c];
-    gaussianRand1[c] = r[c] * cos(phi[c]);
-    gaussianRand2[c] = r[c] * sin(phi[c]);
-
-    nextRand[c] = temp[2][c];
-  }
-}
-
-void MonteCarloAsian::calOutputs(float strikePrice, float* meanDeriv1,
-                                 float* meanDeriv2, float* meanPrice1,
-                                 float* meanPrice2, float* pathDeriv1,
-                                 float* pathDeriv2, float* priceVec1,
-                                 float* priceVec2) {
-  float temp1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-  float temp2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-  float temp3[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-  float temp4[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-
-  float tempDiff1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-  float tempDiff2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-
-  for (int c = 0; c < 4; ++c) {
-    tempDiff1[c] = meanPrice1[c] - strikePrice;
-    tempDiff2[c] = meanPrice2[c] - strikePrice;
-  }
-  if (tempDiff1[0] > 0.0f) {
-    temp1[0] = 1.0f;
-    temp3[0] = tempDiff1[0];
-  }
-  if (tempDiff1[1] > 0.0f) {
-    temp1[1] = 1.0f;
-    temp3[1] = tempDiff1[1];
-  }
-  if (tempDiff1[2] > 0.0f) {
-    temp1[2] = 1.0f;
-    temp3[2] = tempDiff1[2];
-  }
-  if (tempDiff1[3] > 0.0f) {
-    temp1[3] = 1.0f;
-    temp3[3] = tempDiff1[3];
-  }
-
-  if (tempDiff2[0] > 0.0f) {
-    temp2[0] = 1.0f;
-    temp4[0] = tempDiff2[0];
-  }
-  if (tempDiff2[1] > 0.0f) {
-    temp2[1] = 1.0f;
-    temp4[1] = tempDiff2[1];
-  }
-  if (tempDiff2[2] > 0.0f) {
-    temp2[2] = 1.0f;
-    temp4[2] = tempDiff2[2];
-  }
-  if (tempDiff2[3] > 0.0f) {
-    temp2[3] = 1.0f;
-    temp4[3] = tempDiff2[3];
-  }
-
-  for (int c = 0; c < 4; ++c) {
-    pathDeriv1[c] = meanDeriv1[c] * temp1[c];
-    pathDeriv2[c] = meanDeriv2[c] * temp2[c];
-    priceVec1[c] = temp3[c];
-    priceVec2[c] = temp4[c];
+    sampleTimer->printIterationStats();
   }
 }
 
 void MonteCarloAsian::cpuReferenceImpl() {
-  float timeStep = maturity / (noOfSum - 1);
-  // Initialize random number generator
-  srand(1);
+  MonteCarloAsianCPUParams params;
+  params.initPrice = initPrice;
+  params.strikePrice = strikePrice;
+  params.interest = interest;
+  params.maturity = maturity;
+  params.noOfSum = noOfSum;
+
+  // Each path is seeded from randNum exactly like the kernel
+  size_t count = width * height * 4;
 
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
   for (int k = 0; k < steps; k++) {
-    float c1 = (interest - 0.5f * sigma[k] * sigma[k]) * timeStep;
-    float c2 = sigma[k] * sqrt(timeStep);
-    float c3 = (interest + 0.5f * sigma[k] * sigma[k]);
-
-    for (int j = 0; j < (width * height); j++) {
-      unsigned int nextRand[4] = {0u, 0u, 0u, 0u};
-      for (int c = 0; c < 4; ++c) {
-        nextRand[c] = (cl_uint)rand();
-      }
-
-      float trajPrice1[4] = {initPrice, initPrice, initPrice, initPrice};
-      float sumPrice1[4] = {initPrice, initPrice, initPrice, initPrice};
-      float sumDeriv1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float meanPrice1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float meanDeriv1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float price1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float pathDeriv1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-
-      float trajPrice2[4] = {initPrice, initPrice, initPrice, initPrice};
-      float sumPrice2[4] = {initPrice, initPrice, initPrice, initPrice};
-      float sumDeriv2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float meanPrice2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float meanDeriv2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float price2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float pathDeriv2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-
-      // Run the Monte Carlo simulation a total of Num_Sum - 1 times
-      for (int i = 1; i < noOfSum; i++) {
-        unsigned int tempRand[4] = {0u, 0u, 0u, 0u};
-        for (int c = 0; c < 4; ++c) {
-          tempRand[c] = nextRand[c];
-        }
-
-        float gaussian1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-        float gaussian2[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-        generateRand(tempRand, gaussian1, gaussian2, nextRand);
-
-        // Calculate the trajectory price and sum price for all trajectories
-        for (int c = 0; c < 4; ++c) {
-          trajPrice1[c] = trajPrice1[c] * exp(c1 + c2 * gaussian1[c]);
-          trajPrice2[c] = trajPrice2[c] * exp(c1 + c2 * gaussian2[c]);
-
-          sumPrice1[c] = sumPrice1[c] + trajPrice1[c];
-          sumPrice2[c] = sumPrice2[c] + trajPrice2[c];
-
-          float temp = c3 * timeStep * i;
-
-          // Calculate the derivative price for all trajectories
-          sumDeriv1[c] =
-              sumDeriv1[c] +
-              trajPrice1[c] *
-                  ((log(trajPrice1[c] / initPrice) - temp) / sigma[k]);
-
-          sumDeriv2[c] =
-              sumDeriv2[c] +
-              trajPrice2[c] *
-                  ((log(trajPrice2[c] / initPrice) - temp) / sigma[k]);
-        }
-      }
-
-      // Calculate the average price and average derivative of each simulated
-      // path
-      for (int c = 0; c < 4; ++c) {
-        meanPrice1[c] = sumPrice1[c] / noOfSum;
-        meanPrice2[c] = sumPrice2[c] / noOfSum;
-        meanDeriv1[c] = sumDeriv1[c] / noOfSum;
-        meanDeriv2[c] = sumDeriv2[c] / noOfSum;
-      }
-
-      calOutputs(strikePrice, meanDeriv1, meanDeriv2, meanPrice1, meanPrice2,
-                 pathDeriv1, pathDeriv2, price1, price2);
-
-      for (int c = 0; c < 4; ++c) {
-        priceVals[j * 8 + c] = price1[c];
-        priceVals[j * 8 + 1 * 4 + c] = price2[c];
-        priceDeriv[j * 8 + c] = pathDeriv1[c];
-        priceDeriv[j * 8 + 1 * 4 + c] = pathDeriv2[c];
-      }
-    }
-
-    // Replace Following "for" loop with reduction kernel
-    for (int i = 0; i < noOfTraj * noOfTraj; i++) {
-      refPrice[k] += priceVals[i];
-      refVega[k] += priceDeriv[i];
-    }
-
-    refPrice[k] /= (noOfTraj * noOfTraj);
-    refVega[k] /= (noOfTraj * noOfTraj);
-
-    refPrice[k] = exp(-interest * maturity) * refPrice[k];
-    refVega[k] = exp(-interest * maturity) * refVega[k];
+    params.sigma = sigma[k];
+    MonteCarloAsianCPU<>::simulate(params, randNum + k * count, width * height,
+                                   priceVals, priceDeriv, refPrice[k],
+                                   refVega[k]);
   }
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 }
 
 int MonteCarloAsian::verifyResults() {
@@ -1629,7 +1362,7 @@ int main(int argc, char* argv[]) {
     }
 
     // VerifyResults.
-    if (clMonteCarloAsian.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clMonteCarloAsian.verifyResults()) != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
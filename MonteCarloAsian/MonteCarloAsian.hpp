@@ -37,6 +37,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "MonteCarloAsianCPU.hpp"
 
 using namespace appsdk;
 
@@ -74,6 +75,7 @@ class MonteCarloAsian {
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;   /**< time taken by the host reference simulation */
 
   cl_float *sigma; /**< Array of sigma values */
   cl_float *price; /**< Array of price values */
@@ -158,6 +160,7 @@ class MonteCarloAsian {
 
     setupTime = 0;
     kernelTime = 0;
+    hostTime = 0;
     blockSizeX = GROUP_SIZE;
     blockSizeY = 1;
 
@@ -274,43 +277,9 @@ class MonteCarloAsian {
   int verifyResults();
 
  private:
-  /**
-   * @brief Left shift
-   * @param input input to be shifted
-   * @param shift shifting count
-   * @param output result after shifting input
-   */
-  void lshift128(unsigned int *input, unsigned int shift, unsigned int *output);
-
-  /**
-   * @brief Right shift
-   * @param input input to be shifted
-   * @param shift shifting count
-   * @param output result after shifting input
-   */
-  void rshift128(unsigned int *input, unsigned int shift, unsigned int *output);
-
-  /**
-   * @brief Generates gaussian random numbers by using
-   *        Mersenenne Twister algo and box muller transformation
-   * @param seedArray  seed
-   * @param gaussianRand1 gaussian random number generated
-   * @param gaussianRand2 gaussian random number generated
-   * @param nextRand  generated seed for next usage
-   */
-  void generateRand(unsigned int *seed, float *gaussianRand1,
-                    float *gaussianRand2, unsigned int *nextRand);
-
-  /**
-   * @brief   calculates the  price and vega for all trajectories
-   */
-  void calOutputs(float strikePrice, float *meanDeriv1, float *meanDeriv2,
-                  float *meanPrice1, float *meanPrice2, float *pathDeriv1,
-                  float *pathDeriv2, float *priceVec1, float *priceVec2);
-
   /**
    * @brief   Reference implementation for Monte Carlo simuation for
-   *          Asian Option pricing
+   *          Asian Option pricing, see MonteCarloAsianCPU.hpp
    */
   void cpuReferenceImpl();
 
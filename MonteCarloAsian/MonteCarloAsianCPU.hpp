@@ -0,0 +1,476 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef MONTECARLOASIANCPU_H_
+#define MONTECARLOASIANCPU_H_
+
+#include <CL/cl.h>
+#include <math.h>
+#include <vector>
+#include "SDKMath.hpp"
+#include "SDKThread.hpp"
+
+using namespace appsdk;
+
+/**
+ * Host Monte Carlo simulator used to verify MonteCarloAsian.
+ *
+ * Each path is driven by its own uint4 seed, the same one the kernel reads
+ * from randArray, through the kernel's four-lane generator and Box-Muller
+ * transform. A path yields 8 trajectories (4 lanes x 2 gaussians). Paths
+ * are independent, so they are spread over SDKThreadPool in fixed blocks
+ * and each block is summed pairwise into a partial. The partials are then
+ * summed pairwise as well, so the result does not depend on the thread
+ * count. With SSE2 the four lanes of a path live in one register, with
+ * log, exp, sin and cos from SDKMath.hpp; otherwise the lanes are looped
+ * over with libm.
+ */
+#define MONTECARLOASIAN_CPU_BLOCK 256 /**< paths per task and partial sum */
+
+/**
+ * MonteCarloAsianCPUParams
+ * Option and simulation parameters of one step
+ */
+struct MonteCarloAsianCPUParams {
+  cl_float initPrice;   /**< initial price */
+  cl_float strikePrice; /**< strike price */
+  cl_float interest;    /**< interest rate */
+  cl_float maturity;    /**< maturity */
+  cl_float sigma;       /**< volatility of this step */
+  cl_int noOfSum;       /**< number of exercise points */
+};
+
+/**
+ * MonteCarloAsianScalar
+ * The four lanes of a path as arrays, with libm
+ */
+struct MonteCarloAsianScalar {
+  struct Vec {
+    cl_float s[4];
+  };
+  struct UVec {
+    cl_uint s[4];
+  };
+
+  static UVec load(const cl_uint *p) {
+    UVec r;
+    for (int c = 0; c < 4; ++c) r.s[c] = p[c];
+    return r;
+  }
+  static void store(cl_float *p, Vec a) {
+    for (int c = 0; c < 4; ++c) p[c] = a.s[c];
+  }
+  static Vec set(cl_float a) {
+    Vec r;
+    for (int c = 0; c < 4; ++c) r.s[c] = a;
+    return r;
+  }
+  static UVec set(cl_uint a, cl_uint b, cl_uint c, cl_uint d) {
+    UVec r;
+    r.s[0] = a;
+    r.s[1] = b;
+    r.s[2] = c;
+    r.s[3] = d;
+    return r;
+  }
+
+  static UVec add(UVec a, cl_uint b) {
+    for (int c = 0; c < 4; ++c) a.s[c] += b;
+    return a;
+  }
+  static UVec mul(UVec a, cl_uint b) {
+    for (int c = 0; c < 4; ++c) a.s[c] *= b;
+    return a;
+  }
+  static UVec bitXor(UVec a, UVec b) {
+    for (int c = 0; c < 4; ++c) a.s[c] ^= b.s[c];
+    return a;
+  }
+  static UVec bitAnd(UVec a, UVec b) {
+    for (int c = 0; c < 4; ++c) a.s[c] &= b.s[c];
+    return a;
+  }
+  static UVec shiftLeft(UVec a, int n) {
+    for (int c = 0; c < 4; ++c) a.s[c] <<= n;
+    return a;
+  }
+  static UVec shiftRight(UVec a, int n) {
+    for (int c = 0; c < 4; ++c) a.s[c] >>= n;
+    return a;
+  }
+
+  /**
+   * lshift128
+   * The four lanes shifted left by 24 bits as one 128-bit value
+   */
+  static UVec lshift128(UVec a) {
+    UVec r;
+    r.s[0] = a.s[0] << 24;
+    r.s[1] = (a.s[1] << 24) | (a.s[0] >> 8);
+    r.s[2] = (a.s[2] << 24) | (a.s[1] >> 8);
+    r.s[3] = (a.s[3] << 24) | (a.s[2] >> 8);
+    return r;
+  }
+
+  /**
+   * rshift128
+   * The four lanes shifted right by 24 bits as one 128-bit value
+   */
+  static UVec rshift128(UVec a) {
+    UVec r;
+    r.s[3] = a.s[3] >> 24;
+    r.s[2] = (a.s[2] >> 24) | (a.s[3] << 8);
+    r.s[1] = (a.s[1] >> 24) | (a.s[2] << 8);
+    r.s[0] = (a.s[0] >> 24) | (a.s[1] << 8);
+    return r;
+  }
+
+  /**
+   * toUnit
+   * a / 2^32
+   */
+  static Vec toUnit(UVec a) {
+    Vec r;
+    for (int c = 0; c < 4; ++c) r.s[c] = a.s[c] * 1.0f / 4294967296.0f;
+    return r;
+  }
+
+  static Vec add(Vec a, Vec b) {
+    for (int c = 0; c < 4; ++c) a.s[c] += b.s[c];
+    return a;
+  }
+  static Vec sub(Vec a, Vec b) {
+    for (int c = 0; c < 4; ++c) a.s[c] -= b.s[c];
+    return a;
+  }
+  static Vec mul(Vec a, Vec b) {
+    for (int c = 0; c < 4; ++c) a.s[c] *= b.s[c];
+    return a;
+  }
+  static Vec div(Vec a, Vec b) {
+    for (int c = 0; c < 4; ++c) a.s[c] /= b.s[c];
+    return a;
+  }
+  static Vec sqrt(Vec a) {
+    for (int c = 0; c < 4; ++c) a.s[c] = ::sqrt(a.s[c]);
+    return a;
+  }
+  static Vec exp(Vec a) {
+    for (int c = 0; c < 4; ++c) a.s[c] = ::exp(a.s[c]);
+    return a;
+  }
+  static Vec log(Vec a) {
+    for (int c = 0; c < 4; ++c) a.s[c] = ::log(a.s[c]);
+    return a;
+  }
+  static void sinCos(Vec a, Vec &sinA, Vec &cosA) {
+    for (int c = 0; c < 4; ++c) {
+      sinA.s[c] = ::sin(a.s[c]);
+      cosA.s[c] = ::cos(a.s[c]);
+    }
+  }
+
+  /**
+   * ifPositive
+   * a where x > 0, 0 elsewhere
+   */
+  static Vec ifPositive(Vec x, Vec a) {
+    for (int c = 0; c < 4; ++c) a.s[c] = (x.s[c] > 0.0f) ? a.s[c] : 0.0f;
+    return a;
+  }
+};
+
+#ifdef __SSE2__
+/**
+ * MonteCarloAsianSSE
+ * The four lanes of a path in one SSE2 register
+ */
+struct MonteCarloAsianSSE {
+  typedef __m128 Vec;
+  typedef __m128i UVec;
+
+  static UVec load(const cl_uint *p) {
+    return _mm_loadu_si128((const __m128i *)p);
+  }
+  static void store(cl_float *p, Vec a) { _mm_storeu_ps(p, a); }
+  static Vec set(cl_float a) { return _mm_set1_ps(a); }
+  static UVec set(cl_uint a, cl_uint b, cl_uint c, cl_uint d) {
+    return _mm_set_epi32((int)d, (int)c, (int)b, (int)a);
+  }
+
+  static UVec add(UVec a, cl_uint b) {
+    return _mm_add_epi32(a, _mm_set1_epi32((int)b));
+  }
+  /**
+   * mul
+   * Low 32 bits of each product; SSE2 only multiplies even lanes
+   */
+  static UVec mul(UVec a, cl_uint b) {
+    const __m128i vb = _mm_set1_epi32((int)b);
+    __m128i even = _mm_mul_epu32(a, vb);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), vb);
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+  }
+  static UVec bitXor(UVec a, UVec b) { return _mm_xor_si128(a, b); }
+  static UVec bitAnd(UVec a, UVec b) { return _mm_and_si128(a, b); }
+  static UVec shiftLeft(UVec a, int n) {
+    return _mm_sll_epi32(a, _mm_cvtsi32_si128(n));
+  }
+  static UVec shiftRight(UVec a, int n) {
+    return _mm_srl_epi32(a, _mm_cvtsi32_si128(n));
+  }
+  static UVec lshift128(UVec a) { return _mm_slli_si128(a, 3); }
+  static UVec rshift128(UVec a) { return _mm_srli_si128(a, 3); }
+  static Vec toUnit(UVec a) {
+    // Unsigned conversion from two exact 16-bit halves
+    Vec high = _mm_cvtepi32_ps(_mm_srli_epi32(a, 16));
+    Vec low = _mm_cvtepi32_ps(_mm_and_si128(a, _mm_set1_epi32(0xffff)));
+    Vec value = _mm_add_ps(_mm_mul_ps(high, _mm_set1_ps(65536.0f)), low);
+    return _mm_mul_ps(value, _mm_set1_ps(1.0f / 4294967296.0f));
+  }
+
+  static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+  static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+  static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+  static Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+  static Vec sqrt(Vec a) { return _mm_sqrt_ps(a); }
+  static Vec exp(Vec a) { return expSSE(a); }
+  static Vec log(Vec a) { return logSSE(a); }
+  static void sinCos(Vec a, Vec &sinA, Vec &cosA) { sinCosSSE(a, sinA, cosA); }
+  static Vec ifPositive(Vec x, Vec a) {
+    return _mm_and_ps(_mm_cmpgt_ps(x, _mm_setzero_ps()), a);
+  }
+};
+
+typedef MonteCarloAsianSSE MonteCarloAsianLanes;
+#else
+typedef MonteCarloAsianScalar MonteCarloAsianLanes;
+#endif
+
+/**
+ * MonteCarloAsianCPU
+ * Prices an Asian option and its vega on the host
+ */
+template <class L = MonteCarloAsianLanes>
+class MonteCarloAsianCPU {
+ public:
+  /**
+   * simulate
+   * @param params option and simulation parameters
+   * @param seeds one uint4 seed per path
+   * @param numPaths number of paths, 8 trajectories each
+   * @param priceVals price of every trajectory, 8 per path
+   * @param priceDeriv price derivative of every trajectory, 8 per path
+   * @param price discounted mean price
+   * @param vega discounted mean derivative
+   */
+  static void simulate(const MonteCarloAsianCPUParams &params,
+                       const cl_uint *seeds, size_t numPaths,
+                       cl_float *priceVals, cl_float *priceDeriv,
+                       cl_float &price, cl_float &vega) {
+    size_t numBlocks =
+        (numPaths + MONTECARLOASIAN_CPU_BLOCK - 1) / MONTECARLOASIAN_CPU_BLOCK;
+    std::vector<cl_float> partialPrice(numBlocks), partialVega(numBlocks);
+
+    Job job;
+    job.params = &params;
+    job.seeds = seeds;
+    job.numPaths = numPaths;
+    job.priceVals = priceVals;
+    job.priceDeriv = priceDeriv;
+    job.partialPrice = &partialPrice[0];
+    job.partialVega = &partialVega[0];
+    SDKThreadPool::instance().parallelFor(0, numBlocks, 1, simulateBlocks,
+                                          &job);
+
+    cl_int numTraj = (cl_int)(numPaths * 8);
+    cl_float discount = exp(-params.interest * params.maturity);
+    price = pairwiseSum(&partialPrice[0], numBlocks) / numTraj;
+    vega = pairwiseSum(&partialVega[0], numBlocks) / numTraj;
+    price = discount * price;
+    vega = discount * vega;
+  }
+
+ private:
+  typedef typename L::Vec Vec;
+  typedef typename L::UVec UVec;
+
+  /**
+   * Job
+   * Arguments of simulate shared by its tasks
+   */
+  struct Job {
+    const MonteCarloAsianCPUParams *params; /**< parameters */
+    const cl_uint *seeds;                   /**< seed of each path */
+    size_t numPaths;                        /**< number of paths */
+    cl_float *priceVals;                    /**< trajectory prices */
+    cl_float *priceDeriv;                   /**< trajectory derivatives */
+    cl_float *partialPrice;                 /**< price sum of each block */
+    cl_float *partialVega;                  /**< derivative sum of each block */
+  };
+
+  /**
+   * pairwiseSum
+   * Sum of n values, halving recursively
+   */
+  static cl_float pairwiseSum(const cl_float *values, size_t n) {
+    if (n <= 8) {
+      cl_float sum = 0.0f;
+      for (size_t i = 0; i < n; i++) {
+        sum += values[i];
+      }
+      return sum;
+    }
+    size_t half = n / 2;
+    return pairwiseSum(values, half) + pairwiseSum(values + half, n - half);
+  }
+
+  /**
+   * generateRand
+   * The kernel's generator: two sets of four gaussian random numbers from
+   * seed, and the seed of the next call
+   */
+  static void generateRand(UVec seed, Vec &gaussian1, Vec &gaussian2,
+                           UVec &nextRand) {
+    const cl_uint stateMask = 1812433253u;
+    const UVec mask = L::set(0xfdff37ffu, 0xef7f3f7du, 0xff777b7du,
+                             0x7ff7fb2fu);
+
+    UVec state1 = seed;
+    UVec state2 = L::add(
+        L::mul(L::bitXor(state1, L::shiftRight(state1, 30)), stateMask), 1u);
+    UVec state3 = L::add(
+        L::mul(L::bitXor(state2, L::shiftRight(state2, 30)), stateMask), 2u);
+    UVec state4 = L::add(
+        L::mul(L::bitXor(state3, L::shiftRight(state3, 30)), stateMask), 3u);
+    UVec state5 = L::add(
+        L::mul(L::bitXor(state4, L::shiftRight(state4, 30)), stateMask), 4u);
+
+    // Only the first three of the kernel's four outputs are used
+    UVec temp0 = twist(state1, state3, state4, state5, mask);
+    UVec temp1 = twist(state2, state4, state5, temp0, mask);
+    UVec temp2 = twist(state3, state5, temp0, temp1, mask);
+
+    // Box-Muller transform
+    Vec r = L::sqrt(L::mul(L::set(-2.0f), L::log(L::toUnit(temp0))));
+    Vec phi = L::mul(L::set(2.0f * 3.14159265358979f), L::toUnit(temp1));
+    Vec sinPhi, cosPhi;
+    L::sinCos(phi, sinPhi, cosPhi);
+    gaussian1 = L::mul(r, cosPhi);
+    gaussian2 = L::mul(r, sinPhi);
+    nextRand = temp2;
+  }
+
+  /**
+   * twist
+   * One output of the generator
+   */
+  static UVec twist(UVec a, UVec b, UVec r1, UVec r2, UVec mask) {
+    UVec t = L::bitXor(a, L::lshift128(a));
+    t = L::bitXor(t, L::bitAnd(L::shiftRight(b, 13), mask));
+    t = L::bitXor(t, L::rshift128(r1));
+    return L::bitXor(t, L::shiftLeft(r2, 15));
+  }
+
+  /**
+   * simulateBlocks
+   * Simulates blocks [begin, end) of paths and sums each block
+   */
+  static void simulateBlocks(size_t begin, size_t end, void *arg) {
+    Job *job = (Job *)arg;
+    const MonteCarloAsianCPUParams &p = *job->params;
+    const cl_float timeStep = p.maturity / (p.noOfSum - 1);
+    const Vec c1 =
+        L::set((p.interest - 0.5f * p.sigma * p.sigma) * timeStep);
+    const Vec c2 = L::set(p.sigma * sqrt(timeStep));
+    const cl_float c3 = (p.interest + 0.5f * p.sigma * p.sigma);
+    const Vec initPrice = L::set(p.initPrice);
+    const Vec strikePrice = L::set(p.strikePrice);
+    const Vec sigma = L::set(p.sigma);
+    const Vec noOfSum = L::set((cl_float)p.noOfSum);
+    const Vec zero = L::set(0.0f);
+    const Vec one = L::set(1.0f);
+
+    for (size_t block = begin; block < end; block++) {
+      size_t first = block * MONTECARLOASIAN_CPU_BLOCK;
+      size_t last = first + MONTECARLOASIAN_CPU_BLOCK;
+      if (last > job->numPaths) {
+        last = job->numPaths;
+      }
+
+      for (size_t j = first; j < last; j++) {
+        UVec nextRand = L::load(job->seeds + j * 4);
+        Vec trajPrice1 = initPrice, trajPrice2 = initPrice;
+        Vec sumPrice1 = initPrice, sumPrice2 = initPrice;
+        Vec sumDeriv1 = zero, sumDeriv2 = zero;
+
+        for (int i = 1; i < p.noOfSum; i++) {
+          Vec gaussian1, gaussian2;
+          generateRand(nextRand, gaussian1, gaussian2, nextRand);
+
+          trajPrice1 =
+              L::mul(trajPrice1, L::exp(L::add(c1, L::mul(c2, gaussian1))));
+          trajPrice2 =
+              L::mul(trajPrice2, L::exp(L::add(c1, L::mul(c2, gaussian2))));
+          sumPrice1 = L::add(sumPrice1, trajPrice1);
+          sumPrice2 = L::add(sumPrice2, trajPrice2);
+
+          Vec temp = L::set(c3 * timeStep * i);
+          sumDeriv1 = L::add(
+              sumDeriv1,
+              L::mul(trajPrice1,
+                     L::div(L::sub(L::log(L::div(trajPrice1, initPrice)), temp),
+                            sigma)));
+          sumDeriv2 = L::add(
+              sumDeriv2,
+              L::mul(trajPrice2,
+                     L::div(L::sub(L::log(L::div(trajPrice2, initPrice)), temp),
+                            sigma)));
+        }
+
+        // Payoff and derivative of in-the-money trajectories
+        Vec diff1 = L::sub(L::div(sumPrice1, noOfSum), strikePrice);
+        Vec diff2 = L::sub(L::div(sumPrice2, noOfSum), strikePrice);
+        Vec meanDeriv1 = L::div(sumDeriv1, noOfSum);
+        Vec meanDeriv2 = L::div(sumDeriv2, noOfSum);
+        L::store(job->priceVals + j * 8, L::ifPositive(diff1, diff1));
+        L::store(job->priceVals + j * 8 + 4, L::ifPositive(diff2, diff2));
+        L::store(job->priceDeriv + j * 8,
+                 L::mul(meanDeriv1, L::ifPositive(diff1, one)));
+        L::store(job->priceDeriv + j * 8 + 4,
+                 L::mul(meanDeriv2, L::ifPositive(diff2, one)));
+      }
+
+      size_t count = (last - first) * 8;
+      job->partialPrice[block] =
+          pairwiseSum(job->priceVals + first * 8, count);
+      job->partialVega[block] = pairwiseSum(job->priceDeriv + first * 8, count);
+    }
+  }
+};
+
+#endif
@@ -163,7 +163,7 @@ int MonteCarloAsianDP::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -808,9 +808,11 @@ int MonteCarloAsianDP::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -839,6 +841,8 @@ void MonteCarloAsianDP::printStats() {
         toString((noOfTraj * (noOfSum - 1) * steps) / kernelTime, std::dec);
 
     printStatistics(strArray, stats, 4);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -1257,7 +1261,8 @@ int main(int argc, char* argv[]) {
       return SDK_FAILURE;
     }
 
-    if (clMonteCarloAsianDP.verifyResults() != SDK_SUCCESS) {
+    if (reportVerification(clMonteCarloAsianDP.verifyResults()) !=
+        SDK_SUCCESS) {
       return SDK_FAILURE;
     }
 
@@ -317,7 +317,7 @@ int MonteCarloAsianMultiGPU::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType() failed.");
 
   // getting device on which to run the sample
@@ -577,7 +577,7 @@ struct dataPerGPU {
 /**
 * Thread run function per GPU
 */
-void* threadFuncPerGPU(void* data1) {
+static void* threadFuncPerGPU(void* data1) {
   dataPerGPU* data = (dataPerGPU*)data1;
   int deviceNumber = data->deviceNumber;
   MonteCarloAsianMultiGPU* mcaObj = data->mcaObj;
@@ -1148,8 +1148,14 @@ void* threadFuncPerGPU(void* data1) {
 }
 
 int MonteCarloAsianMultiGPU::runCLKernelsMultiGPU(void) {
-  SDKThread* threads = new SDKThread[numGPUDevices];
-  CHECK_ALLOCATION(threads, "Allocation failed!!");
+  // One worker per GPU, created once and reused across iterations
+  if (gpuPool == NULL) {
+    gpuPool = new SDKThreadPool(numGPUDevices);
+    CHECK_ALLOCATION(gpuPool, "Allocation failed!!");
+  }
+
+  SDKTaskFuture* futures = new SDKTaskFuture[numGPUDevices];
+  CHECK_ALLOCATION(futures, "Allocation failed!!");
 
   dataPerGPU* data = new dataPerGPU[numGPUDevices];
   CHECK_ALLOCATION(data, "Allocation failed!!");
@@ -1157,14 +1163,14 @@ int MonteCarloAsianMultiGPU::runCLKernelsMultiGPU(void) {
   for (int i = 0; i < numGPUDevices; i++) {
     data[i].deviceNumber = i;
     data[i].mcaObj = this;
-    threads[i].create(threadFuncPerGPU, (void*)&data[i]);
+    gpuPool->submit(futures[i], threadFuncPerGPU, (void*)&data[i]);
   }
 
   for (int i = 0; i < numGPUDevices; i++) {
-    threads[i].join();
+    futures[i].wait();
   }
 
-  delete[] threads;
+  delete[] futures;
   delete[] data;
   return SDK_SUCCESS;
 }
@@ -1689,6 +1695,7 @@ int MonteCarloAsianMultiGPU::run() {
   sampleTimer->startTimer(timer);
 
   for (int i = 0; i < iterations; i++) {
+    sampleTimer->startIteration();
     if (noMultiGPUSupport) {
       // Arguments are set and execution call is enqueued on command buffer
       if (runCLKernels() != SDK_SUCCESS) {
@@ -1699,6 +1706,7 @@ int MonteCarloAsianMultiGPU::run() {
         return SDK_FAILURE;
       }
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -1726,6 +1734,8 @@ void MonteCarloAsianMultiGPU::printStats() {
     stats[3] =
         toString((noOfTraj * (noOfSum - 1) * steps) / kernelTime, std::dec);
     printStatistics(strArray, stats, 4);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -2261,7 +2271,8 @@ int main(int argc, char* argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clMonteCarloAsianMultiGPU.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clMonteCarloAsianMultiGPU.verifyResults()) !=
+      SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
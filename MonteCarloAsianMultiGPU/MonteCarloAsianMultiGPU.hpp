@@ -140,6 +140,7 @@ class MonteCarloAsianMultiGPU {
   SDKDeviceInfo deviceInfo;       /**< Structure to store device information*/
   KernelWorkGroupInfo kernelInfo; /**< Structure to store kernel related info */
   SDKTimer *sampleTimer;          /**< SDKTimer object */
+  SDKThreadPool *gpuPool;         /**< Workers that drive one GPU each */
 
   CLCommandArgs *sampleArgs; /**< CLCommand argument class */
 
@@ -189,6 +190,7 @@ class MonteCarloAsianMultiGPU {
     priceDerivBufs = NULL;
     cumulativeStepsPerGPU = NULL;
     gpuDeviceIDs = NULL;
+    gpuPool = NULL;
   }
 
   /**
@@ -210,6 +212,11 @@ class MonteCarloAsianMultiGPU {
     FREE(priceVals);
     FREE(priceDeriv);
     FREE(devices);
+
+    if (gpuPool) {
+      delete gpuPool;
+      gpuPool = NULL;
+    }
   }
 
   /**
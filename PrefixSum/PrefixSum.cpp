@@ -94,7 +94,7 @@ int PrefixSum::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   status = getDevices(context, &devices, sampleArgs->deviceId,
@@ -289,11 +289,18 @@ int PrefixSum::runCLKernels(void) {
 
 void PrefixSum::prefixSumCPUReference(cl_float *output, cl_float *input,
                                       const cl_uint length) {
-  output[0] = input[0];
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
 
-  for (cl_uint i = 1; i < length; ++i) {
-    output[i] = input[i] + output[i - 1];
+  if (kahan) {
+    parallelScanKahan(output, input, length, true);
+  } else {
+    parallelScan(output, input, length, true);
   }
+
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 }
 
 int PrefixSum::initialize() {
@@ -325,6 +332,19 @@ int PrefixSum::initialize() {
   sampleArgs->AddOption(num_iterations);
   delete num_iterations;
 
+  Option *kahan_option = new Option;
+  CHECK_ALLOCATION(kahan_option, "Memory allocation error. (kahan_option)");
+
+  kahan_option->_sVersion = "";
+  kahan_option->_lVersion = "kahan";
+  kahan_option->_description =
+      "Use compensated (Kahan) summation in the host reference scan";
+  kahan_option->_type = CA_NO_ARGUMENT;
+  kahan_option->_value = &kahan;
+
+  sampleArgs->AddOption(kahan_option);
+  delete kahan_option;
+
   return SDK_SUCCESS;
 }
 
@@ -370,9 +390,11 @@ int PrefixSum::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -427,7 +449,10 @@ void PrefixSum::printStats() {
     stats[2] = toString(avgKernelTime, std::dec);
     stats[3] = toString((length / avgKernelTime), std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Samples/sec",
+                            length);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -513,7 +538,7 @@ int main(int argc, char *argv[]) {
   }
 
   // VerifyResults
-  if (clPrefixSum.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clPrefixSum.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
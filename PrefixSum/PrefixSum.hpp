@@ -32,6 +32,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "SDKScan.hpp"
 
 using namespace appsdk;
 
@@ -46,6 +47,8 @@ class PrefixSum {
   cl_uint seed;         /**< Seed value for random number generation */
   cl_double setupTime;  /**< Time for setting up OpenCL */
   cl_double kernelTime; /**< Time for kernel execution */
+  cl_double hostTime;   /**< Time for the host reference scan */
+  bool kahan;           /**< Use the compensated host reference scan */
   cl_uint length;       /**< length of the input array */
   cl_float *input;      /**< Input array */
   cl_float *
@@ -78,6 +81,8 @@ class PrefixSum {
       : seed(123),
         setupTime(0),
         kernelTime(0),
+        hostTime(0),
+        kahan(false),
         length(512),
         input(NULL),
         verificationOutput(NULL),
@@ -134,7 +139,8 @@ class PrefixSum {
   /**
   *******************************************************************************
   * @fn prefixSumCPUReference
-  * @brief Reference CPU implementation of Prefix Sum.
+  * @brief Reference CPU implementation of Prefix Sum. Runs the parallel
+  *        host scan from SDKScan.hpp, compensated when --kahan is given.
   *
   * @param output the array that stores the prefix sum
   * @param input the input array
@@ -189,7 +189,7 @@ int QuasiRandomSequence::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -455,9 +455,11 @@ int QuasiRandomSequence::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -468,22 +470,15 @@ int QuasiRandomSequence::run() {
 }
 
 void QuasiRandomSequence::quasiRandomSequenceCPUReference() {
-  for (int j = 0; j < (int)nDimensions; j++) {
-    for (int i = 0; i < (int)nVectors; i++) {
-      unsigned int temp = 0;
-      for (int k = 0; k < 32; k++) {
-        int mask = (int)(pow(2, (double)k));
-        temp ^= ((i & mask) >> k) * input[j * 32 + k];
-      }
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
 
-      if (i == 0 && j == 0) {
-        verificationOutput[j * nVectors + i] = 0;
-      } else {
-        verificationOutput[j * nVectors + i] =
-            (cl_float)(temp / pow(2, (double)32));
-      }
-    }
-  }
+  QuasiRandomSequenceCPU::generate(verificationOutput, input, nVectors,
+                                   nDimensions);
+
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 }
 
 int QuasiRandomSequence::verifyResults() {
@@ -562,7 +557,10 @@ void QuasiRandomSequence::printStats() {
     stats[2] = toString(avgTime, std::dec);
     stats[3] = toString((length / avgTime), std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Elements/sec",
+                            length);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -619,7 +617,8 @@ int main(int argc, char* argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clQuasiRandomSequence.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clQuasiRandomSequence.verifyResults()) !=
+      SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
@@ -128,6 +128,7 @@ jurisdiction and venue of these courts.
 #include <string>
 #include <fstream>
 #include "CLUtil.hpp"
+#include "QuasiRandomSequenceCPU.hpp"
 #include "SobolPrimitives.hpp"
 
 using namespace appsdk;
@@ -149,6 +150,7 @@ class QuasiRandomSequence {
                           kernel */
   cl_double
       totalKernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;  /**< time taken by the host reference */
 
   cl_ulong
       availableLocalMemory;   /**< Available local memory to be set from host */
@@ -195,6 +197,7 @@ class QuasiRandomSequence {
     nDimensions = 128;
     nVectors = GROUP_SIZE;
     iterations = 1;
+    hostTime = 0;
     vectorWidth = 0;  // Will be queried later for the device
   }
 
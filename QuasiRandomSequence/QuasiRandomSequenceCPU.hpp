@@ -0,0 +1,151 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef QUASIRANDOMSEQUENCECPU_H_
+#define QUASIRANDOMSEQUENCECPU_H_
+
+#include <CL/cl.h>
+#include "SDKThread.hpp"
+
+using namespace appsdk;
+
+/**
+ * Host Sobol generator used to verify QuasiRandomSequence.
+ *
+ * Point i of a dimension is the XOR of the direction numbers selected by
+ * the bits of i, which is what the kernels compute. Instead of testing
+ * all 32 bits for every point, the points are walked in Gray-code order:
+ * consecutive Gray codes differ in one bit, the lowest set bit of the
+ * step count, so each point costs one XOR with the previous one.
+ *
+ * A Gray-code walk over the low bits of an aligned, power of 2 sized
+ * piece visits every index of the piece once, so the points still land
+ * at their natural index, only written in a different order within the
+ * piece. The first point of a piece is computed directly from its
+ * index (skip-ahead), which lets every task produce its own contiguous
+ * chunk of QRS_CPU_CHUNK points independently of the others.
+ *
+ * Results are bit exact with the reference: the 32 bit value is exact
+ * and one rounding to float happens either way.
+ */
+#define QRS_CPU_CHUNK 4096 /**< points per task, a power of 2 */
+
+/**
+ * QuasiRandomSequenceCPU
+ * Sobol points for all dimensions, one row of points per dimension
+ */
+class QuasiRandomSequenceCPU {
+ public:
+  /**
+   * generate
+   * @param output nDimensions rows of nVectors points
+   * @param directions 32 direction numbers per dimension
+   * @param nVectors points per dimension
+   * @param nDimensions number of dimensions
+   */
+  static void generate(cl_float *output, const cl_uint *directions,
+                       cl_uint nVectors, cl_uint nDimensions) {
+    Job job;
+    job.output = output;
+    job.directions = directions;
+    job.nVectors = nVectors;
+    job.chunks = (nVectors + QRS_CPU_CHUNK - 1) / QRS_CPU_CHUNK;
+    SDKThreadPool::instance().parallelFor(0, (size_t)job.chunks * nDimensions,
+                                          0, generateChunks, &job);
+  }
+
+ private:
+  /**
+   * Job
+   * Output and direction numbers shared by all tasks
+   */
+  struct Job {
+    cl_float *output;          /**< nDimensions rows of points */
+    const cl_uint *directions; /**< 32 direction numbers per dimension */
+    cl_uint nVectors;          /**< points per dimension */
+    cl_uint chunks;            /**< chunks per dimension */
+  };
+
+  /**
+   * lowestBit
+   * Index of the lowest set bit of a nonzero value
+   */
+  static inline unsigned int lowestBit(cl_uint x) {
+#ifdef __GNUC__
+    return __builtin_ctz(x);
+#else
+    unsigned int k = 0;
+    while (!(x & 1)) {
+      x >>= 1;
+      ++k;
+    }
+    return k;
+#endif
+  }
+
+  /**
+   * generateChunks
+   * Tasks [begin, end), chunk c of dimension d being task d * chunks + c
+   */
+  static void generateChunks(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    const cl_float scale = 1.0f / 4294967296.0f;
+
+    for (size_t t = begin; t < end; ++t) {
+      size_t d = t / job->chunks;
+      const cl_uint *v = job->directions + d * 32;
+      cl_float *out = job->output + d * job->nVectors;
+      cl_uint first = (cl_uint)(t % job->chunks) * QRS_CPU_CHUNK;
+      cl_uint last = first + QRS_CPU_CHUNK < job->nVectors
+                         ? first + QRS_CPU_CHUNK
+                         : job->nVectors;
+
+      // Split the chunk into aligned pieces, the largest that fit
+      for (cl_uint base = first; base < last;) {
+        cl_uint size = base ? (base & (0u - base)) : QRS_CPU_CHUNK;
+        while (size > last - base) {
+          size >>= 1;
+        }
+
+        // Skip ahead to the first point of the piece
+        cl_uint x = 0;
+        for (cl_uint bits = base; bits; bits &= bits - 1) {
+          x ^= v[lowestBit(bits)];
+        }
+
+        // Gray-code walk of the low bits
+        out[base] = (cl_float)x * scale;
+        for (cl_uint s = 1; s < size; ++s) {
+          x ^= v[lowestBit(s)];
+          out[base + (s ^ (s >> 1))] = (cl_float)x * scale;
+        }
+        base += size;
+      }
+    }
+  }
+};
+
+#endif  // QUASIRANDOMSEQUENCECPU_H_
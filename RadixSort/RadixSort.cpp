@@ -29,51 +29,15 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <math.h>
 
 int RadixSort::hostRadixSort() {
-  cl_uint *histogram = (cl_uint *)malloc(RADICES * sizeof(cl_uint));
-  CHECK_ALLOCATION(histogram, "Failed to allocate host memory. (histogram)");
-
-  cl_uint *tempData = (cl_uint *)malloc(elementCount * sizeof(cl_uint));
-  CHECK_ALLOCATION(tempData, "Failed to allocate host memory. (tempData)");
-
-  if (histogram != NULL && tempData != NULL) {
-    memcpy(tempData, unsortedData, elementCount * sizeof(cl_uint));
-    for (int bits = 0; bits < sizeof(cl_uint) * RADIX; bits += RADIX) {
-      // Initialize histogram bucket to zeros
-      memset(histogram, 0, RADICES * sizeof(cl_uint));
-
-      // Calculate 256 histogram for all element
-      for (int i = 0; i < elementCount; ++i) {
-        cl_uint element = tempData[i];
-        cl_uint value = (element >> bits) & RADIX_MASK;
-        histogram[value]++;
-      }
-
-      // Prescan the histogram bucket
-      cl_uint sum = 0;
-      for (int i = 0; i < RADICES; ++i) {
-        cl_uint val = histogram[i];
-        histogram[i] = sum;
-        sum += val;
-      }
+  memcpy(hSortedData, unsortedData, elementCount * sizeof(cl_uint));
 
-      // Rearrange  the elements based on prescaned histogram
-      for (int i = 0; i < elementCount; ++i) {
-        cl_uint element = tempData[i];
-        cl_uint value = (element >> bits) & RADIX_MASK;
-        cl_uint index = histogram[value];
-        hSortedData[index] = tempData[i];
-        histogram[value] = index + 1;
-      }
-
-      // Copy to tempData for further use
-      if (bits != RADIX * 3) {
-        memcpy(tempData, hSortedData, elementCount * sizeof(cl_uint));
-      }
-    }
-  }
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
+  radixSortCPU<cl_uint>(hSortedData, elementCount);
+  sampleTimer->stopTimer(timer);
+  hostSortTime = sampleTimer->readTimer(timer);
 
-  FREE(tempData);
-  FREE(histogram);
   return SDK_SUCCESS;
 }
 
@@ -176,7 +140,7 @@ int RadixSort::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -813,9 +777,11 @@ int RadixSort::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -916,7 +882,10 @@ void RadixSort::printStats() {
     stats[2] = toString(avgTime, std::dec);
     stats[3] = toString((elementCount / avgTime), std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostSortTime,
+                            "Host Elements/sec", elementCount);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -1019,7 +988,7 @@ int main(int argc, char *argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clRadixSort.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clRadixSort.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
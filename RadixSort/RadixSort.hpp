@@ -37,6 +37,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "RadixSortCPU.hpp"
 
 #ifndef max
 #define max(a, b) (((a) > (b)) ? (a) : (b))
@@ -94,6 +95,7 @@ class RadixSort {
   cl_double totalKernelTime; /**< Total time for kernel execution and memory
                                 transfers */
   cl_double setupTime;       /**< Time for OpenCL initializations */
+  cl_double hostSortTime;    /**< Time for the host reference sort */
 
   // CL objects
   cl_context context;            /**< CL context */
@@ -129,14 +131,15 @@ class RadixSort {
       : elementCount(ELEMENT_COUNT),
         groupSize(GROUP_SIZE),
         numGroups(NUM_GROUPS),
-        totalKernelTime(0),
-        setupTime(0),
+        byteRWSupport(true),
+        iterations(1),
         unsortedData(NULL),
         dSortedData(NULL),
         hSortedData(NULL),
-        devices(NULL),
-        byteRWSupport(true),
-        iterations(1) {
+        totalKernelTime(0),
+        setupTime(0),
+        hostSortTime(0),
+        devices(NULL) {
     sampleArgs = new CLCommandArgs();
     sampleTimer = new SDKTimer();
     sampleArgs->sampleVerStr = SAMPLE_VERSION;
@@ -0,0 +1,280 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef RADIXSORTCPU_H_
+#define RADIXSORTCPU_H_
+
+#include <CL/cl.h>
+#include <string.h>
+#include <vector>
+#include "SDKThread.hpp"
+
+using namespace appsdk;
+
+/**
+ * Host LSD radix sort, used to verify RadixSort and as its CPU baseline.
+ *
+ * Keys are unsigned integers of any width (cl_uint, cl_ulong), optionally
+ * carrying a value each. Every 8-bit pass:
+ *   1. threads build histograms of their own contiguous slice,
+ *   2. each thread derives its scatter offsets from all histograms,
+ *   3. threads scatter their slice through per-bucket write-combining
+ *      buffers, so a bucket is written a cache line at a time.
+ * Passes alternate between the input and one scratch buffer instead of
+ * copying back, and passes whose digit is the same for every key are
+ * skipped. The sort is stable.
+ */
+#define RADIXSORT_CPU_BITS 8
+#define RADIXSORT_CPU_BUCKETS (1 << RADIXSORT_CPU_BITS)
+#define RADIXSORT_CPU_LINE 64 /**< bytes per write-combining buffer */
+#define RADIXSORT_CPU_MIN_SLICE 65536 /**< fewest keys worth a thread */
+
+template <typename K, typename V>
+class RadixSortCPU {
+ public:
+  /**
+   * sort
+   * @param keys keys, sorted in place
+   * @param values value of each key, permuted with the keys; may be NULL
+   * @param count number of keys
+   * @param numThreads number of slices, 0 for one per CPU core
+   */
+  static void sort(K *keys, V *values, size_t count, cl_uint numThreads = 0) {
+    if (count < 2) {
+      return;
+    }
+    if (numThreads == 0) {
+      numThreads = getNumCPUCores();
+    }
+    size_t slices = (count + RADIXSORT_CPU_MIN_SLICE - 1) /
+                    RADIXSORT_CPU_MIN_SLICE;
+    if (numThreads > slices) {
+      numThreads = (cl_uint)slices;
+    }
+
+    std::vector<K> keyScratch(count);
+    std::vector<V> valueScratch(values != NULL ? count : 0);
+    std::vector<size_t> histograms(numThreads * RADIXSORT_CPU_BUCKETS);
+    std::vector<Pass> passes(numThreads);
+
+    K *srcKeys = keys, *dstKeys = &keyScratch[0];
+    V *srcValues = values;
+    V *dstValues = (values != NULL) ? &valueScratch[0] : NULL;
+    size_t sliceSize = (count + numThreads - 1) / numThreads;
+
+    for (cl_uint shift = 0; shift < sizeof(K) * 8;
+         shift += RADIXSORT_CPU_BITS) {
+      for (cl_uint t = 0; t < numThreads; t++) {
+        Pass &pass = passes[t];
+        pass.srcKeys = srcKeys;
+        pass.dstKeys = dstKeys;
+        pass.srcValues = srcValues;
+        pass.dstValues = dstValues;
+        pass.begin = (t * sliceSize < count) ? t * sliceSize : count;
+        pass.end = (pass.begin + sliceSize < count) ? pass.begin + sliceSize
+                                                    : count;
+        pass.shift = shift;
+        pass.thread = t;
+        pass.numThreads = numThreads;
+        pass.histograms = &histograms[0];
+      }
+
+      run(passes, countDigits);
+
+      // A digit shared by all keys leaves the order unchanged
+      bool trivial = false;
+      for (cl_uint b = 0; b < RADIXSORT_CPU_BUCKETS && !trivial; b++) {
+        size_t total = 0;
+        for (cl_uint t = 0; t < numThreads; t++) {
+          total += histograms[t * RADIXSORT_CPU_BUCKETS + b];
+        }
+        trivial = (total == count);
+      }
+      if (trivial) {
+        continue;
+      }
+
+      run(passes, scatter);
+
+      K *tmpKeys = srcKeys;
+      srcKeys = dstKeys;
+      dstKeys = tmpKeys;
+      V *tmpValues = srcValues;
+      srcValues = dstValues;
+      dstValues = tmpValues;
+    }
+
+    if (srcKeys != keys) {
+      memcpy(keys, srcKeys, count * sizeof(K));
+      if (values != NULL) {
+        memcpy(values, srcValues, count * sizeof(V));
+      }
+    }
+  }
+
+ private:
+  /**
+   * Pass
+   * Slice of one thread in one pass
+   */
+  struct Pass {
+    const K *srcKeys;  /**< keys read by this pass */
+    K *dstKeys;        /**< keys written by this pass */
+    const V *srcValues; /**< values read, or NULL */
+    V *dstValues;      /**< values written, or NULL */
+    size_t begin;      /**< first key of the slice */
+    size_t end;        /**< one past the last key of the slice */
+    cl_uint shift;     /**< lowest bit of the digit */
+    cl_uint thread;    /**< index of the slice */
+    cl_uint numThreads; /**< number of slices */
+    size_t *histograms; /**< numThreads x RADIXSORT_CPU_BUCKETS counts */
+  };
+
+  enum { LINE_KEYS = (RADIXSORT_CPU_LINE / sizeof(K) > 0)
+                         ? RADIXSORT_CPU_LINE / sizeof(K)
+                         : 1 };
+
+  static void *countDigits(void *arg) {
+    Pass *pass = (Pass *)arg;
+    size_t *histogram =
+        pass->histograms + pass->thread * RADIXSORT_CPU_BUCKETS;
+    memset(histogram, 0, RADIXSORT_CPU_BUCKETS * sizeof(size_t));
+    for (size_t i = pass->begin; i < pass->end; i++) {
+      histogram[(pass->srcKeys[i] >> pass->shift) &
+                (RADIXSORT_CPU_BUCKETS - 1)]++;
+    }
+    return NULL;
+  }
+
+  static void *scatter(void *arg) {
+    Pass *pass = (Pass *)arg;
+
+    // Bucket b of this slice starts after all keys with a smaller digit
+    // and after bucket b of the slices before it
+    size_t offsets[RADIXSORT_CPU_BUCKETS];
+    size_t sum = 0;
+    for (cl_uint b = 0; b < RADIXSORT_CPU_BUCKETS; b++) {
+      for (cl_uint t = 0; t < pass->numThreads; t++) {
+        if (t == pass->thread) {
+          offsets[b] = sum;
+        }
+        sum += pass->histograms[t * RADIXSORT_CPU_BUCKETS + b];
+      }
+    }
+
+    std::vector<K> keyLines(RADIXSORT_CPU_BUCKETS * LINE_KEYS);
+    std::vector<V> valueLines(pass->srcValues != NULL
+                                  ? RADIXSORT_CPU_BUCKETS * LINE_KEYS
+                                  : 0);
+    cl_uint fill[RADIXSORT_CPU_BUCKETS] = {0};
+
+    for (size_t i = pass->begin; i < pass->end; i++) {
+      K key = pass->srcKeys[i];
+      cl_uint b = (cl_uint)((key >> pass->shift) &
+                            (RADIXSORT_CPU_BUCKETS - 1));
+      keyLines[b * LINE_KEYS + fill[b]] = key;
+      if (pass->srcValues != NULL) {
+        valueLines[b * LINE_KEYS + fill[b]] = pass->srcValues[i];
+      }
+      if (++fill[b] == LINE_KEYS) {
+        flush(pass, keyLines, valueLines, b, LINE_KEYS, offsets[b]);
+        fill[b] = 0;
+      }
+    }
+    for (cl_uint b = 0; b < RADIXSORT_CPU_BUCKETS; b++) {
+      flush(pass, keyLines, valueLines, b, fill[b], offsets[b]);
+    }
+    return NULL;
+  }
+
+  static void flush(Pass *pass, const std::vector<K> &keyLines,
+                    const std::vector<V> &valueLines, cl_uint bucket,
+                    cl_uint n, size_t &offset) {
+    if (n == 0) {
+      return;
+    }
+    memcpy(pass->dstKeys + offset, &keyLines[bucket * LINE_KEYS],
+           n * sizeof(K));
+    if (pass->dstValues != NULL) {
+      memcpy(pass->dstValues + offset, &valueLines[bucket * LINE_KEYS],
+             n * sizeof(V));
+    }
+    offset += n;
+  }
+
+  /**
+   * Job
+   * One step applied to every slice
+   */
+  struct Job {
+    Pass *passes;    /**< one pass per slice */
+    threadFunc func; /**< countDigits or scatter */
+  };
+
+  /**
+   * runSlices
+   * Applies the job to slices [begin, end)
+   */
+  static void runSlices(size_t begin, size_t end, void *arg) {
+    Job *job = (Job *)arg;
+    for (size_t t = begin; t < end; t++) {
+      job->func(&job->passes[t]);
+    }
+  }
+
+  /**
+   * run
+   * Runs func on every pass, one slice per SDKThreadPool task
+   */
+  static void run(std::vector<Pass> &passes, threadFunc func) {
+    Job job;
+    job.passes = &passes[0];
+    job.func = func;
+    SDKThreadPool::instance().parallelFor(0, passes.size(), 1, runSlices,
+                                          &job);
+  }
+};
+
+/**
+ * radixSortCPU
+ * Sorts unsigned keys in place
+ */
+template <typename K>
+static void radixSortCPU(K *keys, size_t count, cl_uint numThreads = 0) {
+  RadixSortCPU<K, K>::sort(keys, NULL, count, numThreads);
+}
+
+/**
+ * radixSortCPU
+ * Sorts unsigned keys in place, permuting values along with them
+ */
+template <typename K, typename V>
+static void radixSortCPU(K *keys, V *values, size_t count,
+                         cl_uint numThreads = 0) {
+  RadixSortCPU<K, V>::sort(keys, values, count, numThreads);
+}
+
+#endif
@@ -198,7 +198,7 @@ int RecursiveGaussian::setupCL() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -617,9 +617,11 @@ int RecursiveGaussian::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Set kernel arguments and run kernel
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -674,134 +676,18 @@ int RecursiveGaussian::cleanup() {
   return SDK_SUCCESS;
 }
 
-void RecursiveGaussian::recursiveGaussianCPU(
-    cl_uchar4* input, cl_uchar4* output, const int width, const int height,
-    const float a0, const float a1, const float a2, const float a3,
-    const float b1, const float b2, const float coefp, const float coefn) {
-  // outer loop over all columns within image
-  for (int X = 0; X < width; X++) {
-    // start forward filter pass
-    float xp[4] = {0.0f, 0.0f, 0.0f, 0.0f};  // previous input
-    float yp[4] = {0.0f, 0.0f, 0.0f, 0.0f};  // previous output
-    float yb[4] = {0.0f, 0.0f, 0.0f, 0.0f};  // previous output by 2
-
-    float xc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-    float yc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-
-    for (int Y = 0; Y < height; Y++) {
-      // output position to write
-      int pos = Y * width + X;
-
-      // convert input element to float4
-      xc[0] = input[pos].s[0];
-      xc[1] = input[pos].s[1];
-      xc[2] = input[pos].s[2];
-      xc[3] = input[pos].s[3];
-
-      yc[0] = (a0 * xc[0]) + (a1 * xp[0]) - (b1 * yp[0]) - (b2 * yb[0]);
-      yc[1] = (a0 * xc[1]) + (a1 * xp[1]) - (b1 * yp[1]) - (b2 * yb[1]);
-      yc[2] = (a0 * xc[2]) + (a1 * xp[2]) - (b1 * yp[2]) - (b2 * yb[2]);
-      yc[3] = (a0 * xc[3]) + (a1 * xp[3]) - (b1 * yp[3]) - (b2 * yb[3]);
-
-      // convert float4 element to output
-      output[pos].s[0] = (cl_uchar)yc[0];
-      output[pos].s[1] = (cl_uchar)yc[1];
-      output[pos].s[2] = (cl_uchar)yc[2];
-      output[pos].s[3] = (cl_uchar)yc[3];
-
-      for (int i = 0; i < 4; i++) {
-        xp[i] = xc[i];
-        yb[i] = yp[i];
-        yp[i] = yc[i];
-      }
-    }
-
-    // start reverse filter pass: ensures response is symmetrical
-    float xn[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-    float xa[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-    float yn[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-    float ya[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-
-    float fTemp[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-
-    for (int Y = height - 1; Y > -1; Y--) {
-      int pos = Y * width + X;
-
-      // convert uchar4 to float4
-      xc[0] = input[pos].s[0];
-      xc[1] = input[pos].s[1];
-      xc[2] = input[pos].s[2];
-      xc[3] = input[pos].s[3];
-
-      yc[0] = (a2 * xn[0]) + (a3 * xa[0]) - (b1 * yn[0]) - (b2 * ya[0]);
-      yc[1] = (a2 * xn[1]) + (a3 * xa[1]) - (b1 * yn[1]) - (b2 * ya[1]);
-      yc[2] = (a2 * xn[2]) + (a3 * xa[2]) - (b1 * yn[2]) - (b2 * ya[2]);
-      yc[3] = (a2 * xn[3]) + (a3 * xa[3]) - (b1 * yn[3]) - (b2 * ya[3]);
-
-      for (int i = 0; i < 4; i++) {
-        xa[i] = xn[i];
-        xn[i] = xc[i];
-        ya[i] = yn[i];
-        yn[i] = yc[i];
-      }
-
-      // convert uhcar4 to float4
-      fTemp[0] = output[pos].s[0];
-      fTemp[1] = output[pos].s[1];
-      fTemp[2] = output[pos].s[2];
-      fTemp[3] = output[pos].s[3];
-
-      fTemp[0] += yc[0];
-      fTemp[1] += yc[1];
-      fTemp[2] += yc[2];
-      fTemp[3] += yc[3];
-
-      // convert float4 to uchar4
-      output[pos].s[0] = (cl_uchar)fTemp[0];
-      output[pos].s[1] = (cl_uchar)fTemp[1];
-      output[pos].s[2] = (cl_uchar)fTemp[2];
-      output[pos].s[3] = (cl_uchar)fTemp[3];
-    }
-  }
-}
-
-void RecursiveGaussian::transposeCPU(cl_uchar4* input, cl_uchar4* output,
-                                     const int width, const int height) {
-  // transpose matrix
-  for (int Y = 0; Y < height; Y++) {
-    for (int X = 0; X < width; X++) {
-      output[Y + X * height] = input[X + Y * width];
-    }
-  }
-}
-
 void RecursiveGaussian::recursiveGaussianCPUReference() {
-  // Create a temp uchar4 array
-  cl_uchar4* temp = (cl_uchar4*)malloc(width * height * sizeof(cl_uchar4));
-  if (temp == NULL) {
-    error("Failed to allocate host memory! (temp)");
-    return;
-  }
-
-  // Call recursive Gaussian CPU
-  recursiveGaussianCPU(verificationInput, temp, width, height, oclGP.a0,
-                       oclGP.a1, oclGP.a2, oclGP.a3, oclGP.b1, oclGP.b2,
-                       oclGP.coefp, oclGP.coefn);
-
-  // Transpose the temp buffer
-  transposeCPU(temp, verificationOutput, width, height);
-
-  // again Call recursive Gaussian CPU
-  recursiveGaussianCPU(verificationOutput, temp, height, width, oclGP.a0,
-                       oclGP.a1, oclGP.a2, oclGP.a3, oclGP.b1, oclGP.b2,
-                       oclGP.coefp, oclGP.coefn);
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
 
-  // Do a final Transpose
-  transposeCPU(temp, verificationOutput, height, width);
+  // Filter columns then rows in one pass, no transposed copy
+  RecursiveGaussianCPU::filter(verificationOutput, verificationInput, width,
+                               height, oclGP.a0, oclGP.a1, oclGP.a2, oclGP.a3,
+                               oclGP.b1, oclGP.b2);
 
-  if (temp) {
-    free(temp);
-  }
+  sampleTimer->stopTimer(timer);
+  hostTime = (double)(sampleTimer->readTimer(timer));
 }
 
 // convert uchar4 data to uint
@@ -873,7 +759,10 @@ void RecursiveGaussian::printStats() {
     stats[2] = toString(sampleTimer->totalTime, std::dec);
     stats[3] = toString(kernelTime, std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Pixels/sec",
+                            width * height);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -901,7 +790,7 @@ int main(int argc, char* argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clRecursiveGaussian.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clRecursiveGaussian.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
@@ -33,6 +33,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "RecursiveGaussianCPU.hpp"
 #include "SDKBitMap.hpp"
 
 using namespace appsdk;
@@ -72,6 +73,7 @@ class RecursiveGaussian {
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;   /**< time taken by the host reference */
 
   cl_uchar4* inputImageData;  /**< Input bitmap data to device */
   cl_uchar4* outputImageData; /**< Output from device */
@@ -130,30 +132,6 @@ class RecursiveGaussian {
   */
   void computeGaussParms(float fSigma, int iOrder, GaussParms* pGP);
 
-  /**
-  * RecursiveGaussian on CPU (for verification)
-  * @param input input image
-  * @param output output image
-  * @param width width of image
-  * @param height height of image
-  * @param a0..a3, b1, b2, coefp, coefn gaussian parameters
-  */
-  void recursiveGaussianCPU(cl_uchar4* input, cl_uchar4* output,
-                            const int width, const int height, const float a0,
-                            const float a1, const float a2, const float a3,
-                            const float b1, const float b2, const float coefp,
-                            const float coefn);
-
-  /**
-  * Transpose on CPU (for verification)
-  * @param input input image
-  * @param output output image
-  * @param width width of input image
-  * @param height height of input image
-  */
-  void transposeCPU(cl_uchar4* input, cl_uchar4* output, const int width,
-                    const int height);
-
   /**
   * Constructor
   * Initialize member variables
@@ -169,6 +147,7 @@ class RecursiveGaussian {
     blockSizeY = 1;
     blockSize = 1;
     iterations = 1;
+    hostTime = 0;
   }
 
   ~RecursiveGaussian() {}
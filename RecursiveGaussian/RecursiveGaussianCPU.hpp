@@ -0,0 +1,327 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef RECURSIVEGAUSSIANCPU_H_
+#define RECURSIVEGAUSSIANCPU_H_
+
+#include <CL/cl.h>
+#include <algorithm>
+#include <vector>
+#include "SDKThread.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host recursive Gaussian used to verify RecursiveGaussian.
+ *
+ * The device filters the columns, transposes, filters the columns of the
+ * transpose and transposes back. Each filter is a causal pass down a
+ * column and an anti-causal pass back up it, rounding to uchar4 after
+ * each as the kernel does. The host computes the same two filters without
+ * the transposes:
+ *
+ * - Vertical: RG_CPU_BAND adjacent columns advance together, one row at a
+ *   time, so every step reads and writes one contiguous row segment and
+ *   the per-column state stays in cache. Each band is a task.
+ * - Horizontal: the second filter runs along the rows of the result, in
+ *   place, reading a copy of each row. RG_CPU_ROWS rows are interleaved so
+ *   their independent recursions overlap. Each group of rows is a task.
+ *
+ * A pixel is one SSE register of four float channels, converted from and
+ * to uchar4 in registers. The arithmetic is evaluated in the reference's
+ * order with the same roundings, so results are bit exact with it.
+ */
+#define RG_CPU_BAND 64 /**< columns per vertical task */
+#define RG_CPU_ROWS 4  /**< rows interleaved in the horizontal pass */
+#define RG_CPU_TASK_ROWS 16 /**< rows per horizontal task */
+
+/**
+ * RecursiveGaussianCPU
+ * Both passes of the recursive Gaussian filter of an image
+ */
+class RecursiveGaussianCPU {
+ public:
+  /**
+   * filter
+   * @param output filtered image, must not overlap input
+   * @param input image to filter
+   * @param width pixels per row
+   * @param height rows
+   * @param a0, a1 causal input coefficients
+   * @param a2, a3 anti-causal input coefficients
+   * @param b1, b2 feedback coefficients
+   */
+  static void filter(cl_uchar4 *output, const cl_uchar4 *input, cl_uint width,
+                     cl_uint height, float a0, float a1, float a2, float a3,
+                     float b1, float b2) {
+    Job job;
+    job.output = output;
+    job.input = input;
+    job.width = width;
+    job.height = height;
+    job.a0 = a0;
+    job.a1 = a1;
+    job.a2 = a2;
+    job.a3 = a3;
+    job.b1 = b1;
+    job.b2 = b2;
+
+    SDKThreadPool &pool = SDKThreadPool::instance();
+    pool.parallelFor(0, (width + RG_CPU_BAND - 1) / RG_CPU_BAND, 1,
+                     verticalBands, &job);
+    pool.parallelFor(0, (height + RG_CPU_TASK_ROWS - 1) / RG_CPU_TASK_ROWS,
+                     1, horizontalRows, &job);
+  }
+
+ private:
+  /**
+   * Job
+   * Image and coefficients shared by all tasks
+   */
+  struct Job {
+    cl_uchar4 *output;      /**< filtered image */
+    const cl_uchar4 *input; /**< image to filter */
+    cl_uint width;          /**< pixels per row */
+    cl_uint height;         /**< rows */
+    float a0, a1, a2, a3;   /**< input coefficients */
+    float b1, b2;           /**< feedback coefficients */
+  };
+
+#ifdef __SSE2__
+  typedef __m128 Pixel;
+
+  static inline Pixel set(float c) { return _mm_set1_ps(c); }
+  static inline Pixel zero() { return _mm_setzero_ps(); }
+  static inline Pixel add(Pixel a, Pixel b) { return _mm_add_ps(a, b); }
+  static inline Pixel sub(Pixel a, Pixel b) { return _mm_sub_ps(a, b); }
+  static inline Pixel mul(Pixel a, Pixel b) { return _mm_mul_ps(a, b); }
+
+  static inline Pixel load(const cl_uchar4 &p) {
+    __m128i z = _mm_setzero_si128();
+    __m128i v = _mm_cvtsi32_si128(*(const int *)&p);
+    v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, z), z);
+    return _mm_cvtepi32_ps(v);
+  }
+
+  // Truncates and keeps the low byte, as the (cl_uchar) cast does
+  static inline void store(cl_uchar4 &p, Pixel x) {
+    __m128i v = _mm_and_si128(_mm_cvttps_epi32(x), _mm_set1_epi32(0xFF));
+    v = _mm_packs_epi32(v, v);
+    *(int *)&p = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+  }
+#else
+  struct Pixel {
+    float s[4];
+  };
+
+  static inline Pixel set(float c) {
+    Pixel r = {{c, c, c, c}};
+    return r;
+  }
+  static inline Pixel zero() { return set(0.0f); }
+  static inline Pixel add(Pixel a, Pixel b) {
+    for (int k = 0; k < 4; ++k) a.s[k] += b.s[k];
+    return a;
+  }
+  static inline Pixel sub(Pixel a, Pixel b) {
+    for (int k = 0; k < 4; ++k) a.s[k] -= b.s[k];
+    return a;
+  }
+  static inline Pixel mul(Pixel a, Pixel b) {
+    for (int k = 0; k < 4; ++k) a.s[k] *= b.s[k];
+    return a;
+  }
+  static inline Pixel load(const cl_uchar4 &p) {
+    Pixel r;
+    for (int k = 0; k < 4; ++k) r.s[k] = p.s[k];
+    return r;
+  }
+  static inline void store(cl_uchar4 &p, Pixel x) {
+    for (int k = 0; k < 4; ++k) p.s[k] = (cl_uchar)x.s[k];
+  }
+#endif
+
+  /**
+   * Coefficients
+   * Filter coefficients broadcast to every channel
+   */
+  struct Coefficients {
+    Pixel a0, a1, a2, a3, b1, b2;
+
+    explicit Coefficients(const Job *job)
+        : a0(set(job->a0)),
+          a1(set(job->a1)),
+          a2(set(job->a2)),
+          a3(set(job->a3)),
+          b1(set(job->b1)),
+          b2(set(job->b2)) {}
+
+    // (a0 * xc) + (a1 * xp) - (b1 * yp) - (b2 * yb)
+    Pixel causal(Pixel xc, Pixel xp, Pixel yp, Pixel yb) const {
+      return sub(sub(add(mul(a0, xc), mul(a1, xp)), mul(b1, yp)),
+                 mul(b2, yb));
+    }
+
+    // (a2 * xn) + (a3 * xa) - (b1 * yn) - (b2 * ya)
+    Pixel antiCausal(Pixel xn, Pixel xa, Pixel yn, Pixel ya) const {
+      return sub(sub(add(mul(a2, xn), mul(a3, xa)), mul(b1, yn)),
+                 mul(b2, ya));
+    }
+  };
+
+  /**
+   * verticalBands
+   * Filters the columns of bands [begin, end) from input into output
+   */
+  static void verticalBands(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    const Coefficients c(job);
+    const size_t width = job->width;
+    Pixel s0[RG_CPU_BAND], s1[RG_CPU_BAND], s2[RG_CPU_BAND],
+        s3[RG_CPU_BAND];
+
+    for (size_t band = begin; band < end; ++band) {
+      size_t x0 = band * RG_CPU_BAND;
+      size_t n = width - x0 < RG_CPU_BAND ? width - x0 : RG_CPU_BAND;
+      const cl_uchar4 *in = job->input + x0;
+      cl_uchar4 *out = job->output + x0;
+
+      // Causal pass, state previous input, output and output by 2
+      for (size_t k = 0; k < n; ++k) {
+        s0[k] = s1[k] = s2[k] = zero();
+      }
+      for (size_t y = 0; y < job->height; ++y) {
+        const cl_uchar4 *row = in + y * width;
+        cl_uchar4 *dst = out + y * width;
+        for (size_t k = 0; k < n; ++k) {
+          Pixel xc = load(row[k]);
+          Pixel yc = c.causal(xc, s0[k], s1[k], s2[k]);
+          store(dst[k], yc);
+          s0[k] = xc;
+          s2[k] = s1[k];
+          s1[k] = yc;
+        }
+      }
+
+      // Anti-causal pass, state next two inputs and outputs
+      for (size_t k = 0; k < n; ++k) {
+        s0[k] = s1[k] = s2[k] = s3[k] = zero();
+      }
+      for (size_t y = job->height; y-- > 0;) {
+        const cl_uchar4 *row = in + y * width;
+        cl_uchar4 *dst = out + y * width;
+        for (size_t k = 0; k < n; ++k) {
+          Pixel xc = load(row[k]);
+          Pixel yc = c.antiCausal(s0[k], s1[k], s2[k], s3[k]);
+          s1[k] = s0[k];
+          s0[k] = xc;
+          s3[k] = s2[k];
+          s2[k] = yc;
+          store(dst[k], add(load(dst[k]), yc));
+        }
+      }
+    }
+  }
+
+  /**
+   * filterRows
+   * Filters R rows along x, in place; src holds a copy of each row
+   */
+  template <int R>
+  static void filterRows(cl_uchar4 *const *rows, const cl_uchar4 *const *src,
+                         size_t width, const Coefficients &c) {
+    Pixel xp[R], yp[R], yb[R], xa[R];
+    for (int r = 0; r < R; ++r) {
+      xp[r] = yp[r] = yb[r] = zero();
+    }
+    for (size_t x = 0; x < width; ++x) {
+      for (int r = 0; r < R; ++r) {
+        Pixel xc = load(src[r][x]);
+        Pixel yc = c.causal(xc, xp[r], yp[r], yb[r]);
+        store(rows[r][x], yc);
+        xp[r] = xc;
+        yb[r] = yp[r];
+        yp[r] = yc;
+      }
+    }
+
+    // Same state reused as xn, yn and ya
+    for (int r = 0; r < R; ++r) {
+      xp[r] = xa[r] = yp[r] = yb[r] = zero();
+    }
+    for (size_t x = width; x-- > 0;) {
+      for (int r = 0; r < R; ++r) {
+        Pixel xc = load(src[r][x]);
+        Pixel yc = c.antiCausal(xp[r], xa[r], yp[r], yb[r]);
+        xa[r] = xp[r];
+        xp[r] = xc;
+        yb[r] = yp[r];
+        yp[r] = yc;
+        store(rows[r][x], add(load(rows[r][x]), yc));
+      }
+    }
+  }
+
+  /**
+   * horizontalRows
+   * Filters the rows of tasks [begin, end) of output in place
+   */
+  static void horizontalRows(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    const Coefficients c(job);
+    const size_t width = job->width;
+    std::vector<cl_uchar4> copy(width * RG_CPU_ROWS);
+    cl_uchar4 *rows[RG_CPU_ROWS];
+    const cl_uchar4 *src[RG_CPU_ROWS];
+
+    for (size_t t = begin; t < end; ++t) {
+      size_t y0 = t * RG_CPU_TASK_ROWS;
+      size_t y1 = y0 + RG_CPU_TASK_ROWS < job->height ? y0 + RG_CPU_TASK_ROWS
+                                                       : job->height;
+      for (size_t y = y0; y < y1; y += RG_CPU_ROWS) {
+        int n = y1 - y < RG_CPU_ROWS ? (int)(y1 - y) : RG_CPU_ROWS;
+        for (int r = 0; r < n; ++r) {
+          rows[r] = job->output + (y + r) * width;
+          src[r] = &copy[r * width];
+          std::copy(rows[r], rows[r] + width, &copy[r * width]);
+        }
+        if (n == RG_CPU_ROWS) {
+          filterRows<RG_CPU_ROWS>(rows, src, width, c);
+        } else {
+          for (int r = 0; r < n; ++r) {
+            filterRows<1>(rows + r, src + r, width, c);
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif  // RECURSIVEGAUSSIANCPU_H_
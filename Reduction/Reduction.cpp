@@ -85,7 +85,7 @@ int Reduction::setupCL() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -93,10 +93,10 @@ int Reduction::setupCL() {
                       sampleArgs->isDeviceIdEnabled());
   CHECK_ERROR(status, SDK_SUCCESS, "getDevices() failed");
 
-  // Create command queue
-
+  // Create command queue, profiled to time the kernel apart from transfers
   commandQueue =
-      clCreateCommandQueue(context, devices[sampleArgs->deviceId], 0, &status);
+      clCreateCommandQueue(context, devices[sampleArgs->deviceId],
+                           CL_QUEUE_PROFILING_ENABLE, &status);
   CHECK_OPENCL_ERROR(status, "clCreateCommandQueue failed.");
 
   // Set device info of given cl_device_id
@@ -236,8 +236,21 @@ int Reduction::runCLKernels() {
   status = clFlush(commandQueue);
   CHECK_OPENCL_ERROR(status, "clFlush failed.");
 
-  status = waitForEventAndRelease(&ndrEvent);
-  CHECK_ERROR(status, SDK_SUCCESS, "WaitForEventAndRelease(ndrEvt) Failed");
+  status = clWaitForEvents(1, &ndrEvent);
+  CHECK_OPENCL_ERROR(status, "clWaitForEvents failed.(ndrEvent)");
+
+  // accumulate NDRange time
+  cl_ulong startTime, endTime;
+  status = clGetEventProfilingInfo(ndrEvent, CL_PROFILING_COMMAND_START,
+                                   sizeof(cl_ulong), &startTime, NULL);
+  CHECK_OPENCL_ERROR(status, "clGetEventProfilingInfo failed.(startTime)");
+  status = clGetEventProfilingInfo(ndrEvent, CL_PROFILING_COMMAND_END,
+                                   sizeof(cl_ulong), &endTime, NULL);
+  CHECK_OPENCL_ERROR(status, "clGetEventProfilingInfo failed.(endTime)");
+  ndrangeTime += (cl_double)(endTime - startTime);
+
+  status = clReleaseEvent(ndrEvent);
+  CHECK_OPENCL_ERROR(status, "clReleaseEvent failed.(ndrEvent)");
 
   cl_event outMapEvt;
   cl_uint* outMapPtr = (cl_uint*)clEnqueueMapBuffer(
@@ -251,7 +264,7 @@ int Reduction::runCLKernels() {
   status = waitForEventAndRelease(&outMapEvt);
   CHECK_ERROR(status, SDK_SUCCESS, "WaitForEventAndRelease(outMapEvt) Failed");
 
-  // Add individual sum of blocks
+  // Add individual sum of blocks, widened so long inputs do not wrap
   output = 0;
   for (int i = 0; i < numBlocks * VECTOR_SIZE; ++i) {
     output += outMapPtr[i];
@@ -274,14 +287,19 @@ int Reduction::runCLKernels() {
 }
 
 /*
- * Reduces the input array (in place)
+ * Reduces the input array
  * length specifies the length of the array
  */
 void Reduction::reductionCPUReference(cl_uint* input, const cl_uint length,
-                                      cl_uint& output) {
-  for (cl_uint i = 0; i < length; ++i) {
-    output += input[i];
-  }
+                                      cl_ulong& output) {
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
+
+  output = parallelReduce(input, length, ReduceSum<cl_uint, cl_ulong>());
+
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 }
 
 int Reduction::initialize() {
@@ -383,21 +401,25 @@ int Reduction::run() {
   int timer = sampleTimer->createTimer();
   sampleTimer->resetTimer(timer);
   sampleTimer->startTimer(timer);
+  ndrangeTime = 0;
 
   // Run the kernel for a number of iterations
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
   // Compute total time
   kernelTime = (double)(sampleTimer->readTimer(timer)) / iterations;
+  ndrangeTime /= iterations;
 
   if (!sampleArgs->quiet) {
-    printArray<cl_uint>("Output", &output, 1, 1);
+    printArray<cl_ulong>("Output", &output, 1, 1);
   }
 
   return SDK_SUCCESS;
@@ -405,10 +427,7 @@ int Reduction::run() {
 
 int Reduction::verifyResults() {
   if (sampleArgs->verify) {
-    /**
-     * reference implementation
-     * it overwrites the input array with the output
-     */
+    // reference implementation
     reductionCPUReference(input, length * VECTOR_SIZE, refOutput);
 
     // compare the results and see if they match
@@ -426,16 +445,25 @@ int Reduction::verifyResults() {
 
 void Reduction::printStats() {
   if (sampleArgs->timing) {
-    std::string strArray[3] = {"Elements", "Time(sec)",
-                               "(DataTransfer + Kernel)Time(sec)"};
-    std::string stats[3];
+    std::string strArray[4] = {"Elements",
+                               "Time(sec)",
+                               "(DataTransfer + Kernel)Time(sec)",
+                               "Kernel Speed(GB/s)"};
+    std::string stats[4];
+
+    // bytes per nanosecond is GB/s
+    double bytes = (double)length * sizeof(cl_uint4);
 
     sampleTimer->totalTime = setupTime + kernelTime;
     stats[0] = toString(length * VECTOR_SIZE, std::dec);
     stats[1] = toString(sampleTimer->totalTime, std::dec);
     stats[2] = toString(kernelTime, std::dec);
+    stats[3] = toString(bytes / ndrangeTime, std::dec);
+
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Speed(GB/s)",
+                            bytes / 1e9);
 
-    printStatistics(strArray, stats, 3);
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -499,7 +527,7 @@ int main(int argc, char* argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clReduction.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clReduction.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
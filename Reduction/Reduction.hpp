@@ -36,6 +36,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "SDKReduce.hpp"
 
 #include <malloc.h>
 
@@ -57,6 +58,8 @@ class Reduction {
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;   /**< time taken by the host reference reduction */
+  cl_double ndrangeTime; /**< profiled time of the reduce kernel alone, in ns */
 
   size_t globalThreads[1]; /**< Global NDRange for the kernel */
   size_t localThreads[1];  /**< Local WorkGroup for kernel */
@@ -65,8 +68,8 @@ class Reduction {
   int numBlocks;                 /**< Number of groups */
   cl_uint *input;                /**< Input array */
   cl_uint *outputPtr;            /**< Output array */
-  cl_uint output;                /**< Output result */
-  cl_uint refOutput;             /**< Reference result */
+  cl_ulong output;               /**< Output result */
+  cl_ulong refOutput;            /**< Reference result */
   cl_context context;            /**< CL context */
   cl_device_id *devices;         /**< CL device list */
   cl_mem inputBuffer;            /**< CL memory buffer */
@@ -95,6 +98,8 @@ class Reduction {
     length = 64;
     groupSize = GROUP_SIZE;
     iterations = 1;
+    hostTime = 0;
+    ndrangeTime = 0;
   }
 
   ~Reduction();
@@ -130,13 +135,13 @@ class Reduction {
 
   /**
    * Reference CPU implementation of Reduction
-   * for performance comparison
+   * for performance comparison, summed into 64 bits on the thread pool
    * @param input the input array
    * @param length length of the array
    * @param output value
    */
   void reductionCPUReference(cl_uint *input, const cl_uint length,
-                             cl_uint &output);
+                             cl_ulong &output);
 
   /**
    * Override from SDKSample. Print sample stats.
@@ -139,7 +139,7 @@ int ScanLargeArrays::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   status = getDevices(context, &devices, sampleArgs->deviceId,
@@ -448,16 +448,23 @@ int ScanLargeArrays::runCLKernels(void) {
 }
 
 /*
-* Naive implementation of Scan
+* Exclusive scan on the host thread pool
 */
 void ScanLargeArrays::scanLargeArraysCPUReference(cl_float *output,
                                                   cl_float *input,
                                                   const cl_uint length) {
-  output[0] = 0;
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
 
-  for (cl_uint i = 1; i < length; ++i) {
-    output[i] = input[i - 1] + output[i - 1];
+  if (kahan) {
+    parallelScanKahan(output, input, length, false);
+  } else {
+    parallelScan(output, input, length, false);
   }
+
+  sampleTimer->stopTimer(timer);
+  hostTime = sampleTimer->readTimer(timer);
 }
 
 int ScanLargeArrays::initialize() {
@@ -490,6 +497,19 @@ int ScanLargeArrays::initialize() {
   sampleArgs->AddOption(iteration_option);
   delete iteration_option;
 
+  Option *kahan_option = new Option;
+  CHECK_ALLOCATION(kahan_option, "Memory Allocation error.(kahan_option)");
+
+  kahan_option->_sVersion = "";
+  kahan_option->_lVersion = "kahan";
+  kahan_option->_description =
+      "Use compensated (Kahan) summation in the host reference scan";
+  kahan_option->_type = CA_NO_ARGUMENT;
+  kahan_option->_value = &kahan;
+
+  sampleArgs->AddOption(kahan_option);
+  delete kahan_option;
+
   return SDK_SUCCESS;
 }
 
@@ -546,9 +566,11 @@ int ScanLargeArrays::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -631,7 +653,10 @@ void ScanLargeArrays::printStats() {
     stats[2] = toString(avgTime, std::dec);
     stats[3] = toString((length / avgTime), std::dec);
 
-    printStatistics(strArray, stats, 4);
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Elements/sec",
+                            length);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -708,7 +733,7 @@ int main(int argc, char *argv[]) {
   }
 
   // VerifyResults
-  if (clScanLargeArrays.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clScanLargeArrays.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
@@ -32,6 +32,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "SDKScan.hpp"
 
 #ifndef max
 #define max(a, b) (((a) > (b)) ? (a) : (b))
@@ -56,6 +57,8 @@ class ScanLargeArrays {
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
   cl_double kernelTime; /**< time taken to run kernel and read result back */
+  cl_double hostTime;   /**< time taken by the host reference scan */
+  bool kahan;           /**< use the compensated host reference scan */
   cl_float *input;      /**< Input array */
   cl_float *output;     /**< Output Array */
   cl_float *
@@ -101,6 +104,8 @@ class ScanLargeArrays {
     length = 32768;
     kernelTime = 0;
     setupTime = 0;
+    hostTime = 0;
+    kahan = false;
     iterations = 1;
   }
 
@@ -167,7 +172,8 @@ class ScanLargeArrays {
   int bAddition(cl_uint len, cl_mem *inputBuffer, cl_mem *outputBuffer);
 
   /**
-  * Reference CPU implementation of Prefix Sum
+  * Reference CPU implementation of Prefix Sum (exclusive), run by the
+  * parallel host scan from SDKScan.hpp, compensated when --kahan is given
   * @param output the array that stores the prefix sum
   * @param input the input array
   * @param length length of the input array
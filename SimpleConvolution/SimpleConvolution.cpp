@@ -50,21 +50,41 @@ int SimpleConvolution::setupSimpleConvolution() {
   // random initialisation of input
   fillRandom<cl_uint>(input, width, height, 0, 255);
 
-  // Fill a blurr filter or some other filter of your choice
-  for (cl_uint i = 0; i < maskWidth * maskHeight; i++) {
-    mask[i] = 0;
-  }
+  if (separable) {
+    // A tent blur, the product of two triangular 1D filters
+    std::vector<cl_float> maskRow(maskWidth), maskColumn(maskHeight);
+    cl_float rowSum = (cl_float)((maskWidth + 1) / 2 * ((maskWidth + 1) / 2));
+    for (cl_uint i = 0; i < maskWidth; i++) {
+      maskRow[i] = (std::min(i, maskWidth - 1 - i) + 1) / rowSum;
+    }
+    cl_float columnSum =
+        (cl_float)((maskHeight + 1) / 2 * ((maskHeight + 1) / 2));
+    for (cl_uint j = 0; j < maskHeight; j++) {
+      maskColumn[j] = (std::min(j, maskHeight - 1 - j) + 1) / columnSum;
+    }
+
+    for (cl_uint j = 0; j < maskHeight; j++) {
+      for (cl_uint i = 0; i < maskWidth; i++) {
+        mask[j * maskWidth + i] = maskColumn[j] * maskRow[i];
+      }
+    }
+  } else {
+    // Fill a blurr filter or some other filter of your choice
+    for (cl_uint i = 0; i < maskWidth * maskHeight; i++) {
+      mask[i] = 0;
+    }
 
-  cl_float val = 1.0f / (maskWidth * 2.0f - 1.0f);
+    cl_float val = 1.0f / (maskWidth * 2.0f - 1.0f);
 
-  for (cl_uint i = 0; i < maskWidth; i++) {
-    cl_uint y = maskHeight / 2;
-    mask[y * maskWidth + i] = val;
-  }
+    for (cl_uint i = 0; i < maskWidth; i++) {
+      cl_uint y = maskHeight / 2;
+      mask[y * maskWidth + i] = val;
+    }
 
-  for (cl_uint i = 0; i < maskHeight; i++) {
-    cl_uint x = maskWidth / 2;
-    mask[i * maskWidth + x] = val;
+    for (cl_uint i = 0; i < maskHeight; i++) {
+      cl_uint x = maskWidth / 2;
+      mask[i * maskWidth + x] = val;
+    }
   }
 
   // Unless quiet mode has been enabled, print the INPUT array.
@@ -122,7 +142,7 @@ int SimpleConvolution::setupCL(void) {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
 
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
@@ -263,42 +283,8 @@ void SimpleConvolution::simpleConvolutionCPUReference(
     cl_uint *output, const cl_uint *input, const cl_float *mask,
     const cl_uint width, const cl_uint height, const cl_uint maskWidth,
     const cl_uint maskHeight) {
-  cl_uint vstep = (maskWidth - 1) / 2;
-  cl_uint hstep = (maskHeight - 1) / 2;
-
-  // for each pixel in the input
-  for (cl_uint x = 0; x < width; x++)
-    for (cl_uint y = 0; y < height; y++) {
-      /*
-       * find the left, right, top and bottom indices such that
-       * the indices do not go beyond image boundaires
-       */
-      cl_uint left = (x < vstep) ? 0 : (x - vstep);
-      cl_uint right = ((x + vstep) >= width) ? width - 1 : (x + vstep);
-      cl_uint top = (y < hstep) ? 0 : (y - hstep);
-      cl_uint bottom = ((y + hstep) >= height) ? height - 1 : (y + hstep);
-
-      /*
-       * initializing wighted sum value
-       */
-      cl_float sumFX = 0;
-
-      for (cl_uint i = left; i <= right; ++i)
-        for (cl_uint j = top; j <= bottom; ++j) {
-          /*
-           * performing wighted sum within the mask boundaries
-           */
-          cl_uint maskIndex = (j - (y - hstep)) * maskWidth + (i - (x - vstep));
-          cl_uint index = j * width + i;
-
-          /*
-           * to round to the nearest integer
-           */
-          sumFX += ((float)input[index] * mask[maskIndex]);
-        }
-      sumFX += 0.5f;
-      output[y * width + x] = cl_uint(sumFX);
-    }
+  SimpleConvolutionCPU::convolve(output, input, mask, width, height,
+                                 maskWidth, maskHeight);
 }
 
 int SimpleConvolution::initialize() {
@@ -344,6 +330,20 @@ int SimpleConvolution::initialize() {
   sampleArgs->AddOption(mask_width);
   delete mask_width;
 
+  Option *separable_option = new Option;
+  CHECK_ALLOCATION(separable_option, "Memory allocation error.\n");
+
+  separable_option->_sVersion = "";
+  separable_option->_lVersion = "separable";
+  separable_option->_description =
+      "Use a separable (tent) mask instead of the cross, which the host "
+      "also runs as two 1D passes";
+  separable_option->_type = CA_NO_ARGUMENT;
+  separable_option->_value = &separable;
+
+  sampleArgs->AddOption(separable_option);
+  delete separable_option;
+
   Option *num_iterations = new Option;
   CHECK_ALLOCATION(num_iterations, "Memory allocation error.\n");
 
@@ -406,9 +406,11 @@ int SimpleConvolution::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Arguments are set and execution call is enqueued on command buffer
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -433,8 +435,28 @@ int SimpleConvolution::verifyResults() {
     cl_uint2 inputDimensions = {width, height};
     cl_uint2 maskDimensions = {maskWidth, maskHeight};
 
+    int timer = sampleTimer->createTimer();
+    sampleTimer->resetTimer(timer);
+    sampleTimer->startTimer(timer);
     simpleConvolutionCPUReference(verificationOutput, input, mask, width,
                                   height, maskWidth, maskHeight);
+    sampleTimer->stopTimer(timer);
+    hostTime = sampleTimer->readTimer(timer);
+
+    // A rank-1 mask is also run as two 1D passes. That is only timed,
+    // its rounding is not the kernel's
+    std::vector<cl_float> row(maskWidth), column(maskHeight);
+    if (SimpleConvolutionCPU::factorize(mask, maskWidth, maskHeight, &row[0],
+                                        &column[0])) {
+      std::vector<cl_uint> separableOutput(width * height);
+      sampleTimer->resetTimer(timer);
+      sampleTimer->startTimer(timer);
+      SimpleConvolutionCPU::convolveSeparable(&separableOutput[0], input,
+                                              &row[0], &column[0], width,
+                                              height, maskWidth, maskHeight);
+      sampleTimer->stopTimer(timer);
+      hostSeparableTime = sampleTimer->readTimer(timer);
+    }
 
     // compare the results and see if they match
     if (memcmp(output, verificationOutput, height * width * sizeof(cl_uint)) ==
@@ -452,9 +474,9 @@ int SimpleConvolution::verifyResults() {
 
 void SimpleConvolution::printStats() {
   if (sampleArgs->timing) {
-    std::string strArray[5] = {"Width", "Height", "mask Size", "Time(sec)",
-                               "KernelTime(sec)"};
-    std::string stats[5];
+    std::string strArray[6] = {"Width", "Height", "mask Size", "Time(sec)",
+                               "KernelTime(sec)", "Host separable time (sec)"};
+    std::string stats[6];
 
     sampleTimer->totalTime = setupTime + totalKernelTime;
 
@@ -463,8 +485,12 @@ void SimpleConvolution::printStats() {
     stats[2] = toString(maskWidth, std::dec);
     stats[3] = toString(sampleTimer->totalTime, std::dec);
     stats[4] = toString(totalKernelTime, std::dec);
+    stats[5] = toString(hostSeparableTime, std::dec);
+
+    printStatisticsWithHost(strArray, stats, hostSeparableTime > 0 ? 6 : 5,
+                            hostTime);
 
-    printStatistics(strArray, stats, 5);
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -527,7 +553,7 @@ int main(int argc, char *argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clSimpleConvolution.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clSimpleConvolution.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
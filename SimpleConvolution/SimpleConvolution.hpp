@@ -35,6 +35,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "SimpleConvolutionCPU.hpp"
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.2"
 
@@ -49,6 +50,8 @@ class SimpleConvolution {
   cl_uint seed;                /**< Seed value for random number generation */
   cl_double setupTime;         /**< Time for setting up OpenCL */
   cl_double totalKernelTime;   /**< Time for kernel execution */
+  cl_double hostTime;          /**< Time for the reference implementation */
+  cl_double hostSeparableTime; /**< Time for the separable host baseline */
   cl_int width;                /**< Width of the Input array */
   cl_int height;               /**< Height of the Input array */
   cl_uint *input;              /**< Input array */
@@ -56,6 +59,7 @@ class SimpleConvolution {
   cl_float *mask;              /**< mask array */
   cl_uint maskWidth;           /**< mask dimensions */
   cl_uint maskHeight;          /**< mask dimensions */
+  bool separable;              /**< use a separable mask */
   cl_uint *verificationOutput; /**< Output array for reference implementation */
   cl_context context;          /**< CL context */
   cl_device_id *devices;       /**< CL device list */
@@ -88,11 +92,14 @@ class SimpleConvolution {
     input = NULL;
     output = NULL;
     mask = NULL;
+    separable = false;
     verificationOutput = NULL;
     width = 64;
     height = 64;
     setupTime = 0;
     totalKernelTime = 0;
+    hostTime = 0;
+    hostSeparableTime = 0;
     iterations = 1;
   }
 
@@ -127,7 +134,7 @@ class SimpleConvolution {
 
   /**
    * Reference CPU implementation of Simple Convolution
-   * for performance comparison
+   * for performance comparison, see SimpleConvolutionCPU.hpp
    * @param output Output matrix after performing convolution
    * @param input  Input  matrix on which convolution is to be performed
    * @param mask   mask matrix using which convolution was to be performed
@@ -0,0 +1,366 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef SIMPLECONVOLUTIONCPU_H_
+#define SIMPLECONVOLUTIONCPU_H_
+
+#include <CL/cl.h>
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <algorithm>
+#include <vector>
+#include "SDKThread.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host convolution used to verify SimpleConvolution.
+ *
+ * The image is cut into bands of SIMPLECONV_CPU_BAND output rows that are
+ * spread over SDKThreadPool. A band first fills a float scratch with the
+ * input rows it reads, then runs the mask over the scratch in
+ * SIMPLECONV_CPU_TILE wide column tiles, so the mask's rows of a tile stay
+ * in L1 while the tile is walked down. Only the nonzero taps of the mask
+ * are visited. Interior pixels are computed eight at a time with SSE2;
+ * pixels whose window leaves the image take the scalar path, which skips
+ * the taps that fall outside like the kernel does.
+ *
+ * convolve() applies the mask with its taps in the kernel's order, so
+ * results are bit exact with the kernel; it is the one to verify with.
+ * factorize() detects a rank-1 mask, column * row, and convolveSeparable()
+ * applies such a mask as two 1D passes: the row while filling the scratch
+ * and the column over it, mask width + height taps per pixel instead of
+ * their product. This reorders the sums, so a rounded pixel may differ
+ * from the kernel's by one. It only serves as a timed baseline.
+ *
+ * Input values are converted like (float)input, which SSE2 matches for
+ * values below 2^31.
+ */
+#define SIMPLECONV_CPU_BAND 16  /**< output rows per band */
+#define SIMPLECONV_CPU_TILE 256 /**< columns per cache tile */
+#define SIMPLECONV_CPU_RANK1_TOLERANCE (4 * FLT_EPSILON) /**< relative */
+
+/**
+ * SimpleConvolutionCPU
+ * Convolution of a cl_uint image with a float mask. Like the kernel the
+ * result is rounded to the nearest cl_uint and taps outside the image
+ * are left out.
+ */
+class SimpleConvolutionCPU {
+ public:
+  /**
+   * factorize
+   * Tests whether mask is separable, mask[j][i] == column[j] * row[i] up
+   * to rounding of the factors
+   * @param mask maskWidth x maskHeight mask
+   * @param maskWidth width of the mask
+   * @param maskHeight height of the mask
+   * @param row maskWidth entries, receives the row factor
+   * @param column maskHeight entries, receives the column factor
+   * @return true if every tap is within SIMPLECONV_CPU_RANK1_TOLERANCE of
+   * itself from column * row
+   */
+  static bool factorize(const cl_float *mask, cl_uint maskWidth,
+                        cl_uint maskHeight, cl_float *row, cl_float *column) {
+    cl_uint pivotX = 0, pivotY = 0;
+    cl_float largest = 0.0f;
+    for (cl_uint j = 0; j < maskHeight; ++j) {
+      for (cl_uint i = 0; i < maskWidth; ++i) {
+        if (fabsf(mask[j * maskWidth + i]) > largest) {
+          largest = fabsf(mask[j * maskWidth + i]);
+          pivotX = i;
+          pivotY = j;
+        }
+      }
+    }
+    if (largest == 0.0f) {
+      return false;
+    }
+
+    cl_float pivot = mask[pivotY * maskWidth + pivotX];
+    for (cl_uint i = 0; i < maskWidth; ++i) {
+      row[i] = mask[pivotY * maskWidth + i];
+    }
+    for (cl_uint j = 0; j < maskHeight; ++j) {
+      column[j] = mask[j * maskWidth + pivotX] / pivot;
+    }
+
+    // Each tap, small ones included, has to match to a few roundings
+    for (cl_uint j = 0; j < maskHeight; ++j) {
+      for (cl_uint i = 0; i < maskWidth; ++i) {
+        cl_float tap = mask[j * maskWidth + i];
+        if (fabsf(tap - column[j] * row[i]) >
+            SIMPLECONV_CPU_RANK1_TOLERANCE * fabsf(tap)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * convolve
+   * @param output width x height result
+   * @param input width x height image
+   * @param mask maskWidth x maskHeight mask
+   * @param width width of the image
+   * @param height height of the image
+   * @param maskWidth width of the mask
+   * @param maskHeight height of the mask
+   */
+  static void convolve(cl_uint *output, const cl_uint *input,
+                       const cl_float *mask, cl_uint width, cl_uint height,
+                       cl_uint maskWidth, cl_uint maskHeight) {
+    // The kernel's window, which for an even mask leaves out its last
+    // row and column
+    cl_int vstep = (cl_int)(maskWidth - 1) / 2;
+    cl_int hstep = (cl_int)(maskHeight - 1) / 2;
+
+    Job job(output, input, width, height, vstep, hstep);
+    addTap(job.fillTaps, 0, 0, 1.0f);
+    for (cl_int i = 0; i <= 2 * vstep; ++i) {
+      for (cl_int j = 0; j <= 2 * hstep; ++j) {
+        addTap(job.taps, i - vstep, j - hstep, mask[j * maskWidth + i]);
+      }
+    }
+    run(job);
+  }
+
+  /**
+   * convolveSeparable
+   * Convolution with the mask column[j] * row[i], as found by factorize,
+   * as a row pass and a column pass. Not bit exact with the kernel, see
+   * above.
+   * @param output width x height result
+   * @param input width x height image
+   * @param row maskWidth entries, the row factor of the mask
+   * @param column maskHeight entries, the column factor of the mask
+   * @param width width of the image
+   * @param height height of the image
+   * @param maskWidth width of the mask
+   * @param maskHeight height of the mask
+   */
+  static void convolveSeparable(cl_uint *output, const cl_uint *input,
+                                const cl_float *row, const cl_float *column,
+                                cl_uint width, cl_uint height,
+                                cl_uint maskWidth, cl_uint maskHeight) {
+    cl_int vstep = (cl_int)(maskWidth - 1) / 2;
+    cl_int hstep = (cl_int)(maskHeight - 1) / 2;
+
+    Job job(output, input, width, height, 0, hstep);
+    job.fillReachX = vstep;
+    for (cl_int i = 0; i <= 2 * vstep; ++i) {
+      addTap(job.fillTaps, i - vstep, 0, row[i]);
+    }
+    for (cl_int j = 0; j <= 2 * hstep; ++j) {
+      addTap(job.taps, 0, j - hstep, column[j]);
+    }
+    run(job);
+  }
+
+ private:
+  /**
+   * Tap
+   * A nonzero weight of the mask, relative to the output pixel
+   */
+  struct Tap {
+    cl_int dx;       /**< column offset */
+    cl_int dy;       /**< row offset */
+    cl_float weight; /**< weight */
+  };
+
+  /**
+   * Job
+   * The two passes shared by all bands
+   */
+  struct Job {
+    cl_uint *output;            /**< result */
+    const cl_uint *input;       /**< image */
+    cl_uint width;              /**< width of the image */
+    cl_uint height;             /**< height of the image */
+    std::vector<Tap> fillTaps;  /**< row pass into the scratch */
+    std::vector<Tap> taps;      /**< pass over the scratch */
+    cl_int fillReachX;          /**< largest |dx| of fillTaps */
+    cl_int reachX;              /**< largest |dx| of taps */
+    cl_int reachY;              /**< largest |dy| of taps */
+
+    Job(cl_uint *out, const cl_uint *in, cl_uint w, cl_uint h, cl_int rx,
+        cl_int ry)
+        : output(out), input(in), width(w), height(h), fillReachX(0),
+          reachX(rx), reachY(ry) {}
+  };
+
+  /**
+   * run
+   * Runs both passes of job over all bands
+   */
+  static void run(Job &job) {
+    size_t bands =
+        (job.height + SIMPLECONV_CPU_BAND - 1) / SIMPLECONV_CPU_BAND;
+    SDKThreadPool::instance().parallelFor(0, bands, 0, convolveBands, &job);
+  }
+
+  static void addTap(std::vector<Tap> &taps, cl_int dx, cl_int dy,
+                     cl_float weight) {
+    if (weight != 0.0f) {
+      Tap tap = {dx, dy, weight};
+      taps.push_back(tap);
+    }
+  }
+
+  static cl_float load(const cl_uint *p) { return (cl_float)*p; }
+  static cl_float load(const cl_float *p) { return *p; }
+  static void store(cl_float *p, cl_float sum) { *p = sum; }
+  static void store(cl_uint *p, cl_float sum) { *p = cl_uint(sum + 0.5f); }
+
+#ifdef __SSE2__
+  static __m128 load4(const cl_uint *p) {
+    return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)p));
+  }
+  static __m128 load4(const cl_float *p) { return _mm_loadu_ps(p); }
+  static void store4(cl_float *p, __m128 sum) { _mm_storeu_ps(p, sum); }
+  static void store4(cl_uint *p, __m128 sum) {
+    __m128i rounded = _mm_cvttps_epi32(_mm_add_ps(sum, _mm_set1_ps(0.5f)));
+    _mm_storeu_si128((__m128i *)p, rounded);
+  }
+#endif
+
+  /**
+   * pixel
+   * Output pixel (x, y), leaving out the taps outside the image
+   * @param center source element under the pixel
+   */
+  template <class Src, class Dst>
+  static void pixel(Dst *out, const Src *center, cl_int x, cl_int y,
+                    cl_int width, cl_int height, const Tap *taps,
+                    const ptrdiff_t *offsets, size_t numTaps) {
+    cl_float sum = 0;
+    for (size_t t = 0; t < numTaps; ++t) {
+      cl_int sx = x + taps[t].dx;
+      cl_int sy = y + taps[t].dy;
+      if (sx >= 0 && sx < width && sy >= 0 && sy < height) {
+        sum += load(center + offsets[t]) * taps[t].weight;
+      }
+    }
+    store(out, sum);
+  }
+
+  /**
+   * applyTaps
+   * dst rows [y0, y1) from src, where src holds image rows from srcRow0
+   * and dst image rows from dstRow0 on, both width wide
+   */
+  template <class Src, class Dst>
+  static void applyTaps(Dst *dst, cl_uint dstRow0, const Src *src,
+                        cl_uint srcRow0, cl_uint width, cl_uint height,
+                        cl_uint y0, cl_uint y1,
+                        const std::vector<Tap> &tapList, cl_int reachX,
+                        cl_int reachY) {
+    const Tap *taps = tapList.empty() ? NULL : &tapList[0];
+    size_t numTaps = tapList.size();
+    std::vector<ptrdiff_t> offsetList(numTaps + 1);
+    for (size_t t = 0; t < numTaps; ++t) {
+      offsetList[t] = (ptrdiff_t)taps[t].dy * width + taps[t].dx;
+    }
+    const ptrdiff_t *offsets = &offsetList[0];
+
+    const cl_int w = (cl_int)width, h = (cl_int)height;
+    for (cl_uint x0 = 0; x0 < width; x0 += SIMPLECONV_CPU_TILE) {
+      cl_int x1 = std::min(x0 + SIMPLECONV_CPU_TILE, width);
+      for (cl_int y = y0; y < (cl_int)y1; ++y) {
+        const Src *srcRow = src + (size_t)(y - srcRow0) * width;
+        Dst *dstRow = dst + (size_t)(y - dstRow0) * width;
+
+        // Columns [lo, hi) have their whole window inside the image
+        cl_int lo = x1, hi = x1;
+        if (y >= reachY && y + reachY < h) {
+          lo = std::max((cl_int)x0, reachX);
+          hi = std::max(lo, std::min(x1, w - reachX));
+        }
+
+        cl_int x = x0;
+        for (; x < lo; ++x) {
+          pixel(dstRow + x, srcRow + x, x, y, w, h, taps, offsets, numTaps);
+        }
+#ifdef __SSE2__
+        for (; x + 8 <= hi; x += 8) {
+          const Src *center = srcRow + x;
+          __m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+          for (size_t t = 0; t < numTaps; ++t) {
+            __m128 weight = _mm_set1_ps(taps[t].weight);
+            sum0 = _mm_add_ps(sum0, _mm_mul_ps(load4(center + offsets[t]),
+                                               weight));
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(load4(center + offsets[t] + 4),
+                                               weight));
+          }
+          store4(dstRow + x, sum0);
+          store4(dstRow + x + 4, sum1);
+        }
+#endif
+        for (; x < hi; ++x) {
+          const Src *center = srcRow + x;
+          cl_float sum = 0;
+          for (size_t t = 0; t < numTaps; ++t) {
+            sum += load(center + offsets[t]) * taps[t].weight;
+          }
+          store(dstRow + x, sum);
+        }
+        for (; x < x1; ++x) {
+          pixel(dstRow + x, srcRow + x, x, y, w, h, taps, offsets, numTaps);
+        }
+      }
+    }
+  }
+
+  /**
+   * convolveBands
+   * Bands [bandBegin, bandEnd), through one scratch
+   */
+  static void convolveBands(size_t bandBegin, size_t bandEnd, void *arg) {
+    const Job *job = (const Job *)arg;
+    const cl_uint height = job->height;
+    std::vector<cl_float> scratch;
+    for (size_t band = bandBegin; band < bandEnd; ++band) {
+      cl_uint y0 = (cl_uint)band * SIMPLECONV_CPU_BAND;
+      cl_uint y1 = std::min(y0 + SIMPLECONV_CPU_BAND, height);
+      cl_uint r0 = (y0 > (cl_uint)job->reachY) ? y0 - job->reachY : 0;
+      cl_uint r1 = std::min(y1 + job->reachY, height);
+      scratch.resize((size_t)(r1 - r0) * job->width);
+
+      applyTaps(&scratch[0], r0, job->input, 0, job->width, height, r0, r1,
+                job->fillTaps, job->fillReachX, 0);
+      applyTaps(job->output, 0, &scratch[0], r0, job->width, height, y0, y1,
+                job->taps, job->reachX, job->reachY);
+    }
+  }
+};
+
+#endif
@@ -134,7 +134,7 @@ int SobelFilter::setupCL() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -346,9 +346,11 @@ int SobelFilter::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Set kernel arguments and run kernel
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -511,6 +513,8 @@ void SobelFilter::printStats() {
     stats[3] = toString(kernelTime, std::dec);
 
     printStatistics(strArray, stats, 4);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -539,7 +543,7 @@ int main(int argc, char *argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clSobelFilter.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clSobelFilter.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
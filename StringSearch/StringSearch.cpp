@@ -27,7 +27,6 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <algorithm>
 #include "StringSearch.hpp"
-#include "limits.h"
 
 int StringSearch::initialize() {
   // Call base class Initialize to get default configuration
@@ -83,6 +82,34 @@ int StringSearch::initialize() {
   sampleArgs->AddOption(case_option);
   delete case_option;
 
+  Option* window_option = new Option;
+  CHECK_ALLOCATION(window_option, "Memory allocation error.\n");
+
+  window_option->_sVersion = "w";
+  window_option->_lVersion = "window";
+  window_option->_description =
+      "Bytes searched per pass in MB, the file is streamed through windows "
+      "of this size (default 64)";
+  window_option->_type = CA_ARG_INT;
+  window_option->_value = &windowSize;
+
+  sampleArgs->AddOption(window_option);
+  delete window_option;
+
+  Option* patterns_option = new Option;
+  CHECK_ALLOCATION(patterns_option, "Memory allocation error.\n");
+
+  patterns_option->_sVersion = "";
+  patterns_option->_lVersion = "patterns";
+  patterns_option->_description =
+      "File of extra patterns, one per line, searched by the host reference "
+      "together with the sub string";
+  patterns_option->_type = CA_ARG_STRING;
+  patterns_option->_value = &patternFile;
+
+  sampleArgs->AddOption(patterns_option);
+  delete patterns_option;
+
   return SDK_SUCCESS;
 }
 
@@ -106,39 +133,49 @@ int StringSearch::setupStringSearch() {
     return SDK_FAILURE;
   }
 
-  // Read the content of the file
-  std::ifstream textFile(file.c_str(),
-                         std::ios::in | std::ios::binary | std::ios::ate);
-  if (!textFile.is_open()) {
+  // Map the file, it is read window by window while searching
+  if (!input.open(file)) {
     std::cout << "\n Unable to open file: " << file << std::endl;
     return SDK_FAILURE;
   }
-
-  textLength = (cl_uint)(textFile.tellg());
-  text = (cl_uchar*)malloc(textLength + 1);
-  memset(text, 0, textLength + 1);
-  CHECK_ALLOCATION(text, "Failed to allocate memory! (text)");
-  textFile.seekg(0, std::ios::beg);
-  if (!textFile.read((char*)text, textLength)) {
-    std::cout << "\n Reading file failed " << std::endl;
-    textFile.close();
-    return SDK_FAILURE;
-  }
-  textFile.close();
+  fileLength = input.size();
 
   if (subStr.length() == 0) {
     std::cout << "\nError: Sub-String not specified..." << std::endl;
     return SDK_FAILURE;
   }
 
-  if (textLength < subStr.length()) {
-    std::cout << "\nText size less than search pattern (" << textLength << " < "
+  if (fileLength < subStr.length()) {
+    std::cout << "\nText size less than search pattern (" << fileLength << " < "
               << subStr.length() << ")" << std::endl;
     return SDK_FAILURE;
   }
 
+  // The device searches for subStr, the host for all patterns
+  patterns.assign(1, subStr);
+  if (patternFile.length() != 0) {
+    std::ifstream extra(patternFile.c_str());
+    if (!extra.is_open()) {
+      std::cout << "\n Unable to open file: " << patternFile << std::endl;
+      return SDK_FAILURE;
+    }
+    std::string line;
+    while (std::getline(extra, line)) {
+      if (line.length() != 0 && line[line.length() - 1] == '\r') {
+        line.erase(line.length() - 1);
+      }
+      if (line.length() != 0) {
+        patterns.push_back(line);
+      }
+    }
+  }
+  hostEngine.setPatterns(patterns, caseSensitive);
+
   if (!sampleArgs->quiet) {
     std::cout << "Search Pattern : " << subStr << std::endl;
+    if (patterns.size() > 1) {
+      std::cout << "Host Patterns : " << patterns.size() << std::endl;
+    }
   }
 
   return SDK_SUCCESS;
@@ -174,7 +211,7 @@ int StringSearch::setupCL() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType() failed.");
 
   status = getDevices(context, &devices, sampleArgs->deviceId,
@@ -190,15 +227,30 @@ int StringSearch::setupCL() {
       clCreateCommandQueue(context, devices[sampleArgs->deviceId], 0, &status);
   CHECK_OPENCL_ERROR(status, "clCreateCommandQueue failed.");
 
+  /*
+   * The text is searched in windows the device buffers can hold. Windows
+   * overlap by the pattern length - 1, so no match is split between two.
+   */
+  cl_ulong window = windowSize > 0 ? ((cl_ulong)windowSize << 20)
+                                   : (cl_ulong)SEARCH_WINDOW_BYTES;
+  window = std::min(window, deviceInfo.maxMemAllocSize / sizeof(cl_uint));
+  window = std::min(window, fileLength);
+  if (window < subStr.length()) {
+    std::cout << "\nSearch window less than search pattern (" << window
+              << " < " << subStr.length() << ")" << std::endl;
+    return SDK_FAILURE;
+  }
+  windowLength = (cl_uint)window;
+
   textBuf =
-      clCreateBuffer(context, CL_MEM_READ_ONLY, textLength, NULL, &status);
+      clCreateBuffer(context, CL_MEM_READ_ONLY, windowLength, NULL, &status);
   CHECK_OPENCL_ERROR(status, "clCreateBuffer failed. (textBuf)");
 
   subStrBuf =
       clCreateBuffer(context, CL_MEM_READ_ONLY, subStr.length(), NULL, &status);
   CHECK_OPENCL_ERROR(status, "clCreateBuffer failed. (subStrBuf)");
 
-  cl_uint totalSearchPos = textLength - (cl_uint)subStr.length() + 1;
+  cl_uint totalSearchPos = windowLength - (cl_uint)subStr.length() + 1;
   searchLenPerWG = SEARCH_BYTES_PER_WORKITEM * LOCAL_SIZE;
   workGroupCount = (totalSearchPos + searchLenPerWG - 1) / searchLenPerWG;
 
@@ -209,7 +261,7 @@ int StringSearch::setupCL() {
 
   resultBuf = clCreateBuffer(
       context, CL_MEM_WRITE_ONLY,
-      sizeof(cl_uint) * (textLength - subStr.length() + 1), NULL, &status);
+      sizeof(cl_uint) * totalSearchPos, NULL, &status);
   CHECK_OPENCL_ERROR(status, "clCreateBuffer failed. (resultBuf)");
 
   availableLocalMemory = (cl_uint)deviceInfo.localMemSize;
@@ -259,14 +311,6 @@ int StringSearch::setupCL() {
   CHECK_OPENCL_ERROR(status, "clCreateKernel(StringSearchNaive) failed.");
 
   cl_uchar* ptr;
-  // Move text data host to device
-  status = mapBuffer(textBuf, ptr, textLength, CL_MAP_WRITE_INVALIDATE_REGION);
-  CHECK_ERROR(status, SDK_SUCCESS, "Failed to map device buffer.(textBuf)");
-  memcpy(ptr, text, textLength);
-  status = unmapBuffer(textBuf, ptr);
-  CHECK_ERROR(status, SDK_SUCCESS,
-              "Failed to unmap device buffer.(inputBuffer)");
-
   // Move subStr data host to device
   status = mapBuffer(subStrBuf, ptr, subStr.length(),
                      CL_MAP_WRITE_INVALIDATE_REGION);
@@ -276,9 +320,6 @@ int StringSearch::setupCL() {
   CHECK_ERROR(status, SDK_SUCCESS,
               "Failed to unmap device buffer.(inputBuffer)");
 
-  devResults.reserve(textLength - subStr.length() + 1);
-  memset(devResults.data(), 0, devResults.capacity() * sizeof(cl_uint));
-
   return SDK_SUCCESS;
 }
 
@@ -371,27 +412,110 @@ int StringSearch::runCLKernels() {
   return SDK_SUCCESS;
 }
 
+int StringSearch::loadWindow() {
+  textLength = (cl_uint)input.length();
+  cl_uint totalSearchPos = textLength - (cl_uint)subStr.length() + 1;
+  workGroupCount = (totalSearchPos + searchLenPerWG - 1) / searchLenPerWG;
+
+  // Move text data host to device
+  cl_uchar* ptr;
+  int status =
+      mapBuffer(textBuf, ptr, textLength, CL_MAP_WRITE_INVALIDATE_REGION);
+  CHECK_ERROR(status, SDK_SUCCESS, "Failed to map device buffer.(textBuf)");
+  memcpy(ptr, input.data(), textLength);
+  status = unmapBuffer(textBuf, ptr);
+  CHECK_ERROR(status, SDK_SUCCESS, "Failed to unmap device buffer.(textBuf)");
+
+  return SDK_SUCCESS;
+}
+
+int StringSearch::collectResults() {
+  // Read Results Count per workGroup
+  cl_uint* ptrCountBuff;
+  int status = mapBuffer(resultCountBuf, ptrCountBuff,
+                         workGroupCount * sizeof(cl_uint), CL_MAP_READ);
+  CHECK_ERROR(status, SDK_SUCCESS,
+              "Failed to map device buffer.(resultCountBuf)");
+
+  // Read the result buffer
+  cl_uint* ptrBuff;
+  status = mapBuffer(resultBuf, ptrBuff,
+                     (textLength - subStr.length() + 1) * sizeof(cl_uint),
+                     CL_MAP_READ);
+  CHECK_ERROR(status, SDK_SUCCESS, "Failed to map device buffer.(resultBuf)");
+
+  cl_uint count = ptrCountBuff[0];
+  for (cl_uint i = 1; i < workGroupCount; ++i) {
+    cl_uint found = ptrCountBuff[i];
+    if (found > 0) {
+      memcpy((ptrBuff + count), (ptrBuff + (i * searchLenPerWG)),
+             found * sizeof(cl_uint));
+      count += found;
+    }
+  }
+  std::sort(ptrBuff, ptrBuff + count);
+
+  // Positions are relative to the window
+  cl_ulong offset = input.offset();
+  for (cl_uint i = 0; i < count; ++i) {
+    devResults.push_back(offset + ptrBuff[i]);
+  }
+
+  // un-map resultCountBuf
+  status = unmapBuffer(resultCountBuf, ptrCountBuff);
+  CHECK_ERROR(status, SDK_SUCCESS,
+              "Failed to unmap device buffer.(resultCountBuf)");
+
+  // un-map resultBuf
+  status = unmapBuffer(resultBuf, ptrBuff);
+  CHECK_ERROR(status, SDK_SUCCESS, "Failed to unmap device buffer.(resultBuf)");
+
+  return SDK_SUCCESS;
+}
+
 int StringSearch::runKernel(std::string kernelName) {
   std::cout << "\nExecuting " << kernelName << " for " << iterations
             << " iterations" << std::endl;
   std::cout << "-------------------------------------------" << std::endl;
 
   int timer = sampleTimer->createTimer();
-  sampleTimer->resetTimer(timer);
-  sampleTimer->startTimer(timer);
+  kernelTime = 0;
+  sampleTimer->resetIterations();
+  devResults.clear();
+
+  // Stream the file through the device one window at a time
+  input.rewind(windowLength, subStr.length() - 1);
+  while (input.next()) {
+    if (loadWindow() != SDK_SUCCESS) {
+      return SDK_FAILURE;
+    }
+
+    sampleTimer->resetTimer(timer);
+    sampleTimer->startTimer(timer);
+
+    for (int i = 0; i < iterations; i++) {
+      // Arguments are set and execution call is enqueued on command buffer
+      sampleTimer->startIteration();
+      if (runCLKernels() != SDK_SUCCESS) {
+        return SDK_FAILURE;
+      }
+      sampleTimer->stopIteration();
+    }
 
-  for (int i = 0; i < iterations; i++) {
-    // Arguments are set and execution call is enqueued on command buffer
-    if (runCLKernels() != SDK_SUCCESS) {
+    sampleTimer->stopTimer(timer);
+    kernelTime += (double)(sampleTimer->readTimer(timer));
+
+    if (collectResults() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
   }
 
-  sampleTimer->stopTimer(timer);
-  kernelTime = (double)(sampleTimer->readTimer(timer));
+  if (input.failed()) {
+    return SDK_FAILURE;
+  }
 
   // Verify Results
-  if (verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
@@ -405,11 +529,21 @@ int StringSearch::run() {
   kernelType = KERNEL_NAIVE;
   kernel = &kernelNaive;
 
-  for (int i = 0; i < 2 && iterations != 1; i++) {
-    // Arguments are set and execution call is enqueued on command buffer
-    if (runCLKernels() != SDK_SUCCESS) {
+  // Warm up on the first window, runKernel rewinds the input again
+  input.rewind(windowLength, subStr.length() - 1);
+  if (iterations != 1 && input.next()) {
+    if (loadWindow() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    for (int i = 0; i < 2; i++) {
+      // Arguments are set and execution call is enqueued on command buffer
+      if (runCLKernels() != SDK_SUCCESS) {
+        return SDK_FAILURE;
+      }
+    }
+  }
+  if (input.failed()) {
+    return SDK_FAILURE;
   }
 
   if (subStr.length() == 1) {
@@ -432,79 +566,51 @@ int StringSearch::run() {
 }
 
 void StringSearch::cpuReferenceImpl() {
-  static bool refImplemented = false;
-  if (refImplemented) {
+  if (cpuResultsReady) {
     return;
   }
 
-  cl_uint hlen = textLength;
-  cl_uint last = (cl_uint)subStr.length() - 1;
-  cl_uint badCharSkip[UCHAR_MAX + 1];
+  int timer = sampleTimer->createTimer();
+  sampleTimer->resetTimer(timer);
+  sampleTimer->startTimer(timer);
 
-  // Initialize the table with default values
-  cl_uint scan = 0;
-  for (scan = 0; scan <= UCHAR_MAX; ++scan) {
-    badCharSkip[scan] = (cl_uint)subStr.length();
+  // search the same file, sharing enough bytes for the longest pattern
+  std::vector<StringSearchMatch> matches;
+  input.rewind(windowLength, hostEngine.overlap());
+  while (input.next()) {
+    bool final = (input.offset() + input.length() == fileLength);
+    hostEngine.search(input.data(), input.length(), input.offset(), final,
+                      matches);
   }
 
-  // populate the table with analysis on pattern
-  for (scan = 0; scan < last; ++scan) {
-    if (caseSensitive) {
-      badCharSkip[subStr[scan]] = last - scan;
-    } else {
-      badCharSkip[toupper(subStr[scan])] = last - scan;
-      badCharSkip[tolower(subStr[scan])] = last - scan;
-    }
-  }
+  sampleTimer->stopTimer(timer);
+  hostTime = (double)(sampleTimer->readTimer(timer));
 
-  // search the text
-  cl_uint curPos = 0;
-  while ((textLength - curPos) > last) {
-    int p = last;
-    for (scan = (last + curPos); COMPARE(text[scan], subStr[p--]); scan -= 1) {
-      if (scan == curPos) {
-        cpuResults.push_back(curPos);
-        break;
-      }
+  // The device kernels search for subStr only
+  cpuResults.clear();
+  for (size_t i = 0; i < matches.size(); ++i) {
+    if (matches[i].pattern == 0) {
+      cpuResults.push_back(matches[i].position);
     }
-    curPos += (scan == curPos) ? 1 : badCharSkip[text[last + curPos]];
   }
-  refImplemented = true;
+  hostMatches = matches.size();
+  cpuResultsReady = !input.failed();
 }
 
 int StringSearch::verifyResults() {
-  // Read Results Count per workGroup
-  cl_uint* ptrCountBuff;
-  int status = mapBuffer(resultCountBuf, ptrCountBuff,
-                         workGroupCount * sizeof(cl_uint), CL_MAP_READ);
-  CHECK_ERROR(status, SDK_SUCCESS,
-              "Failed to map device buffer.(resultCountBuf)");
-
-  // Read the result buffer
-  cl_uint* ptrBuff;
-  status = mapBuffer(resultBuf, ptrBuff,
-                     (textLength - subStr.length() + 1) * sizeof(cl_uint),
-                     CL_MAP_READ);
-  CHECK_ERROR(status, SDK_SUCCESS, "Failed to map device buffer.(resultBuf)");
-
-  cl_uint count = ptrCountBuff[0];
-  for (cl_uint i = 1; i < workGroupCount; ++i) {
-    cl_uint found = ptrCountBuff[i];
-    if (found > 0) {
-      memcpy((ptrBuff + count), (ptrBuff + (i * searchLenPerWG)),
-             found * sizeof(cl_uint));
-      count += found;
-    }
-  }
-  std::sort(ptrBuff, ptrBuff + count);
+  int status = SDK_SUCCESS;
+  cl_ulong count = devResults.size();
 
   if (sampleArgs->verify) {
     // Rreference implementation on host device
     cpuReferenceImpl();
 
     // compare the results and see if they match
-    bool result = (count == cpuResults.size());
-    result = result && std::equal(ptrBuff, ptrBuff + count, cpuResults.begin());
+    bool result = (devResults == cpuResults);
+    if (patterns.size() > 1) {
+      printArray<cl_ulong>("Host matches of all patterns : ", &hostMatches, 1,
+                           1);
+    }
     if (result) {
       std::cout << "Passed!\n" << std::endl;
       status = SDK_SUCCESS;
@@ -514,20 +620,11 @@ int StringSearch::verifyResults() {
     }
   }
 
-  printArray<cl_uint>("Number of matches : ", &count, 1, 1);
-  if (!sampleArgs->quiet) {
-    printArray<cl_uint>("Positions : ", ptrBuff, count, 1);
+  printArray<cl_ulong>("Number of matches : ", &count, 1, 1);
+  if (!sampleArgs->quiet && count > 0) {
+    printArray<cl_ulong>("Positions : ", &devResults[0], (int)count, 1);
   }
 
-  // un-map resultCountBuf
-  int result = unmapBuffer(resultCountBuf, ptrCountBuff);
-  CHECK_ERROR(result, SDK_SUCCESS,
-              "Failed to unmap device buffer.(resultCountBuf)");
-
-  // un-map resultBuf
-  result = unmapBuffer(resultBuf, ptrBuff);
-  CHECK_ERROR(result, SDK_SUCCESS, "Failed to unmap device buffer.(resultBuf)");
-
   return status;
 }
 
@@ -570,12 +667,15 @@ void StringSearch::printStats() {
     std::string stats[4];
     double avgKernelTime = kernelTime / iterations;
 
-    stats[0] = toString(textLength, std::dec);
+    stats[0] = toString(fileLength, std::dec);
     stats[1] = toString(setupTime, std::dec);
     stats[2] = toString(avgKernelTime, std::dec);
-    stats[3] = toString((textLength / avgKernelTime), std::dec);
+    stats[3] = toString((fileLength / avgKernelTime), std::dec);
+
+    printStatisticsWithHost(strArray, stats, 4, hostTime, "Host Speed(GB/s)",
+                            fileLength / 1e9);
 
-    printStatistics(strArray, stats, 4);
+    sampleTimer->printIterationStats();
   }
 }
 
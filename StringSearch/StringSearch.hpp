@@ -33,14 +33,16 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <string.h>
 #include "CLUtil.hpp"
+#include "StringSearchCPU.hpp"
+#include "StringSearchInput.hpp"
 
 using namespace appsdk;
 
 #define SAMPLE_VERSION "AMD-APP-SDK-v2.9-1.599.1"
 
 #define LOCAL_SIZE 256
-#define COMPARE(x, y) ((caseSensitive) ? (x == y) : (toupper(x) == toupper(y)))
 #define SEARCH_BYTES_PER_WORKITEM 512
+#define SEARCH_WINDOW_BYTES (64 << 20) /**< default bytes searched per pass */
 
 enum KERNELS { KERNEL_NAIVE = 0, KERNEL_LOADBALANCE = 1 };
 
@@ -49,12 +51,21 @@ enum KERNELS { KERNEL_NAIVE = 0, KERNEL_LOADBALANCE = 1 };
 * Class implements StringSearch implementation
 */
 class StringSearch {
-  cl_uchar *text;
-  cl_uint textLength;
+  StringSearchInput input; /**< mapped input file, walked window by window */
+  cl_ulong fileLength;     /**< size of the input file */
+  cl_uint windowLength;    /**< bytes searched per window */
+  cl_uint textLength;      /**< bytes in the current window */
+  int windowSize;          /**< window size option in MB, 0 for the default */
   std::string subStr;
   std::string file;
-  std::vector<cl_uint> devResults;
-  std::vector<cl_uint> cpuResults;
+  std::string patternFile;           /**< extra patterns for the host engine */
+  std::vector<std::string> patterns; /**< subStr, then the extra patterns */
+  StringSearchCPU hostEngine;        /**< host multi-pattern search */
+  cl_ulong hostMatches;              /**< host matches of all patterns */
+  cl_double hostTime;                /**< time taken by the host search */
+  bool cpuResultsReady;              /**< host search already done */
+  std::vector<cl_ulong> devResults; /**< match offsets found by the device */
+  std::vector<cl_ulong> cpuResults; /**< match offsets found by the host */
 
   cl_double setupTime;  /**< time taken to setup OpenCL resources and building
                            kernel */
@@ -98,10 +109,15 @@ class StringSearch {
   *******************************************************************************
   */
   StringSearch()
-      : text(NULL),
+      : fileLength(0),
+        windowLength(0),
         textLength(0),
+        windowSize(0),
         subStr("if there is a failure to allocate resources required by the"),
         file("StringSearch_Input.txt"),
+        hostMatches(0),
+        hostTime(0),
+        cpuResultsReady(false),
         setupTime(0),
         kernelTime(0),
         devices(NULL),
@@ -126,7 +142,6 @@ class StringSearch {
   *******************************************************************************
   */
   ~StringSearch() {
-    FREE(text);
     devResults.clear();
     cpuResults.clear();
   }
@@ -251,11 +266,34 @@ class StringSearch {
   */
   int runCLKernels();
 
+  /**
+  *******************************************************************************
+  * @fn loadWindow
+  * @brief Copy the current input window to the device and size the launch
+  *        for it
+  *
+  * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+  *******************************************************************************
+  */
+  int loadWindow();
+
+  /**
+  *******************************************************************************
+  * @fn collectResults
+  * @brief Gather the matches of the current window from the device and
+  *        append their file offsets to devResults
+  *
+  * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+  *******************************************************************************
+  */
+  int collectResults();
+
   /**
   *******************************************************************************
   * @fn cpuReferenceImpl
-  * @brief CPU reference stringSearch implementation based on
-  *"Boyer-Moore-Horspool" Algorithm
+  * @brief CPU reference stringSearch implementation. Searches the file for
+  *        all patterns at once with StringSearchCPU and keeps the matches
+  *        of subStr for verification
   *******************************************************************************
   */
   void cpuReferenceImpl();
@@ -0,0 +1,323 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef STRINGSEARCHCPU_H_
+#define STRINGSEARCHCPU_H_
+
+#include <CL/cl.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "SDKThread.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace appsdk;
+
+/**
+ * Host multi-pattern search engine for StringSearch.
+ *
+ * Every pattern is located with a first/last byte prefilter: 16 start
+ * positions are tested at once by comparing a block of text against the
+ * first byte of the pattern, the block one byte further against its
+ * second byte and the block length - 1 bytes further against its last
+ * byte. Only positions passing all three are compared in full. The first
+ * two blocks are loaded once for all patterns, and patterns are visited
+ * by length so patterns of the same length share the last one.
+ *
+ * Without case sensitivity, patterns are folded to lower case up front
+ * and text blocks are folded in register (ASCII letters only, like
+ * toupper/tolower in the C locale).
+ *
+ * The start positions are split into STRINGSEARCH_CPU_CHUNK sized tasks.
+ * A task reads past its last start position by up to the longest
+ * pattern length - 1, so matches across task boundaries are found
+ * exactly once.
+ */
+#define STRINGSEARCH_CPU_CHUNK (1 << 20) /**< start positions per task */
+
+/**
+ * StringSearchMatch
+ * One occurrence of a pattern
+ */
+struct StringSearchMatch {
+  cl_ulong position; /**< offset of the first byte of the match */
+  cl_uint pattern;   /**< index of the pattern that matched */
+
+  bool operator<(const StringSearchMatch &other) const {
+    return position < other.position ||
+           (position == other.position && pattern < other.pattern);
+  }
+};
+
+/**
+ * StringSearchCPU
+ * Finds all occurrences of a set of patterns
+ */
+class StringSearchCPU {
+ public:
+  StringSearchCPU() : caseSensitive(true), maxLength(0) {
+    setPatterns(std::vector<std::string>(), true);
+  }
+
+  /**
+   * setPatterns
+   * @param list patterns to search for, none of them empty
+   * @param sensitive compare case sensitively
+   */
+  void setPatterns(const std::vector<std::string> &list, bool sensitive) {
+    caseSensitive = sensitive;
+    for (int c = 0; c < 256; ++c) {
+      fold[c] = (cl_uchar)((!sensitive && c >= 'A' && c <= 'Z') ? c + 32 : c);
+    }
+
+    needles.resize(list.size());
+    bytes.clear();
+    maxLength = 0;
+    for (size_t p = 0; p < list.size(); ++p) {
+      needles[p].start = bytes.size();
+      needles[p].length = list[p].length();
+      needles[p].pattern = (cl_uint)p;
+      for (size_t j = 0; j < list[p].length(); ++j) {
+        bytes.push_back(fold[(cl_uchar)list[p][j]]);
+      }
+      maxLength = std::max(maxLength, list[p].length());
+    }
+    std::stable_sort(needles.begin(), needles.end());
+  }
+
+  /**
+   * overlap
+   * Bytes consecutive windows of a stream must share
+   */
+  size_t overlap() const { return maxLength ? maxLength - 1 : 0; }
+
+  /**
+   * search
+   * Appends the matches in text to matches, sorted by position
+   * @param text window of the input
+   * @param length bytes in the window
+   * @param offset position of the window in the input
+   * @param final the window ends the input. Otherwise matches starting in
+   *        its last overlap() bytes are left to the next window.
+   * @param matches found occurrences
+   */
+  void search(const cl_uchar *text, size_t length, cl_ulong offset,
+              bool final, std::vector<StringSearchMatch> &matches) const {
+    if (needles.empty()) {
+      return;
+    }
+    size_t starts = final ? length : (length > overlap() ? length - overlap()
+                                                         : 0);
+    Job job;
+    job.engine = this;
+    job.text = text;
+    job.length = length;
+    job.starts = starts;
+    job.offset = offset;
+    std::vector<std::vector<StringSearchMatch> > found(
+        (starts + STRINGSEARCH_CPU_CHUNK - 1) / STRINGSEARCH_CPU_CHUNK);
+    job.found = found.empty() ? NULL : &found[0];
+    SDKThreadPool::instance().parallelFor(0, found.size(), 0, searchChunks,
+                                          &job);
+
+    for (size_t c = 0; c < found.size(); ++c) {
+      matches.insert(matches.end(), found[c].begin(), found[c].end());
+    }
+  }
+
+ private:
+  /**
+   * Job
+   * One search call, shared by all tasks
+   */
+  struct Job {
+    const StringSearchCPU *engine;          /**< patterns */
+    const cl_uchar *text;                   /**< window */
+    size_t length;                          /**< bytes in the window */
+    size_t starts;                          /**< start positions to test */
+    cl_ulong offset;                        /**< position of the window */
+    std::vector<StringSearchMatch> *found;  /**< matches of each task */
+  };
+
+  /**
+   * Needle
+   * A folded pattern, ordered by length
+   */
+  struct Needle {
+    size_t start;   /**< first byte in bytes */
+    size_t length;  /**< pattern length */
+    cl_uint pattern; /**< index of the pattern */
+
+    bool operator<(const Needle &other) const {
+      return length < other.length;
+    }
+  };
+
+  /**
+   * searchChunks
+   * Tasks [begin, end) of a search call
+   */
+  static void searchChunks(size_t begin, size_t end, void *data) {
+    const Job *job = (const Job *)data;
+    for (size_t c = begin; c < end; ++c) {
+      size_t first = c * STRINGSEARCH_CPU_CHUNK;
+      size_t last = std::min(first + STRINGSEARCH_CPU_CHUNK, job->starts);
+      if (job->engine->caseSensitive) {
+        job->engine->scan<false>(job, first, last, job->found[c]);
+      } else {
+        job->engine->scan<true>(job, first, last, job->found[c]);
+      }
+    }
+  }
+
+  /**
+   * matchAt
+   * Compares the bytes of pattern p of length m between its first and
+   * last one
+   */
+  bool matchAt(const cl_uchar *s, const cl_uchar *p, size_t m) const {
+    for (size_t j = 1; j + 1 < m; ++j) {
+      if (fold[s[j]] != p[j]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+#ifdef __SSE2__
+  /**
+   * foldBlock
+   * ASCII upper case letters of 16 bytes to lower case
+   */
+  template <bool Fold>
+  static inline __m128i foldBlock(__m128i x) {
+    if (!Fold) {
+      return x;
+    }
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(x, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+  }
+
+  /**
+   * lowestBit
+   * Index of the lowest set bit of a nonzero mask
+   */
+  static inline unsigned int lowestBit(unsigned int x) {
+#ifdef __GNUC__
+    return __builtin_ctz(x);
+#else
+    unsigned int k = 0;
+    while (!(x & 1)) {
+      x >>= 1;
+      ++k;
+    }
+    return k;
+#endif
+  }
+#endif
+
+  /**
+   * scan
+   * Start positions [first, last) of a window
+   */
+  template <bool Fold>
+  void scan(const Job *job, size_t first, size_t last,
+            std::vector<StringSearchMatch> &found) const {
+    const cl_uchar *text = job->text;
+    const cl_uchar *pool = &bytes[0];
+    const Needle *needle = &needles[0];
+    size_t count = needles.size();
+    size_t i = first;
+
+#ifdef __SSE2__
+    // 16 start positions at a time while all loads fit
+    for (; i + 16 <= last && i + 16 + maxLength <= job->length; i += 16) {
+      __m128i block =
+          foldBlock<Fold>(_mm_loadu_si128((const __m128i *)(text + i)));
+      __m128i next =
+          foldBlock<Fold>(_mm_loadu_si128((const __m128i *)(text + i + 1)));
+      __m128i tail = block;
+      size_t tailLength = 1;
+
+      for (size_t k = 0; k < count; ++k) {
+        const cl_uchar *p = pool + needle[k].start;
+        size_t m = needle[k].length;
+        if (m != tailLength) {
+          tail = foldBlock<Fold>(
+              _mm_loadu_si128((const __m128i *)(text + i + m - 1)));
+          tailLength = m;
+        }
+        __m128i hit =
+            _mm_and_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8((char)p[0])),
+                          _mm_cmpeq_epi8(tail, _mm_set1_epi8((char)p[m - 1])));
+        if (m > 2) {
+          hit = _mm_and_si128(hit,
+                              _mm_cmpeq_epi8(next, _mm_set1_epi8((char)p[1])));
+        }
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(hit);
+        while (mask) {
+          size_t s = i + lowestBit(mask);
+          if (matchAt(text + s, p, m)) {
+            StringSearchMatch match = {job->offset + s, needle[k].pattern};
+            found.push_back(match);
+          }
+          mask &= mask - 1;
+        }
+      }
+    }
+#endif
+
+    // Remaining start positions one at a time
+    for (; i < last; ++i) {
+      for (size_t k = 0; k < count; ++k) {
+        const cl_uchar *p = pool + needle[k].start;
+        size_t m = needle[k].length;
+        if (i + m <= job->length && fold[text[i]] == p[0] &&
+            fold[text[i + m - 1]] == p[m - 1] && matchAt(text + i, p, m)) {
+          StringSearchMatch match = {job->offset + i, needle[k].pattern};
+          found.push_back(match);
+        }
+      }
+    }
+
+    // Several patterns report a block pattern by pattern
+    if (count > 1) {
+      std::sort(found.begin(), found.end());
+    }
+  }
+
+  bool caseSensitive;          /**< patterns are compared as is */
+  size_t maxLength;            /**< length of the longest pattern */
+  std::vector<Needle> needles; /**< patterns by length */
+  std::vector<cl_uchar> bytes; /**< folded bytes of all patterns */
+  cl_uchar fold[256];          /**< byte folding table */
+};
+
+#endif  // STRINGSEARCHCPU_H_
@@ -0,0 +1,312 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef STRINGSEARCHINPUT_H_
+#define STRINGSEARCHINPUT_H_
+
+#include <CL/cl.h>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Memory mapped, windowed reader for the StringSearch text.
+ *
+ * The file is never read as a whole. It is walked as a series of windows
+ * of a fixed length, and consecutive windows overlap by a given number
+ * of bytes (the pattern length - 1), so every match lies entirely in
+ * exactly one window. Each window is a read-only view of the file.
+ *
+ * Two views are kept. While the caller searches the current window, the
+ * next one is already mapped and the kernel is asked to page it in
+ * (MADV_WILLNEED), so file reads overlap the search. A view is unmapped
+ * as soon as the walk moves past it, which keeps the resident size at
+ * about two windows whatever the file size. Offsets are 64 bit, also in
+ * 32 bit builds, where the file is opened, sized and mapped through the
+ * explicit large file interface (open64, fstat64, mmap64).
+ */
+class StringSearchInput {
+ public:
+  /**
+   * Constructor
+   */
+  StringSearchInput() : fileSize(0), windowLength(0), overlap(0),
+                        nextOffset(0), current(0), error(false) {
+#ifdef _WIN32
+    file = INVALID_HANDLE_VALUE;
+    mapping = NULL;
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    granularity = info.dwAllocationGranularity;
+#else
+    fd = -1;
+    granularity = (cl_ulong)sysconf(_SC_PAGESIZE);
+#endif
+    views[0] = views[1] = View();
+  }
+
+  /**
+   * Destructor
+   */
+  ~StringSearchInput() { close(); }
+
+  /**
+   * open
+   * Opens the file, the walk starts with rewind()
+   * @return true on success
+   */
+  bool open(const std::string &path) {
+    close();
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+      close();
+      return false;
+    }
+    fileSize = (cl_ulong)size.QuadPart;
+    // An empty file cannot be mapped, it simply has no window
+    if (fileSize > 0) {
+      mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping == NULL) {
+        close();
+        return false;
+      }
+    }
+#else
+    fd = open64(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat64 st;
+    if (fstat64(fd, &st) != 0) {
+      close();
+      return false;
+    }
+    fileSize = (cl_ulong)st.st_size;
+#endif
+    return true;
+  }
+
+  /**
+   * close
+   * Unmaps all windows and closes the file
+   */
+  void close() {
+    unmap(views[0]);
+    unmap(views[1]);
+#ifdef _WIN32
+    if (mapping != NULL) {
+      CloseHandle(mapping);
+      mapping = NULL;
+    }
+    if (file != INVALID_HANDLE_VALUE) {
+      CloseHandle(file);
+      file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (fd >= 0) {
+      ::close(fd);
+      fd = -1;
+    }
+#endif
+    fileSize = 0;
+  }
+
+  /**
+   * size
+   * @return file size in bytes
+   */
+  cl_ulong size() const { return fileSize; }
+
+  /**
+   * rewind
+   * Starts a new walk, next() then returns the first window
+   * @param length bytes per window
+   * @param overlapping bytes shared by consecutive windows
+   */
+  void rewind(size_t length, size_t overlapping) {
+    unmap(views[0]);
+    unmap(views[1]);
+    windowLength = length > overlapping ? length : overlapping + 1;
+    overlap = overlapping;
+    nextOffset = 0;
+    current = 0;
+    error = false;
+  }
+
+  /**
+   * next
+   * Moves to the following window and starts paging in the one after
+   * @return false at the end of the file or on failure, see failed()
+   */
+  bool next() {
+    unmap(views[current]);
+    current ^= 1;
+    if (views[current].data == NULL) {
+      if (nextOffset >= fileSize || !map(views[current], nextOffset)) {
+        return false;
+      }
+      nextOffset = following(views[current]);
+    }
+
+    View &ahead = views[current ^ 1];
+    if (nextOffset < fileSize && map(ahead, nextOffset)) {
+      prefetch(ahead);
+      nextOffset = following(ahead);
+    }
+    return true;
+  }
+
+  /**
+   * failed
+   * @return true if the last walk stopped because a window could not be
+   * mapped
+   */
+  bool failed() const { return error; }
+
+  /** @return the current window */
+  const cl_uchar *data() const { return views[current].data; }
+
+  /** @return length of the current window in bytes */
+  size_t length() const { return views[current].length; }
+
+  /** @return file offset of the current window */
+  cl_ulong offset() const { return views[current].offset; }
+
+ private:
+  /**
+   * View
+   * One mapped window
+   */
+  struct View {
+    void *base;           /**< start of the mapping, granularity aligned */
+    size_t mapped;        /**< bytes mapped from base */
+    const cl_uchar *data; /**< first byte of the window */
+    cl_ulong offset;      /**< file offset of data */
+    size_t length;        /**< bytes in the window */
+
+    View() : base(NULL), mapped(0), data(NULL), offset(0), length(0) {}
+  };
+
+  /**
+   * following
+   * Offset of the window after v, the file size after the last one
+   */
+  cl_ulong following(const View &v) const {
+    cl_ulong end = v.offset + v.length;
+    return end >= fileSize ? fileSize : end - overlap;
+  }
+
+  /**
+   * map
+   * Maps the window starting at offset into v
+   */
+  bool map(View &v, cl_ulong offset) {
+    cl_ulong aligned = offset - offset % granularity;
+    cl_ulong remaining = fileSize - offset;
+    v.offset = offset;
+    v.length = remaining < windowLength ? (size_t)remaining : windowLength;
+    v.mapped = (size_t)(offset - aligned) + v.length;
+#ifdef _WIN32
+    v.base = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(aligned >> 32),
+                           (DWORD)aligned, v.mapped);
+    if (v.base == NULL) {
+      v = View();
+    }
+#else
+    v.base =
+        mmap64(NULL, v.mapped, PROT_READ, MAP_PRIVATE, fd, (off64_t)aligned);
+    if (v.base == MAP_FAILED) {
+      v = View();
+    } else {
+      madvise(v.base, v.mapped, MADV_SEQUENTIAL);
+    }
+#endif
+    if (v.base == NULL) {
+      std::cout << "\n Failed to map input window at offset " << offset
+                << std::endl;
+      error = true;
+      return false;
+    }
+    v.data = (const cl_uchar *)v.base + (offset - aligned);
+    return true;
+  }
+
+  /**
+   * prefetch
+   * Starts reading v from the file without waiting for it
+   */
+  void prefetch(View &v) {
+#ifndef _WIN32
+    madvise(v.base, v.mapped, MADV_WILLNEED);
+#endif
+  }
+
+  /**
+   * unmap
+   * Releases v, dropping its pages from the resident set
+   */
+  void unmap(View &v) {
+    if (v.base != NULL) {
+#ifdef _WIN32
+      UnmapViewOfFile(v.base);
+#else
+      munmap(v.base, v.mapped);
+#endif
+    }
+    v = View();
+  }
+
+#ifdef _WIN32
+  HANDLE file;    /**< input file */
+  HANDLE mapping; /**< read-only mapping object of the file */
+#else
+  int fd; /**< input file */
+#endif
+  cl_ulong granularity;  /**< alignment of a mapping offset */
+  cl_ulong fileSize;     /**< file size in bytes */
+  size_t windowLength;   /**< bytes per window */
+  size_t overlap;        /**< bytes shared by consecutive windows */
+  cl_ulong nextOffset;   /**< offset of the next window to map */
+  View views[2];         /**< current window and the one paged in ahead */
+  int current;           /**< index of the current window in views */
+  bool error;            /**< a window of the walk could not be mapped */
+};
+
+#endif  // STRINGSEARCHINPUT_H_
@@ -143,7 +143,7 @@ int URNG::setupCL() {
   cl_context_properties cps[3] = {CL_CONTEXT_PLATFORM,
                                   (cl_context_properties)platform, 0};
 
-  context = clCreateContextFromType(cps, dType, NULL, NULL, &status);
+  context = getContextFromType(cps, dType, &status);
   CHECK_OPENCL_ERROR(status, "clCreateContextFromType failed.");
 
   // getting device on which to run the sample
@@ -371,9 +371,11 @@ int URNG::run() {
 
   for (int i = 0; i < iterations; i++) {
     // Set kernel arguments and run kernel
+    sampleTimer->startIteration();
     if (runCLKernels() != SDK_SUCCESS) {
       return SDK_FAILURE;
     }
+    sampleTimer->stopIteration();
   }
 
   sampleTimer->stopTimer(timer);
@@ -456,6 +458,8 @@ void URNG::printStats() {
 
   if (sampleArgs->timing) {
     printStatistics(strArray, stats, 4);
+
+    sampleTimer->printIterationStats();
   }
 }
 
@@ -483,7 +487,7 @@ int main(int argc, char* argv[]) {
     return SDK_FAILURE;
   }
 
-  if (clURNG.verifyResults() != SDK_SUCCESS) {
+  if (reportVerification(clURNG.verifyResults()) != SDK_SUCCESS) {
     return SDK_FAILURE;
   }
 
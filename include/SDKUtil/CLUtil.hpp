@@ -585,9 +585,433 @@ static int getDevices(cl_context &context, cl_device_id **devices, int deviceId,
   return SDK_SUCCESS;
 }
 
+/**
+ * SDKCLCache
+ * class keeps contexts and built programs alive between samples that run
+ * in one process. It is disabled by default, so a standalone sample gets
+ * exactly the objects it creates; the multi-sample driver enables it and
+ * releases everything at exit. The cache holds one reference on every
+ * object and hands out an extra one, so samples release as usual.
+ */
+class SDKCLCache {
+ private:
+  struct ContextEntry {
+    std::vector<cl_context_properties> properties; /**< creation properties */
+    cl_device_type deviceType;                      /**< device type */
+    cl_context context;                             /**< cached context */
+  };
+
+  struct ProgramEntry {
+    cl_context context;  /**< context the program was built in */
+    cl_device_id device; /**< device the program was built for */
+    std::string key;     /**< kernel file, binary and build options */
+    cl_program program;  /**< cached program */
+  };
+
+  bool enabled;                       /**< true if objects are cached */
+  std::vector<ContextEntry> contexts; /**< cached contexts */
+  std::vector<ProgramEntry> programs; /**< cached programs */
+
+  SDKCLCache() : enabled(false) {}
+  SDKCLCache(const SDKCLCache &);
+  SDKCLCache &operator=(const SDKCLCache &);
+
+  static std::vector<cl_context_properties> toVector(
+      const cl_context_properties *cps) {
+    std::vector<cl_context_properties> props;
+    while (cps != NULL && *cps != 0) {
+      props.push_back(cps[0]);
+      props.push_back(cps[1]);
+      cps += 2;
+    }
+    return props;
+  }
+
+ public:
+  /**
+   * instance
+   * @return the process wide cache
+   */
+  static SDKCLCache &instance();
+
+  /**
+   * enable
+   * Turns caching on or off
+   */
+  void enable(bool enable = true) { enabled = enable; }
+
+  /**
+   * isEnabled
+   * @return true if caching is on
+   */
+  bool isEnabled() const { return enabled; }
+
+  /**
+   * findContext
+   * @return retained context created with the same properties, or NULL
+   */
+  cl_context findContext(const cl_context_properties *cps,
+                         cl_device_type deviceType) {
+    std::vector<cl_context_properties> props = toVector(cps);
+    for (size_t i = 0; i < contexts.size(); i++) {
+      if (contexts[i].deviceType == deviceType &&
+          contexts[i].properties == props) {
+        clRetainContext(contexts[i].context);
+        return contexts[i].context;
+      }
+    }
+    return NULL;
+  }
+
+  /**
+   * addContext
+   * Keeps a reference on a newly created context
+   */
+  void addContext(const cl_context_properties *cps, cl_device_type deviceType,
+                  cl_context context) {
+    ContextEntry entry;
+    entry.properties = toVector(cps);
+    entry.deviceType = deviceType;
+    entry.context = context;
+    clRetainContext(context);
+    contexts.push_back(entry);
+  }
+
+  /**
+   * findProgram
+   * @return retained program built with the same key, or NULL
+   */
+  cl_program findProgram(cl_context context, cl_device_id device,
+                         const std::string &key) {
+    for (size_t i = 0; i < programs.size(); i++) {
+      if (programs[i].context == context && programs[i].device == device &&
+          programs[i].key == key) {
+        clRetainProgram(programs[i].program);
+        return programs[i].program;
+      }
+    }
+    return NULL;
+  }
+
+  /**
+   * addProgram
+   * Keeps a reference on a successfully built program
+   */
+  void addProgram(cl_context context, cl_device_id device,
+                  const std::string &key, cl_program program) {
+    ProgramEntry entry;
+    entry.context = context;
+    entry.device = device;
+    entry.key = key;
+    entry.program = program;
+    clRetainProgram(program);
+    programs.push_back(entry);
+  }
+
+  /**
+   * release
+   * Drops the cache references on all programs and contexts
+   */
+  void release() {
+    for (size_t i = 0; i < programs.size(); i++) {
+      clReleaseProgram(programs[i].program);
+    }
+    programs.clear();
+    for (size_t i = 0; i < contexts.size(); i++) {
+      clReleaseContext(contexts[i].context);
+    }
+    contexts.clear();
+  }
+};
+
+inline SDKCLCache &SDKCLCache::instance() {
+  static SDKCLCache cache;
+  return cache;
+}
+
+/**
+ * getContextFromType
+ * clCreateContextFromType, served from SDKCLCache when it is enabled
+ * @param cps context properties
+ * @param deviceType type of the devices in the context
+ * @param status OpenCL error code
+ * @return context, to be released with clReleaseContext
+ */
+static cl_context getContextFromType(const cl_context_properties *cps,
+                                     cl_device_type deviceType,
+                                     cl_int *status) {
+  SDKCLCache &cache = SDKCLCache::instance();
+  if (cache.isEnabled()) {
+    cl_context context = cache.findContext(cps, deviceType);
+    if (context != NULL) {
+      *status = CL_SUCCESS;
+      return context;
+    }
+  }
+  cl_context context =
+      clCreateContextFromType(cps, deviceType, NULL, NULL, status);
+  if (*status == CL_SUCCESS && cache.isEnabled()) {
+    cache.addContext(cps, deviceType, context);
+  }
+  return context;
+}
+
+/**
+ * SDKBinaryCache
+ * class keeps built program binaries on disk so that later runs skip the
+ * source compile. An entry is keyed by the kernel source, the build
+ * options (flags file included), the device name and the driver version;
+ * the file name is a hash of that key and the file starts with the key
+ * itself, so collisions and stale entries are detected and rebuilt.
+ * The cache is off unless --cache names its directory, so runs do not
+ * depend on files left behind by earlier ones. "--cache default" selects
+ * $AMDAPP_BINARY_CACHE, else $XDG_CACHE_HOME or ~/.cache (%LOCALAPPDATA%
+ * on Windows).
+ */
+class SDKBinaryCache {
+ private:
+  std::string dir; /**< cache directory, empty when disabled */
+
+  SDKBinaryCache() {}
+  SDKBinaryCache(const SDKBinaryCache &);
+  SDKBinaryCache &operator=(const SDKBinaryCache &);
+
+  static std::string defaultDirectory() {
+    const char *path = getenv("AMDAPP_BINARY_CACHE");
+    if (path != NULL) {
+      return path;
+    }
+#ifdef _WIN32
+    path = getenv("LOCALAPPDATA");
+    if (path != NULL && *path != '\0') {
+      return std::string(path) + "\\AMDAPP\\BinaryCache";
+    }
+#else
+    path = getenv("XDG_CACHE_HOME");
+    if (path != NULL && *path != '\0') {
+      return std::string(path) + "/amdapp-sdk/binaries";
+    }
+    path = getenv("HOME");
+    if (path != NULL && *path != '\0') {
+      return std::string(path) + "/.cache/amdapp-sdk/binaries";
+    }
+#endif
+    return "";
+  }
+
+  /**
+   * hash
+   * 64-bit FNV-1a of data
+   */
+  static std::string hash(const std::string &data) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (size_t i = 0; i < data.size(); i++) {
+      h ^= (unsigned char)data[i];
+      h *= 1099511628211ULL;
+    }
+    char hex[17];
+    sprintf(hex, "%016llx", h);
+    return hex;
+  }
+
+  static std::string getDeviceString(cl_device_id device,
+                                     cl_device_info param) {
+    size_t size = 0;
+    if (clGetDeviceInfo(device, param, 0, NULL, &size) != CL_SUCCESS ||
+        size == 0) {
+      return "";
+    }
+    std::vector<char> value(size);
+    if (clGetDeviceInfo(device, param, size, &value[0], NULL) != CL_SUCCESS) {
+      return "";
+    }
+    return std::string(&value[0]);
+  }
+
+ public:
+  /**
+   * instance
+   * @return the process wide cache
+   */
+  static SDKBinaryCache &instance();
+
+  /**
+   * setDirectory
+   * @param path cache directory, "default" for the standard location;
+   * empty or "off" disables the cache
+   */
+  void setDirectory(const std::string &path) {
+    if (path == "off") {
+      dir = "";
+    } else if (path == "default") {
+      dir = defaultDirectory();
+    } else {
+      dir = path;
+    }
+    if (!dir.empty() && dir[dir.size() - 1] != '/' &&
+        dir[dir.size() - 1] != '\\') {
+      dir += "/";
+    }
+  }
+
+  /**
+   * isEnabled
+   * @return true if a cache directory is set
+   */
+  bool isEnabled() const { return !dir.empty(); }
+
+  /**
+   * makeKey
+   * @param source kernel source
+   * @param flags complete build options
+   * @param device device the program is built for
+   * @return key text written at the start of the cache entry
+   */
+  std::string makeKey(const std::string &source, const std::string &flags,
+                      cl_device_id device) {
+    std::ostringstream key;
+    key << "AMDAPP binary cache 1\n"
+        << "device: " << getDeviceString(device, CL_DEVICE_NAME) << "\n"
+        << "driver: " << getDeviceString(device, CL_DRIVER_VERSION) << "\n"
+        << "flags: " << flags << "\n"
+        << "source: " << hash(source) << " " << source.size() << "\n\n";
+    return key.str();
+  }
+
+  /**
+   * getFileName
+   * @param kernelName kernel file the program comes from
+   * @param key key returned by makeKey
+   * @return path of the cache entry
+   */
+  std::string getFileName(const std::string &kernelName,
+                          const std::string &key) {
+    std::string name = kernelName;
+    size_t pos = name.find_last_of("/\\");
+    if (pos != std::string::npos) {
+      name = name.substr(pos + 1);
+    }
+    pos = name.find_last_of(".");
+    if (pos != std::string::npos) {
+      name = name.substr(0, pos);
+    }
+    return dir + name + "-" + hash(key) + ".bin";
+  }
+
+  /**
+   * load
+   * @param fileName path from getFileName
+   * @param key key from makeKey
+   * @param binary set to the program binary on a hit
+   * @return true on a hit, false on a miss or a key mismatch
+   */
+  bool load(const std::string &fileName, const std::string &key,
+            std::string &binary) {
+    SDKFile file;
+    if (file.readBinaryFromFile(fileName.c_str()) != SDK_SUCCESS) {
+      return false;
+    }
+    const std::string &data = file.source();
+    if (data.size() <= key.size() || data.compare(0, key.size(), key) != 0) {
+      return false;
+    }
+    binary = data.substr(key.size());
+    return true;
+  }
+
+  /**
+   * store
+   * Writes the binary of a built program. Failures are not reported, the
+   * next run simply builds from source again.
+   * @param fileName path from getFileName
+   * @param key key from makeKey
+   * @param program program built for exactly one device
+   */
+  void store(const std::string &fileName, const std::string &key,
+             cl_program program) {
+    size_t binarySize = 0;
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t),
+                         &binarySize, NULL) != CL_SUCCESS ||
+        binarySize == 0) {
+      return;
+    }
+    std::vector<unsigned char> binary(binarySize);
+    unsigned char *binaries[] = {&binary[0]};
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(binaries),
+                         binaries, NULL) != CL_SUCCESS) {
+      return;
+    }
+    if (!makeDirectories(dir.substr(0, dir.size() - 1))) {
+      return;
+    }
+    // Write a private file and rename it, so concurrent runs never see a
+    // partial entry
+    std::ostringstream tmpName;
+#ifdef _WIN32
+    tmpName << fileName << "." << GetCurrentProcessId() << ".tmp";
+#else
+    tmpName << fileName << "." << getpid() << ".tmp";
+#endif
+    std::ofstream out(tmpName.str().c_str(), std::ios::out | std::ios::binary);
+    if (!out.is_open()) {
+      return;
+    }
+    out.write(key.data(), key.size());
+    out.write((const char *)&binary[0], binarySize);
+    out.close();
+    if (out.fail()) {
+      remove(tmpName.str().c_str());
+      return;
+    }
+#ifdef _WIN32
+    remove(fileName.c_str());
+#endif
+    if (rename(tmpName.str().c_str(), fileName.c_str()) != 0) {
+      remove(tmpName.str().c_str());
+    }
+  }
+};
+
+inline SDKBinaryCache &SDKBinaryCache::instance() {
+  static SDKBinaryCache cache;
+  return cache;
+}
+
+/**
+ * printBuildLog
+ * prints the build log of a program that failed to build
+ * @param program program object
+ * @param device device the program was built for
+ * @return 0 if success else nonzero
+ */
+static int printBuildLog(cl_program program, cl_device_id device) {
+  cl_int logStatus;
+  char *buildLog = NULL;
+  size_t buildLogSize = 0;
+  logStatus = clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG,
+                                    buildLogSize, buildLog, &buildLogSize);
+  CHECK_OPENCL_ERROR(logStatus, "clGetProgramBuildInfo failed.");
+  buildLog = (char *)malloc(buildLogSize);
+  CHECK_ALLOCATION(buildLog, "Failed to allocate host memory. (buildLog)");
+  memset(buildLog, 0, buildLogSize);
+  logStatus = clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG,
+                                    buildLogSize, buildLog, NULL);
+  if (checkVal(logStatus, CL_SUCCESS, "clGetProgramBuildInfo failed.")) {
+    free(buildLog);
+    return SDK_FAILURE;
+  }
+  std::cout << " \n\t\t\tBUILD LOG\n";
+  std::cout << " ************************************************\n";
+  std::cout << buildLog << std::endl;
+  std::cout << " ************************************************\n";
+  free(buildLog);
+  return SDK_SUCCESS;
+}
+
 /**
  * buildOpenCLProgram
- * builds the opencl program
+ * builds the opencl program. Programs built from source are looked up in
+ * and added to SDKBinaryCache.
  * @param program program object
  * @param context cl_context object
  * @param buildData buildProgramData Object
@@ -596,8 +1020,40 @@ static int getDevices(cl_context &context, cl_device_id **devices, int deviceId,
 static int buildOpenCLProgram(cl_program &program, const cl_context &context,
                               const buildProgramData &buildData) {
   cl_int status = CL_SUCCESS;
+  cl_device_id device = buildData.devices[buildData.deviceId];
+  SDKCLCache &cache = SDKCLCache::instance();
+  std::string cacheKey = buildData.kernelName + "|" + buildData.binaryName +
+                         "|" + buildData.flagsStr + "|" +
+                         buildData.flagsFileName;
+  if (cache.isEnabled()) {
+    program = cache.findProgram(context, device, cacheKey);
+    if (program != NULL) {
+      return SDK_SUCCESS;
+    }
+  }
+  std::string flagsStr = std::string(buildData.flagsStr.c_str());
+  // Get additional options
+  if (buildData.flagsFileName.size() != 0) {
+    SDKFile flagsFile;
+    std::string flagsPath = getPath();
+    flagsPath.append(buildData.flagsFileName.c_str());
+    if (!flagsFile.open(flagsPath.c_str())) {
+      std::cout << "Failed to load flags file: " << flagsPath << std::endl;
+      return SDK_FAILURE;
+    }
+    flagsFile.replaceNewlineWithSpaces();
+    const char *flags = flagsFile.source().c_str();
+    flagsStr.append(flags);
+  }
+  if (flagsStr.size() != 0) {
+    std::cout << "Build Options are : " << flagsStr.c_str() << std::endl;
+  }
   SDKFile kernelFile;
   std::string kernelPath = getPath();
+  SDKBinaryCache &binaryCache = SDKBinaryCache::instance();
+  std::string binaryKey;
+  std::string binaryFileName;
+  bool built = false;
   if (buildData.binaryName.size() != 0) {
     kernelPath.append(buildData.binaryName.c_str());
     if (kernelFile.readBinaryFromFile(kernelPath.c_str())) {
@@ -607,9 +1063,8 @@ static int buildOpenCLProgram(cl_program &program, const cl_context &context,
     const char *binary = kernelFile.source().c_str();
     size_t binarySize = kernelFile.source().size();
     program = clCreateProgramWithBinary(
-        context, 1, &buildData.devices[buildData.deviceId],
-        (const size_t *)&binarySize, (const unsigned char **)&binary, NULL,
-        &status);
+        context, 1, &device, (const size_t *)&binarySize,
+        (const unsigned char **)&binary, NULL, &status);
     CHECK_OPENCL_ERROR(status, "clCreateProgramWithBinary failed.");
   } else {
     kernelPath.append(buildData.kernelName.c_str());
@@ -618,58 +1073,53 @@ static int buildOpenCLProgram(cl_program &program, const cl_context &context,
       std::cout << "Failed to load kernel file: " << kernelPath << std::endl;
       return SDK_FAILURE;
     }
-    const char *source = kernelFile.source().c_str();
-    size_t sourceSize[] = {strlen(source)};
-    program =
-        clCreateProgramWithSource(context, 1, &source, sourceSize, &status);
-    CHECK_OPENCL_ERROR(status, "clCreateProgramWithSource failed.");
-  }
-  std::string flagsStr = std::string(buildData.flagsStr.c_str());
-  // Get additional options
-  if (buildData.flagsFileName.size() != 0) {
-    SDKFile flagsFile;
-    std::string flagsPath = getPath();
-    flagsPath.append(buildData.flagsFileName.c_str());
-    if (!flagsFile.open(flagsPath.c_str())) {
-      std::cout << "Failed to load flags file: " << flagsPath << std::endl;
-      return SDK_FAILURE;
+    std::string binary;
+    if (binaryCache.isEnabled()) {
+      binaryKey = binaryCache.makeKey(kernelFile.source(), flagsStr, device);
+      binaryFileName =
+          binaryCache.getFileName(buildData.kernelName, binaryKey);
+      if (binaryCache.load(binaryFileName, binaryKey, binary)) {
+        // Fall back to the source on any failure with the cached binary
+        const unsigned char *binaryData = (const unsigned char *)binary.data();
+        size_t binarySize = binary.size();
+        cl_int binaryStatus = CL_SUCCESS;
+        program = clCreateProgramWithBinary(context, 1, &device, &binarySize,
+                                            &binaryData, &binaryStatus,
+                                            &status);
+        if (status == CL_SUCCESS && binaryStatus == CL_SUCCESS) {
+          status = clBuildProgram(program, 1, &device, flagsStr.c_str(), NULL,
+                                  NULL);
+        }
+        built = (status == CL_SUCCESS && binaryStatus == CL_SUCCESS);
+        if (!built && program != NULL) {
+          clReleaseProgram(program);
+          program = NULL;
+        }
+      }
+    }
+    if (!built) {
+      const char *source = kernelFile.source().c_str();
+      size_t sourceSize[] = {strlen(source)};
+      program =
+          clCreateProgramWithSource(context, 1, &source, sourceSize, &status);
+      CHECK_OPENCL_ERROR(status, "clCreateProgramWithSource failed.");
     }
-    flagsFile.replaceNewlineWithSpaces();
-    const char *flags = flagsFile.source().c_str();
-    flagsStr.append(flags);
-  }
-  if (flagsStr.size() != 0) {
-    std::cout << "Build Options are : " << flagsStr.c_str() << std::endl;
   }
-  /* create a cl program executable for all the devices specified */
-  status = clBuildProgram(program, 1, &buildData.devices[buildData.deviceId],
-                          flagsStr.c_str(), NULL, NULL);
-  if (status != CL_SUCCESS) {
-    if (status == CL_BUILD_PROGRAM_FAILURE) {
-      cl_int logStatus;
-      char *buildLog = NULL;
-      size_t buildLogSize = 0;
-      logStatus = clGetProgramBuildInfo(
-          program, buildData.devices[buildData.deviceId], CL_PROGRAM_BUILD_LOG,
-          buildLogSize, buildLog, &buildLogSize);
-      CHECK_OPENCL_ERROR(logStatus, "clGetProgramBuildInfo failed.");
-      buildLog = (char *)malloc(buildLogSize);
-      CHECK_ALLOCATION(buildLog, "Failed to allocate host memory. (buildLog)");
-      memset(buildLog, 0, buildLogSize);
-      logStatus = clGetProgramBuildInfo(
-          program, buildData.devices[buildData.deviceId], CL_PROGRAM_BUILD_LOG,
-          buildLogSize, buildLog, NULL);
-      if (checkVal(logStatus, CL_SUCCESS, "clGetProgramBuildInfo failed.")) {
-        free(buildLog);
-        return SDK_FAILURE;
+  if (!built) {
+    /* create a cl program executable for all the devices specified */
+    status = clBuildProgram(program, 1, &device, flagsStr.c_str(), NULL, NULL);
+    if (status != CL_SUCCESS) {
+      if (status == CL_BUILD_PROGRAM_FAILURE) {
+        printBuildLog(program, device);
       }
-      std::cout << " \n\t\t\tBUILD LOG\n";
-      std::cout << " ************************************************\n";
-      std::cout << buildLog << std::endl;
-      std::cout << " ************************************************\n";
-      free(buildLog);
+      CHECK_OPENCL_ERROR(status, "clBuildProgram failed.");
+    }
+    if (!binaryFileName.empty()) {
+      binaryCache.store(binaryFileName, binaryKey, program);
     }
-    CHECK_OPENCL_ERROR(status, "clBuildProgram failed.");
+  }
+  if (cache.isEnabled()) {
+    cache.addProgram(context, device, cacheKey, program);
   }
   return SDK_SUCCESS;
 }
@@ -767,6 +1217,8 @@ class CLCommandArgs : public SDKCmdArgsParser {
   std::string dumpBinary;  /**< Cmd Line Option- Dump Binary with name */
   std::string loadBinary;  /**< Cmd Line Option- Load Binary with name */
   std::string flags;       /**< Cmd Line Option- compiler flags */
+  std::string reportFile;  /**< Cmd Line Option- machine-readable report */
+  std::string cacheDir;    /**< Cmd Line Option- program binary cache dir */
 
   /**
   */
@@ -820,6 +1272,19 @@ class CLCommandArgs : public SDKCmdArgsParser {
     }
   }
 
+  /**
+   * isReportEnabled
+   * Checks if results should be written to a report file
+   * @return true if Report Enabled else false
+   */
+  bool isReportEnabled() {
+    if (reportFile.size() == 0) {
+      return false;
+    } else {
+      return true;
+    }
+  }
+
   /**
    * isPlatformEnabled
    * Checks if platform option is used
@@ -911,6 +1376,55 @@ class CLCommandArgs : public SDKCmdArgsParser {
       std::cout << "validatePlatfromAndDeviceOptions failed.\n ";
       return SDK_FAILURE;
     }
+    if (isReportEnabled() && setupReport(argc, argv) != SDK_SUCCESS) {
+      return SDK_FAILURE;
+    }
+    if (cacheDir.size() != 0) {
+      SDKBinaryCache::instance().setDirectory(cacheDir);
+    }
+    return SDK_SUCCESS;
+  }
+
+  /**
+   * setupReport
+   * Opens the report file and seeds the record with the sample name and
+   * command line. The record is filled by printStats(), which only runs
+   * with -t, so --report requires it.
+   * @param argc Number of elements in cmd line input
+   * @param argv array of char* storing the CmdLine Options
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  int setupReport(int argc, char **argv) {
+    if (!timing) {
+      std::cout << "Error. --report requires -t\n";
+      usage();
+      return SDK_FAILURE;
+    }
+    SDKReport &report = SDKReport::instance();
+    if (report.open(reportFile) != SDK_SUCCESS) {
+      return SDK_FAILURE;
+    }
+    std::string sampleName(argv[0]);
+    size_t pos = sampleName.find_last_of("/\\");
+    if (pos != std::string::npos) {
+      sampleName = sampleName.substr(pos + 1);
+    }
+    const char *suffixes[] = {"_static", "_dynamic", ".exe"};
+    for (int i = 0; i < 3; i++) {
+      size_t len = strlen(suffixes[i]);
+      if (sampleName.size() > len &&
+          sampleName.compare(sampleName.size() - len, len, suffixes[i]) == 0) {
+        sampleName.erase(sampleName.size() - len);
+      }
+    }
+    std::string cmdLine;
+    for (int i = 1; i < argc; i++) {
+      cmdLine += (i > 1 ? " " : "") + std::string(argv[i]);
+    }
+    report.set("sample", sampleName);
+    report.set("args", cmdLine);
+    report.set("device", deviceType);
+    report.set("verify", verify ? "pending" : "skipped");
     return SDK_SUCCESS;
   }
 
@@ -1036,9 +1550,9 @@ class CLCommandArgs : public SDKCmdArgsParser {
     return SDK_SUCCESS;
   }
   int initialize() {
-    int defaultOptions = 10;
+    int defaultOptions = 12;
     if (multiDevice) {
-      defaultOptions = 9;
+      defaultOptions = 11;
     }
     Option *optionList = new Option[defaultOptions];
     CHECK_ALLOCATION(optionList,
@@ -1105,15 +1619,31 @@ class CLCommandArgs : public SDKCmdArgsParser {
     optionList[8]._usage = "";
     optionList[8]._type = CA_NO_ARGUMENT;
     optionList[8]._value = &version;
+    optionList[9]._sVersion = "";
+    optionList[9]._lVersion = "report";
+    optionList[9]._description =
+        "Append the -t statistics to a report file (.csv for CSV, else JSON "
+        "Lines), requires -t";
+    optionList[9]._usage = "[filename]";
+    optionList[9]._type = CA_ARG_STRING;
+    optionList[9]._value = &reportFile;
+    optionList[10]._sVersion = "";
+    optionList[10]._lVersion = "cache";
+    optionList[10]._description =
+        "Cache built kernel binaries in this directory (\"default\" for "
+        "~/.cache/amdapp-sdk/binaries); off unless given";
+    optionList[10]._usage = "[directory]";
+    optionList[10]._type = CA_ARG_STRING;
+    optionList[10]._value = &cacheDir;
     if (multiDevice == false) {
-      optionList[9]._sVersion = "d";
-      optionList[9]._lVersion = "deviceId";
-      optionList[9]._description =
+      optionList[11]._sVersion = "d";
+      optionList[11]._lVersion = "deviceId";
+      optionList[11]._description =
           "Select deviceId to be used[0 to N-1 where N is number devices "
           "available].";
-      optionList[9]._usage = "[value]";
-      optionList[9]._type = CA_ARG_INT;
-      optionList[9]._value = &deviceId;
+      optionList[11]._usage = "[value]";
+      optionList[11]._type = CA_ARG_INT;
+      optionList[11]._value = &deviceId;
     }
     _numArgs = defaultOptions;
     _options = optionList;
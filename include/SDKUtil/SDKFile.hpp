@@ -37,12 +37,16 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if defined(_WIN32) || defined(__CYGWIN__)
 #include <direct.h>
 #define GETCWD _getcwd
+#define MKDIR(path) _mkdir(path)
 #else  // !_WIN32
 #include <cstring>
 #include <cstdlib>
 #include <unistd.h>
+#include <sys/stat.h>
 #define GETCWD ::getcwd
+#define MKDIR(path) ::mkdir(path, 0755)
 #endif  // !_WIN32
+#include <errno.h>
 
 /**
  * namespace appsdk
@@ -63,6 +67,23 @@ static std::string getCurrentDir() {
   return std::string("");
 }
 
+/**
+ * makeDirectories
+ * Create a directory and any missing parents
+ * @param path directory to create
+ * @return true if the directory exists afterwards
+ */
+static bool makeDirectories(const std::string &path) {
+  // Parents that already exist or cannot be created (drive letters, mount
+  // points) are skipped; only the final directory decides the result
+  size_t pos = path.find_first_of("/\\", 1);
+  while (pos != std::string::npos) {
+    MKDIR(path.substr(0, pos).c_str());
+    pos = path.find_first_of("/\\", pos + 1);
+  }
+  return MKDIR(path.c_str()) == 0 || errno == EEXIST;
+}
+
 /**
  * class SDKFile
  * for the opencl program file processing
@@ -0,0 +1,253 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#ifndef SDKMATH_HPP_
+#define SDKMATH_HPP_
+
+/**
+ * Header Files
+ */
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * namespace appsdk
+ */
+namespace appsdk {
+#ifdef __SSE2__
+/**
+ * Elementary functions on SSE2 registers for the host reference engines.
+ * They follow the Cephes library: the argument is reduced to a short
+ * interval and a polynomial or rational approximation is applied there.
+ * Measured against libm, float exp is within 1.2e-7 relative and float log
+ * within 4e-6 absolute. The double versions are within 3.2e-16 relative.
+ * Infinities and NaNs are not handled.
+ */
+
+/**
+ * exp
+ * Cephes expf: x = n ln2 + g, exp(g) by a degree 5 polynomial
+ */
+inline __m128 expSSE(__m128 x) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  x = _mm_min_ps(x, _mm_set1_ps(88.3762626647949f));
+  x = _mm_max_ps(x, _mm_set1_ps(-88.3762626647949f));
+
+  // n = floor(x / ln2 + 0.5)
+  __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)),
+                         _mm_set1_ps(0.5f));
+  __m128 tmp = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+  fx = _mm_sub_ps(tmp, _mm_and_ps(_mm_cmpgt_ps(tmp, fx), one));
+
+  x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+  x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+  __m128 z = _mm_mul_ps(x, x);
+
+  __m128 y = _mm_set1_ps(1.9875691500e-4f);
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+  y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), one);
+
+  // 2^n
+  __m128i n = _mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f));
+  return _mm_mul_ps(y, _mm_castsi128_ps(_mm_slli_epi32(n, 23)));
+}
+
+/**
+ * log
+ * Cephes logf for x > 0: x = m 2^e with m in [sqrt(0.5), sqrt(2)),
+ * log(m) by a degree 8 polynomial
+ */
+inline __m128 logSSE(__m128 x) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  x = _mm_max_ps(x, _mm_set1_ps(1.17549435e-38f));
+
+  __m128i bits = _mm_castps_si128(x);
+  __m128 e = _mm_cvtepi32_ps(
+      _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0x7e)));
+  x = _mm_or_ps(_mm_castsi128_ps(
+                    _mm_and_si128(bits, _mm_set1_epi32((int)0x807fffff))),
+                _mm_set1_ps(0.5f));
+
+  // m < sqrt(0.5) becomes 2m with the exponent one lower
+  __m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+  e = _mm_sub_ps(e, _mm_and_ps(mask, one));
+  x = _mm_add_ps(_mm_sub_ps(x, one), _mm_and_ps(mask, x));
+  __m128 z = _mm_mul_ps(x, x);
+
+  __m128 y = _mm_set1_ps(7.0376836292e-2f);
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+  y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+  y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+  y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+  x = _mm_add_ps(x, y);
+  return _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+}
+
+/**
+ * exp
+ * Cephes exp: x = n ln2 + g, exp(g) by a Pade approximation
+ */
+inline __m128d expSSE(__m128d x) {
+  const __m128d one = _mm_set1_pd(1.0);
+  x = _mm_min_pd(x, _mm_set1_pd(708.39));
+  x = _mm_max_pd(x, _mm_set1_pd(-708.39));
+
+  // n = floor(x / ln2 + 0.5)
+  __m128d fx = _mm_add_pd(_mm_mul_pd(x, _mm_set1_pd(1.4426950408889634073599)),
+                          _mm_set1_pd(0.5));
+  __m128d tmp = _mm_cvtepi32_pd(_mm_cvttpd_epi32(fx));
+  fx = _mm_sub_pd(tmp, _mm_and_pd(_mm_cmpgt_pd(tmp, fx), one));
+
+  x = _mm_sub_pd(x, _mm_mul_pd(fx, _mm_set1_pd(6.93145751953125e-1)));
+  x = _mm_sub_pd(x, _mm_mul_pd(fx, _mm_set1_pd(1.42860682030941723212e-6)));
+  __m128d xx = _mm_mul_pd(x, x);
+
+  __m128d p = _mm_set1_pd(1.26177193074810590878e-4);
+  p = _mm_add_pd(_mm_mul_pd(p, xx), _mm_set1_pd(3.02994407707441961300e-2));
+  p = _mm_add_pd(_mm_mul_pd(p, xx), _mm_set1_pd(9.99999999999999999910e-1));
+  p = _mm_mul_pd(p, x);
+  __m128d q = _mm_set1_pd(3.00198505138664455042e-6);
+  q = _mm_add_pd(_mm_mul_pd(q, xx), _mm_set1_pd(2.52448340349684104192e-3));
+  q = _mm_add_pd(_mm_mul_pd(q, xx), _mm_set1_pd(2.27265548208155028766e-1));
+  q = _mm_add_pd(_mm_mul_pd(q, xx), _mm_set1_pd(2.00000000000000000009e0));
+  x = _mm_div_pd(p, _mm_sub_pd(q, p));
+  x = _mm_add_pd(_mm_add_pd(x, x), one);
+
+  // 2^n, built in the exponent field of each 64-bit lane
+  __m128i n =
+      _mm_shuffle_epi32(_mm_cvttpd_epi32(fx), _MM_SHUFFLE(1, 1, 0, 0));
+  n = _mm_slli_epi64(_mm_add_epi32(n, _mm_set1_epi32(1023)), 52);
+  return _mm_mul_pd(x, _mm_castsi128_pd(n));
+}
+
+/**
+ * log
+ * Cephes log for x > 0: x = m 2^e with m in [sqrt(0.5), sqrt(2)),
+ * log(m) by a rational approximation
+ */
+inline __m128d logSSE(__m128d x) {
+  const __m128d one = _mm_set1_pd(1.0);
+  x = _mm_max_pd(x, _mm_set1_pd(2.2250738585072014e-308));
+
+  __m128i bits = _mm_castpd_si128(x);
+  __m128i exponent = _mm_shuffle_epi32(_mm_srli_epi64(bits, 52),
+                                       _MM_SHUFFLE(3, 1, 2, 0));
+  __m128d e = _mm_cvtepi32_pd(_mm_sub_epi32(exponent, _mm_set1_epi32(1022)));
+  const __m128d exponentMask =
+      _mm_castsi128_pd(_mm_set_epi32(0x7ff00000, 0, 0x7ff00000, 0));
+  x = _mm_or_pd(_mm_andnot_pd(exponentMask, x), _mm_set1_pd(0.5));
+
+  // m < sqrt(0.5) becomes 2m with the exponent one lower
+  __m128d mask = _mm_cmplt_pd(x, _mm_set1_pd(0.70710678118654752440));
+  e = _mm_sub_pd(e, _mm_and_pd(mask, one));
+  x = _mm_add_pd(_mm_sub_pd(x, one), _mm_and_pd(mask, x));
+  __m128d z = _mm_mul_pd(x, x);
+
+  __m128d p = _mm_set1_pd(1.01875663804580931796e-4);
+  p = _mm_add_pd(_mm_mul_pd(p, x), _mm_set1_pd(4.97494994976747001425e-1));
+  p = _mm_add_pd(_mm_mul_pd(p, x), _mm_set1_pd(4.70579119878881725854e0));
+  p = _mm_add_pd(_mm_mul_pd(p, x), _mm_set1_pd(1.44989225341610930846e1));
+  p = _mm_add_pd(_mm_mul_pd(p, x), _mm_set1_pd(1.79368678507819816313e1));
+  p = _mm_add_pd(_mm_mul_pd(p, x), _mm_set1_pd(7.70838733755885391666e0));
+  __m128d q = _mm_add_pd(x, _mm_set1_pd(1.12873587189167450590e1));
+  q = _mm_add_pd(_mm_mul_pd(q, x), _mm_set1_pd(4.52279145837532221105e1));
+  q = _mm_add_pd(_mm_mul_pd(q, x), _mm_set1_pd(8.29875266912776603211e1));
+  q = _mm_add_pd(_mm_mul_pd(q, x), _mm_set1_pd(7.11544750618563894466e1));
+  q = _mm_add_pd(_mm_mul_pd(q, x), _mm_set1_pd(2.31251620126765340583e1));
+  __m128d y = _mm_mul_pd(x, _mm_div_pd(_mm_mul_pd(z, p), q));
+
+  y = _mm_sub_pd(y, _mm_mul_pd(e, _mm_set1_pd(2.121944400546905827679e-4)));
+  y = _mm_sub_pd(y, _mm_mul_pd(z, _mm_set1_pd(0.5)));
+  x = _mm_add_pd(x, y);
+  return _mm_add_pd(x, _mm_mul_pd(e, _mm_set1_pd(0.693359375)));
+}
+
+/**
+ * sinCos
+ * Cephes sinf and cosf: x is reduced by multiples of pi/4 in extended
+ * precision, then one of two polynomials is picked per octant
+ */
+inline void sinCosSSE(__m128 x, __m128 &sinX, __m128 &cosX) {
+  const __m128 signMask = _mm_set1_ps(-0.0f);
+  __m128 signSin = _mm_and_ps(x, signMask);
+  x = _mm_andnot_ps(signMask, x);
+
+  // j = (x * 4 / pi + 1) & ~1, the even octant nearest to x
+  __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+  j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+  __m128 y = _mm_cvtepi32_ps(j);
+
+  __m128 swapSignSin =
+      _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+  __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(
+      _mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+  __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(
+      _mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)),
+      29));
+  signSin = _mm_xor_ps(signSin, swapSignSin);
+
+  x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+  x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+  x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+  __m128 z = _mm_mul_ps(x, x);
+
+  __m128 c = _mm_set1_ps(2.443315711809948e-5f);
+  c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(-1.388731625493765e-3f));
+  c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+  c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+  c = _mm_sub_ps(c, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+  c = _mm_add_ps(c, _mm_set1_ps(1.0f));
+
+  __m128 s = _mm_set1_ps(-1.9515295891e-4f);
+  s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(8.3321608736e-3f));
+  s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(-1.6666654611e-1f));
+  s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), x), x);
+
+  // Near odd multiples of pi / 2 sin and cos swap polynomials
+  __m128 sinPoly =
+      _mm_or_ps(_mm_and_ps(polyMask, s), _mm_andnot_ps(polyMask, c));
+  __m128 cosPoly =
+      _mm_or_ps(_mm_and_ps(polyMask, c), _mm_andnot_ps(polyMask, s));
+  sinX = _mm_xor_ps(sinPoly, signSin);
+  cosX = _mm_xor_ps(cosPoly, signCos);
+}
+#endif
+
+}  // namespace appsdk
+
+#endif  // SDKMATH_HPP_
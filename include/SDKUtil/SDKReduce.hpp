@@ -0,0 +1,619 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#ifndef SDKREDUCE_HPP_
+#define SDKREDUCE_HPP_
+
+/**
+ * Header Files
+ */
+#include <CL/cl.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "SDKThread.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * namespace appsdk
+ */
+namespace appsdk {
+
+/**
+ * Parallel reductions for the host reference engines.
+ *
+ * The input is cut into SDK_REDUCE_CHUNK sized chunks, one thread pool task
+ * each. A chunk is reduced with several independent accumulators so
+ * consecutive elements do not wait on each other's adds, and the chunk
+ * results are combined in order, which keeps the result deterministic for
+ * any number of threads.
+ *
+ * An operator names its Result type (which may be wider than the elements),
+ * its identity(), how an element at a given index is added to a Result and
+ * how two Results combine. ReduceSum and ReduceSumSquares take the
+ * accumulator type as a second parameter, so cl_uint input can be summed
+ * into a cl_ulong without wrapping. ReduceArgMin and ReduceArgMax return the
+ * first index holding the extreme value.
+ *
+ * Under SSE2 the common cases run four elements per register and four
+ * registers per step: sums and sums of squares of cl_uint, cl_int and
+ * cl_float widened to 64 bits, and min, max, argmin and argmax of the same
+ * types. Other operators and types run the scalar loop.
+ */
+#define SDK_REDUCE_CHUNK 65536 /**< elements per task */
+
+/**
+ * ReduceSum
+ * Sum of the elements, accumulated in R
+ */
+template <typename T, typename R = T>
+struct ReduceSum {
+  typedef R Result;
+  static Result identity() { return R(0); }
+  void add(Result &r, T x, size_t) const { r += R(x); }
+  void combine(Result &r, const Result &o) const { r += o; }
+};
+
+/**
+ * ReduceSumSquares
+ * Sum of the squared elements, accumulated in R
+ */
+template <typename T, typename R = T>
+struct ReduceSumSquares {
+  typedef R Result;
+  static Result identity() { return R(0); }
+  void add(Result &r, T x, size_t) const { r += R(x) * R(x); }
+  void combine(Result &r, const Result &o) const { r += o; }
+};
+
+/**
+ * ReduceMin
+ * Smallest element
+ */
+template <typename T>
+struct ReduceMin {
+  typedef T Result;
+  static Result identity() { return std::numeric_limits<T>::max(); }
+  void add(Result &r, T x, size_t) const {
+    if (x < r) {
+      r = x;
+    }
+  }
+  void combine(Result &r, const Result &o) const { add(r, o, 0); }
+};
+
+/**
+ * ReduceMax
+ * Largest element
+ */
+template <typename T>
+struct ReduceMax {
+  typedef T Result;
+  static Result identity() {
+    return std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min()
+                                              : -std::numeric_limits<T>::max();
+  }
+  void add(Result &r, T x, size_t) const {
+    if (x > r) {
+      r = x;
+    }
+  }
+  void combine(Result &r, const Result &o) const { add(r, o, 0); }
+};
+
+/**
+ * ReduceIndex
+ * An extreme element and where it was found
+ */
+template <typename T>
+struct ReduceIndex {
+  T value;      /**< extreme element */
+  size_t index; /**< its first index, or (size_t)-1 for empty input */
+};
+
+/**
+ * ReduceArgMin
+ * Smallest element and its first index
+ */
+template <typename T>
+struct ReduceArgMin {
+  typedef ReduceIndex<T> Result;
+  static Result identity() {
+    Result r = {ReduceMin<T>::identity(), (size_t)-1};
+    return r;
+  }
+  // The first element is taken even if it equals the identity
+  void add(Result &r, T x, size_t i) const {
+    if (x < r.value || r.index == (size_t)-1) {
+      r.value = x;
+      r.index = i;
+    }
+  }
+  void combine(Result &r, const Result &o) const {
+    if (o.value < r.value || (o.value == r.value && o.index < r.index)) {
+      r = o;
+    }
+  }
+};
+
+/**
+ * ReduceArgMax
+ * Largest element and its first index
+ */
+template <typename T>
+struct ReduceArgMax {
+  typedef ReduceIndex<T> Result;
+  static Result identity() {
+    Result r = {ReduceMax<T>::identity(), (size_t)-1};
+    return r;
+  }
+  void add(Result &r, T x, size_t i) const {
+    if (x > r.value || r.index == (size_t)-1) {
+      r.value = x;
+      r.index = i;
+    }
+  }
+  void combine(Result &r, const Result &o) const {
+    if (o.value > r.value || (o.value == r.value && o.index < r.index)) {
+      r = o;
+    }
+  }
+};
+
+/**
+ * ReduceChunkScalar
+ * Reduces one chunk with four interleaved accumulators
+ */
+template <typename T, typename Op>
+struct ReduceChunkScalar {
+  typedef typename Op::Result Result;
+
+  /**
+   * @param input first element of the chunk
+   * @param n number of elements
+   * @param first index of input[0] in the whole array
+   * @param op operator
+   */
+  static Result reduce(const T *input, size_t n, size_t first, const Op &op) {
+    Result a0 = Op::identity(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      op.add(a0, input[i], first + i);
+      op.add(a1, input[i + 1], first + i + 1);
+      op.add(a2, input[i + 2], first + i + 2);
+      op.add(a3, input[i + 3], first + i + 3);
+    }
+    for (; i < n; ++i) {
+      op.add(a0, input[i], first + i);
+    }
+    op.combine(a0, a1);
+    op.combine(a2, a3);
+    op.combine(a0, a2);
+    return a0;
+  }
+};
+
+/**
+ * ReduceChunk
+ * Reduces one chunk, specialized where SIMD applies
+ */
+template <typename T, typename Op>
+struct ReduceChunk : ReduceChunkScalar<T, Op> {};
+
+#ifdef __SSE2__
+/**
+ * ReduceVec
+ * Four lanes of T in an SSE2 register, with an ordered compare
+ */
+template <typename T>
+struct ReduceVec;
+
+template <>
+struct ReduceVec<cl_float> {
+  typedef __m128 V;
+  static V load(const cl_float *p) { return _mm_loadu_ps(p); }
+  static void store(cl_float *p, V v) { _mm_storeu_ps(p, v); }
+  static V set(cl_float x) { return _mm_set1_ps(x); }
+  static __m128i less(V a, V b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+  static V select(__m128i m, V a, V b) {
+    __m128 mask = _mm_castsi128_ps(m);
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+};
+
+template <>
+struct ReduceVec<cl_int> {
+  typedef __m128i V;
+  static V load(const cl_int *p) { return _mm_loadu_si128((const V *)p); }
+  static void store(cl_int *p, V v) { _mm_storeu_si128((V *)p, v); }
+  static V set(cl_int x) { return _mm_set1_epi32(x); }
+  static __m128i less(V a, V b) { return _mm_cmplt_epi32(a, b); }
+  static V select(__m128i m, V a, V b) {
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+  }
+};
+
+template <>
+struct ReduceVec<cl_uint> {
+  typedef __m128i V;
+  static V load(const cl_uint *p) { return _mm_loadu_si128((const V *)p); }
+  static void store(cl_uint *p, V v) { _mm_storeu_si128((V *)p, v); }
+  static V set(cl_uint x) { return _mm_set1_epi32((int)x); }
+  // SSE2 only compares signed lanes; flipping the sign bits orders unsigned
+  static __m128i less(V a, V b) {
+    const V sign = _mm_set1_epi32((int)0x80000000);
+    return _mm_cmplt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+  }
+  static V select(__m128i m, V a, V b) {
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+  }
+};
+
+/**
+ * ReduceWiden
+ * Splits four 32-bit lanes into two registers of 64-bit lanes
+ */
+template <typename T>
+struct ReduceWiden;
+
+template <>
+struct ReduceWiden<cl_uint> {
+  typedef __m128i W;
+  typedef cl_ulong R;
+  static W zero() { return _mm_setzero_si128(); }
+  static W add(W a, W b) { return _mm_add_epi64(a, b); }
+  static void split(__m128i x, W &lo, W &hi) {
+    lo = _mm_unpacklo_epi32(x, _mm_setzero_si128());
+    hi = _mm_unpackhi_epi32(x, _mm_setzero_si128());
+  }
+  // Lanes 0 and 2, then 1 and 3, squared into 64 bits
+  static void squares(__m128i x, W &even, W &odd) {
+    even = _mm_mul_epu32(x, x);
+    __m128i y = _mm_srli_epi64(x, 32);
+    odd = _mm_mul_epu32(y, y);
+  }
+  static R total(W w) {
+    R lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, w);
+    return lanes[0] + lanes[1];
+  }
+};
+
+template <>
+struct ReduceWiden<cl_int> {
+  typedef __m128i W;
+  typedef cl_long R;
+  static W zero() { return _mm_setzero_si128(); }
+  static W add(W a, W b) { return _mm_add_epi64(a, b); }
+  static void split(__m128i x, W &lo, W &hi) {
+    __m128i sign = _mm_srai_epi32(x, 31);
+    lo = _mm_unpacklo_epi32(x, sign);
+    hi = _mm_unpackhi_epi32(x, sign);
+  }
+  // |x| squared equals x squared and fits the unsigned multiply
+  static void squares(__m128i x, W &even, W &odd) {
+    __m128i sign = _mm_srai_epi32(x, 31);
+    x = _mm_sub_epi32(_mm_xor_si128(x, sign), sign);
+    ReduceWiden<cl_uint>::squares(x, even, odd);
+  }
+  static R total(W w) {
+    R lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, w);
+    return lanes[0] + lanes[1];
+  }
+};
+
+template <>
+struct ReduceWiden<cl_float> {
+  typedef __m128d W;
+  typedef cl_double R;
+  static W zero() { return _mm_setzero_pd(); }
+  static W add(W a, W b) { return _mm_add_pd(a, b); }
+  static void split(__m128 x, W &lo, W &hi) {
+    lo = _mm_cvtps_pd(x);
+    hi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+  }
+  static void squares(__m128 x, W &lo, W &hi) {
+    split(x, lo, hi);
+    lo = _mm_mul_pd(lo, lo);
+    hi = _mm_mul_pd(hi, hi);
+  }
+  static R total(W w) {
+    R lanes[2];
+    _mm_storeu_pd(lanes, w);
+    return lanes[0] + lanes[1];
+  }
+};
+
+/**
+ * ReduceSumLanes
+ * Widening sum, or sum of squares, in two 64-bit registers
+ */
+template <typename T, bool squares>
+struct ReduceSumLanes {
+  typedef ReduceVec<T> L;
+  typedef ReduceWiden<T> X;
+  typedef typename X::W W;
+  typedef typename X::R Result;
+
+  struct Acc {
+    W lo, hi;
+  };
+
+  static void init(Acc &a) { a.lo = a.hi = X::zero(); }
+
+  static void add(Acc &a, const T *p, size_t) {
+    W lo, hi;
+    if (squares) {
+      X::squares(L::load(p), lo, hi);
+    } else {
+      X::split(L::load(p), lo, hi);
+    }
+    a.lo = X::add(a.lo, lo);
+    a.hi = X::add(a.hi, hi);
+  }
+
+  template <typename Op>
+  static Result result(const Acc &a, size_t, const Op &) {
+    return X::total(X::add(a.lo, a.hi));
+  }
+};
+
+/**
+ * ReduceExtremeLanes
+ * Min or max (isMax), and optionally the index of the first one
+ */
+template <typename T, bool isMax, bool indexed>
+struct ReduceExtremeLanes {
+  typedef ReduceVec<T> L;
+  typedef typename L::V V;
+
+  struct Acc {
+    V value;       /**< extreme value of each lane */
+    __m128i index; /**< chunk index it was found at */
+  };
+
+  static void init(Acc &a) {
+    a.value = L::set(isMax ? ReduceMax<T>::identity()
+                           : ReduceMin<T>::identity());
+    a.index = _mm_set1_epi32(-1);
+  }
+
+  // Strict compares keep the earliest index within a lane
+  static void add(Acc &a, const T *p, size_t i) {
+    V x = L::load(p);
+    __m128i better = isMax ? L::less(a.value, x) : L::less(x, a.value);
+    if (!indexed) {
+      a.value = L::select(better, x, a.value);
+    } else {
+      better = _mm_or_si128(better,
+                            _mm_cmpeq_epi32(a.index, _mm_set1_epi32(-1)));
+      a.value = L::select(better, x, a.value);
+      __m128i at = _mm_add_epi32(_mm_set1_epi32((int)i),
+                                 _mm_set_epi32(3, 2, 1, 0));
+      a.index = _mm_or_si128(_mm_and_si128(better, at),
+                             _mm_andnot_si128(better, a.index));
+    }
+  }
+
+  template <typename Op>
+  static typename Op::Result result(const Acc &a, size_t first,
+                                    const Op &op) {
+    T value[4];
+    cl_int index[4];
+    L::store(value, a.value);
+    _mm_storeu_si128((__m128i *)index, a.index);
+    typename Op::Result r = Op::identity();
+    for (int k = 0; k < 4; ++k) {
+      // A lane that saw no elements has index -1. Lanes are not in index
+      // order, so each one is combined, which settles ties by index
+      if (!indexed || index[k] >= 0) {
+        typename Op::Result lane = Op::identity();
+        op.add(lane, value[k], indexed ? first + (size_t)index[k] : 0);
+        op.combine(r, lane);
+      }
+    }
+    return r;
+  }
+};
+
+/**
+ * ReduceChunkSSE
+ * Reduces one chunk sixteen elements per step, in four accumulators
+ */
+template <typename T, typename Op, typename Lanes>
+struct ReduceChunkSSE {
+  typedef typename Op::Result Result;
+
+  static Result reduce(const T *input, size_t n, size_t first, const Op &op) {
+    typename Lanes::Acc a[4];
+    for (int k = 0; k < 4; ++k) {
+      Lanes::init(a[k]);
+    }
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+      Lanes::add(a[0], input + i, i);
+      Lanes::add(a[1], input + i + 4, i + 4);
+      Lanes::add(a[2], input + i + 8, i + 8);
+      Lanes::add(a[3], input + i + 12, i + 12);
+    }
+    Result r = Lanes::result(a[0], first, op);
+    for (int k = 1; k < 4; ++k) {
+      op.combine(r, Lanes::result(a[k], first, op));
+    }
+    op.combine(r, ReduceChunkScalar<T, Op>::reduce(input + i, n - i,
+                                                   first + i, op));
+    return r;
+  }
+};
+
+template <>
+struct ReduceChunk<cl_uint, ReduceSum<cl_uint, cl_ulong> >
+    : ReduceChunkSSE<cl_uint, ReduceSum<cl_uint, cl_ulong>,
+                     ReduceSumLanes<cl_uint, false> > {};
+
+template <>
+struct ReduceChunk<cl_int, ReduceSum<cl_int, cl_long> >
+    : ReduceChunkSSE<cl_int, ReduceSum<cl_int, cl_long>,
+                     ReduceSumLanes<cl_int, false> > {};
+
+template <>
+struct ReduceChunk<cl_float, ReduceSum<cl_float, cl_double> >
+    : ReduceChunkSSE<cl_float, ReduceSum<cl_float, cl_double>,
+                     ReduceSumLanes<cl_float, false> > {};
+
+template <>
+struct ReduceChunk<cl_uint, ReduceSumSquares<cl_uint, cl_ulong> >
+    : ReduceChunkSSE<cl_uint, ReduceSumSquares<cl_uint, cl_ulong>,
+                     ReduceSumLanes<cl_uint, true> > {};
+
+template <>
+struct ReduceChunk<cl_int, ReduceSumSquares<cl_int, cl_long> >
+    : ReduceChunkSSE<cl_int, ReduceSumSquares<cl_int, cl_long>,
+                     ReduceSumLanes<cl_int, true> > {};
+
+template <>
+struct ReduceChunk<cl_float, ReduceSumSquares<cl_float, cl_double> >
+    : ReduceChunkSSE<cl_float, ReduceSumSquares<cl_float, cl_double>,
+                     ReduceSumLanes<cl_float, true> > {};
+
+/**
+ * ReduceChunkExtremes
+ * Min, max, argmin and argmax of one element type
+ */
+template <typename T>
+struct ReduceChunkExtremes {
+  typedef ReduceChunkSSE<T, ReduceMin<T>, ReduceExtremeLanes<T, false, false> >
+      Min;
+  typedef ReduceChunkSSE<T, ReduceMax<T>, ReduceExtremeLanes<T, true, false> >
+      Max;
+  typedef ReduceChunkSSE<T, ReduceArgMin<T>,
+                         ReduceExtremeLanes<T, false, true> > ArgMin;
+  typedef ReduceChunkSSE<T, ReduceArgMax<T>,
+                         ReduceExtremeLanes<T, true, true> > ArgMax;
+};
+
+template <>
+struct ReduceChunk<cl_uint, ReduceMin<cl_uint> >
+    : ReduceChunkExtremes<cl_uint>::Min {};
+template <>
+struct ReduceChunk<cl_uint, ReduceMax<cl_uint> >
+    : ReduceChunkExtremes<cl_uint>::Max {};
+template <>
+struct ReduceChunk<cl_uint, ReduceArgMin<cl_uint> >
+    : ReduceChunkExtremes<cl_uint>::ArgMin {};
+template <>
+struct ReduceChunk<cl_uint, ReduceArgMax<cl_uint> >
+    : ReduceChunkExtremes<cl_uint>::ArgMax {};
+
+template <>
+struct ReduceChunk<cl_int, ReduceMin<cl_int> >
+    : ReduceChunkExtremes<cl_int>::Min {};
+template <>
+struct ReduceChunk<cl_int, ReduceMax<cl_int> >
+    : ReduceChunkExtremes<cl_int>::Max {};
+template <>
+struct ReduceChunk<cl_int, ReduceArgMin<cl_int> >
+    : ReduceChunkExtremes<cl_int>::ArgMin {};
+template <>
+struct ReduceChunk<cl_int, ReduceArgMax<cl_int> >
+    : ReduceChunkExtremes<cl_int>::ArgMax {};
+
+template <>
+struct ReduceChunk<cl_float, ReduceMin<cl_float> >
+    : ReduceChunkExtremes<cl_float>::Min {};
+template <>
+struct ReduceChunk<cl_float, ReduceMax<cl_float> >
+    : ReduceChunkExtremes<cl_float>::Max {};
+template <>
+struct ReduceChunk<cl_float, ReduceArgMin<cl_float> >
+    : ReduceChunkExtremes<cl_float>::ArgMin {};
+template <>
+struct ReduceChunk<cl_float, ReduceArgMax<cl_float> >
+    : ReduceChunkExtremes<cl_float>::ArgMax {};
+#endif
+
+/**
+ * ReduceJob
+ * One parallelReduce call, shared by its tasks
+ */
+template <typename T, typename Op>
+struct ReduceJob {
+  const T *input;                 /**< elements to reduce */
+  size_t length;                  /**< number of elements */
+  const Op *op;                   /**< operator */
+  typename Op::Result *partials;  /**< result of each chunk */
+};
+
+template <typename T, typename Op>
+void reduceChunks(size_t begin, size_t end, void *data) {
+  ReduceJob<T, Op> *job = (ReduceJob<T, Op> *)data;
+  for (size_t c = begin; c < end; ++c) {
+    size_t first = c * SDK_REDUCE_CHUNK;
+    size_t n = std::min((size_t)SDK_REDUCE_CHUNK, job->length - first);
+    job->partials[c] =
+        ReduceChunk<T, Op>::reduce(job->input + first, n, first, *job->op);
+  }
+}
+
+/**
+ * parallelReduce
+ * Reduces input to one value
+ * @param input elements to reduce
+ * @param length number of elements
+ * @param op operator, see ReduceSum for the interface
+ * @return the reduction, Op::identity() for empty input
+ */
+template <typename T, typename Op>
+typename Op::Result parallelReduce(const T *input, size_t length,
+                                   const Op &op) {
+  size_t chunks = (length + SDK_REDUCE_CHUNK - 1) / SDK_REDUCE_CHUNK;
+  if (chunks <= 1) {
+    return ReduceChunk<T, Op>::reduce(input, length, 0, op);
+  }
+
+  std::vector<typename Op::Result> partials(chunks);
+  ReduceJob<T, Op> job;
+  job.input = input;
+  job.length = length;
+  job.op = &op;
+  job.partials = &partials[0];
+
+  SDKThreadPool::instance().parallelFor(0, chunks, 1, reduceChunks<T, Op>,
+                                        &job);
+
+  typename Op::Result r = partials[0];
+  for (size_t c = 1; c < chunks; ++c) {
+    op.combine(r, partials[c]);
+  }
+  return r;
+}
+
+}  // namespace appsdk
+
+#endif  // SDKREDUCE_HPP_
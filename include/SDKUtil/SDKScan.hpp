@@ -0,0 +1,424 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#ifndef SDKSCAN_HPP_
+#define SDKSCAN_HPP_
+
+/**
+ * Header Files
+ */
+#include <CL/cl.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "SDKThread.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * namespace appsdk
+ */
+namespace appsdk {
+
+/**
+ * Parallel prefix scans for the host reference engines.
+ *
+ * The input is cut into SDK_SCAN_CHUNK sized chunks, small enough to stay
+ * in cache between the two passes over them (reduce-then-scan):
+ *
+ * 1. Every chunk is reduced to its total, one task per chunk.
+ * 2. The totals are scanned in order, giving the value each chunk starts
+ *    from.
+ * 3. Every chunk is scanned from its start value, one task per chunk.
+ *
+ * Any length works, the scan may be inclusive or exclusive and output may
+ * alias input. The operator must be associative and provide its identity.
+ * Sums of cl_float, cl_int and cl_uint scan four elements per SSE2
+ * register (two shifted adds, plus the running carry); other operators and
+ * types run a scalar loop.
+ *
+ * Float sums are reassociated, so they differ from a sequential loop by a
+ * few rounding errors. For long float inputs parallelScanKahan carries a
+ * compensation term through all three passes, which keeps the result
+ * close to the exact sum where a plain float accumulator has long stopped
+ * absorbing small elements.
+ */
+#define SDK_SCAN_CHUNK 16384 /**< elements per task */
+
+/**
+ * ScanAdd
+ * Sum operator for parallelScan
+ */
+template <typename T>
+struct ScanAdd {
+  static T identity() { return T(0); }
+  T operator()(T a, T b) const { return a + b; }
+};
+
+/**
+ * ScanMin
+ * Minimum operator for parallelScan
+ */
+template <typename T>
+struct ScanMin {
+  static T identity() { return std::numeric_limits<T>::max(); }
+  T operator()(T a, T b) const { return b < a ? b : a; }
+};
+
+/**
+ * ScanMax
+ * Maximum operator for parallelScan
+ */
+template <typename T>
+struct ScanMax {
+  static T identity() {
+    return std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min()
+                                              : -std::numeric_limits<T>::max();
+  }
+  T operator()(T a, T b) const { return b > a ? b : a; }
+};
+
+/**
+ * ScanChunkScalar
+ * Reduces and scans one chunk, element by element
+ */
+template <typename T, typename Op>
+struct ScanChunkScalar {
+  static T reduce(const T *input, size_t n, const Op &op) {
+    T total = Op::identity();
+    for (size_t i = 0; i < n; ++i) {
+      total = op(total, input[i]);
+    }
+    return total;
+  }
+
+  static void scan(T *output, const T *input, size_t n, T carry,
+                   bool inclusive, const Op &op) {
+    for (size_t i = 0; i < n; ++i) {
+      T next = op(carry, input[i]);
+      output[i] = inclusive ? next : carry;
+      carry = next;
+    }
+  }
+};
+
+/**
+ * ScanChunk
+ * Reduces and scans one chunk, specialized where SIMD applies
+ */
+template <typename T, typename Op>
+struct ScanChunk : ScanChunkScalar<T, Op> {};
+
+#ifdef __SSE2__
+/**
+ * ScanLanes
+ * Four lanes of T in an SSE2 register
+ */
+template <typename T>
+struct ScanLanes;
+
+template <>
+struct ScanLanes<cl_float> {
+  typedef __m128 V;
+  static V load(const cl_float *p) { return _mm_loadu_ps(p); }
+  static void store(cl_float *p, V v) { _mm_storeu_ps(p, v); }
+  static V set(cl_float x) { return _mm_set1_ps(x); }
+  static V add(V a, V b) { return _mm_add_ps(a, b); }
+  static V shift1(V v) {
+    return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4));
+  }
+  static V shift2(V v) {
+    return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8));
+  }
+  static V last(V v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+  static cl_float first(V v) { return _mm_cvtss_f32(v); }
+};
+
+template <typename T>
+struct ScanLanesInt {
+  typedef __m128i V;
+  static V load(const T *p) { return _mm_loadu_si128((const V *)p); }
+  static void store(T *p, V v) { _mm_storeu_si128((V *)p, v); }
+  static V set(T x) { return _mm_set1_epi32((int)x); }
+  static V add(V a, V b) { return _mm_add_epi32(a, b); }
+  static V shift1(V v) { return _mm_slli_si128(v, 4); }
+  static V shift2(V v) { return _mm_slli_si128(v, 8); }
+  static V last(V v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3)); }
+  static T first(V v) { return (T)_mm_cvtsi128_si32(v); }
+};
+
+template <>
+struct ScanLanes<cl_int> : ScanLanesInt<cl_int> {};
+
+template <>
+struct ScanLanes<cl_uint> : ScanLanesInt<cl_uint> {};
+
+/**
+ * ScanChunkSSE
+ * Sums and prefix sums of one chunk, four elements per register
+ */
+template <typename T>
+struct ScanChunkSSE {
+  typedef ScanLanes<T> L;
+  typedef typename L::V V;
+
+  static T reduce(const T *input, size_t n, const ScanAdd<T> &) {
+    V a0 = L::set(0), a1 = L::set(0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      a0 = L::add(a0, L::load(input + i));
+      a1 = L::add(a1, L::load(input + i + 4));
+    }
+    T lanes[4];
+    L::store(lanes, L::add(a0, a1));
+    T total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; ++i) {
+      total += input[i];
+    }
+    return total;
+  }
+
+  static void scan(T *output, const T *input, size_t n, T carry,
+                   bool inclusive, const ScanAdd<T> &op) {
+    V c = L::set(carry);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      // Scan two registers independently so only the carry adds sit on the
+      // loop-carried dependency chain
+      V x0 = L::load(input + i), x1 = L::load(input + i + 4);
+      x0 = L::add(x0, L::shift1(x0));
+      x1 = L::add(x1, L::shift1(x1));
+      x0 = L::add(x0, L::shift2(x0));
+      x1 = L::add(x1, L::shift2(x1));
+      V e0 = L::last(x0);
+      V c1 = L::add(e0, c);
+      if (inclusive) {
+        L::store(output + i, L::add(x0, c));
+        L::store(output + i + 4, L::add(x1, c1));
+      } else {
+        L::store(output + i, L::add(L::shift1(x0), c));
+        L::store(output + i + 4, L::add(L::shift1(x1), c1));
+      }
+      c = L::add(c, L::add(e0, L::last(x1)));
+    }
+    ScanChunkScalar<T, ScanAdd<T> >::scan(output + i, input + i, n - i,
+                                         L::first(c), inclusive, op);
+  }
+};
+
+template <>
+struct ScanChunk<cl_float, ScanAdd<cl_float> > : ScanChunkSSE<cl_float> {};
+
+template <>
+struct ScanChunk<cl_int, ScanAdd<cl_int> > : ScanChunkSSE<cl_int> {};
+
+template <>
+struct ScanChunk<cl_uint, ScanAdd<cl_uint> > : ScanChunkSSE<cl_uint> {};
+#endif
+
+/**
+ * ScanJob
+ * One parallelScan call, shared by its tasks
+ */
+template <typename T, typename Op>
+struct ScanJob {
+  T *output;        /**< scanned elements */
+  const T *input;   /**< elements to scan */
+  size_t length;    /**< number of elements */
+  bool inclusive;   /**< element i includes input[i] */
+  const Op *op;     /**< operator */
+  T *starts;        /**< chunk totals, then chunk start values */
+};
+
+template <typename T, typename Op>
+void scanReduceChunks(size_t begin, size_t end, void *data) {
+  ScanJob<T, Op> *job = (ScanJob<T, Op> *)data;
+  for (size_t c = begin; c < end; ++c) {
+    size_t first = c * SDK_SCAN_CHUNK;
+    size_t n = std::min((size_t)SDK_SCAN_CHUNK, job->length - first);
+    job->starts[c] = ScanChunk<T, Op>::reduce(job->input + first, n, *job->op);
+  }
+}
+
+template <typename T, typename Op>
+void scanChunks(size_t begin, size_t end, void *data) {
+  ScanJob<T, Op> *job = (ScanJob<T, Op> *)data;
+  for (size_t c = begin; c < end; ++c) {
+    size_t first = c * SDK_SCAN_CHUNK;
+    size_t n = std::min((size_t)SDK_SCAN_CHUNK, job->length - first);
+    ScanChunk<T, Op>::scan(job->output + first, job->input + first, n,
+                           job->starts[c], job->inclusive, *job->op);
+  }
+}
+
+/**
+ * parallelScan
+ * Prefix scan of input into output
+ * @param output scanned elements, may be input
+ * @param input elements to scan
+ * @param length number of elements
+ * @param inclusive element i includes input[i], else it stops before it
+ * @param op associative operator with an identity()
+ */
+template <typename T, typename Op>
+void parallelScan(T *output, const T *input, size_t length, bool inclusive,
+                  const Op &op) {
+  size_t chunks = (length + SDK_SCAN_CHUNK - 1) / SDK_SCAN_CHUNK;
+  if (chunks <= 1) {
+    ScanChunk<T, Op>::scan(output, input, length, Op::identity(), inclusive,
+                           op);
+    return;
+  }
+
+  std::vector<T> starts(chunks);
+  ScanJob<T, Op> job;
+  job.output = output;
+  job.input = input;
+  job.length = length;
+  job.inclusive = inclusive;
+  job.op = &op;
+  job.starts = &starts[0];
+
+  SDKThreadPool &pool = SDKThreadPool::instance();
+  pool.parallelFor(0, chunks, 1, scanReduceChunks<T, Op>, &job);
+
+  T carry = Op::identity();
+  for (size_t c = 0; c < chunks; ++c) {
+    T total = starts[c];
+    starts[c] = carry;
+    carry = op(carry, total);
+  }
+
+  pool.parallelFor(0, chunks, 1, scanChunks<T, Op>, &job);
+}
+
+/**
+ * parallelScan
+ * Prefix sum of input into output
+ */
+template <typename T>
+void parallelScan(T *output, const T *input, size_t length, bool inclusive) {
+  parallelScan(output, input, length, inclusive, ScanAdd<T>());
+}
+
+/**
+ * ScanKahan
+ * A compensated float sum: the exact value is about sum - error
+ */
+struct ScanKahan {
+  cl_float sum;   /**< running sum */
+  cl_float error; /**< rounding error of sum, to remove from the next term */
+
+  void add(cl_float x) {
+    cl_float y = x - error;
+    cl_float t = sum + y;
+    error = (t - sum) - y;
+    sum = t;
+  }
+};
+
+/**
+ * ScanKahanJob
+ * One parallelScanKahan call, shared by its tasks
+ */
+struct ScanKahanJob {
+  cl_float *output;      /**< scanned elements */
+  const cl_float *input; /**< elements to scan */
+  size_t length;         /**< number of elements */
+  bool inclusive;        /**< element i includes input[i] */
+  ScanKahan *starts;     /**< chunk totals, then chunk start values */
+};
+
+inline void scanKahanReduceChunks(size_t begin, size_t end, void *data) {
+  ScanKahanJob *job = (ScanKahanJob *)data;
+  for (size_t c = begin; c < end; ++c) {
+    size_t first = c * SDK_SCAN_CHUNK;
+    size_t last = std::min(first + SDK_SCAN_CHUNK, job->length);
+    ScanKahan total = {0.0f, 0.0f};
+    for (size_t i = first; i < last; ++i) {
+      total.add(job->input[i]);
+    }
+    job->starts[c] = total;
+  }
+}
+
+inline void scanKahanChunks(size_t begin, size_t end, void *data) {
+  ScanKahanJob *job = (ScanKahanJob *)data;
+  for (size_t c = begin; c < end; ++c) {
+    size_t first = c * SDK_SCAN_CHUNK;
+    size_t last = std::min(first + SDK_SCAN_CHUNK, job->length);
+    ScanKahan running = job->starts[c];
+    for (size_t i = first; i < last; ++i) {
+      cl_float x = job->input[i];
+      if (!job->inclusive) {
+        job->output[i] = running.sum;
+      }
+      running.add(x);
+      if (job->inclusive) {
+        job->output[i] = running.sum;
+      }
+    }
+  }
+}
+
+/**
+ * parallelScanKahan
+ * Compensated prefix sum of input into output, see parallelScan
+ */
+inline void parallelScanKahan(cl_float *output, const cl_float *input,
+                              size_t length, bool inclusive) {
+  size_t chunks = (length + SDK_SCAN_CHUNK - 1) / SDK_SCAN_CHUNK;
+  if (chunks == 0) {
+    return;
+  }
+
+  std::vector<ScanKahan> starts(chunks);
+  ScanKahanJob job;
+  job.output = output;
+  job.input = input;
+  job.length = length;
+  job.inclusive = inclusive;
+  job.starts = &starts[0];
+
+  SDKThreadPool &pool = SDKThreadPool::instance();
+  pool.parallelFor(0, chunks, 1, scanKahanReduceChunks, &job);
+
+  // Chain the chunk totals, error terms included
+  ScanKahan carry = {0.0f, 0.0f};
+  for (size_t c = 0; c < chunks; ++c) {
+    ScanKahan total = starts[c];
+    starts[c] = carry;
+    carry.add(total.sum);
+    carry.add(-total.error);
+  }
+
+  pool.parallelFor(0, chunks, 1, scanKahanChunks, &job);
+}
+
+}  // namespace appsdk
+
+#endif  // SDKSCAN_HPP_
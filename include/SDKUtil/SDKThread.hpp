@@ -24,7 +24,7 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
 EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ********************************************************************/
 #ifndef _SDK_THREAD_H_
-#define _SDK_THREAD_H
+#define _SDK_THREAD_H_
 
 #ifdef _WIN32
 #ifndef _WIN32_WINNT
@@ -46,9 +46,20 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #else
 #include "pthread.h"
+#include <sched.h>
+#include <unistd.h>
 #define EXPORT
 #endif
 
+#include <deque>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define SDK_THREAD_LOCAL __declspec(thread)
+#else
+#define SDK_THREAD_LOCAL __thread
+#endif
+
 /**
  * suppress the warning #810 if intel compiler is used.
  */
@@ -61,7 +72,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define PRINT_ERROR_MSG(errorcode, msg) \
   if (errorcode != 0) printf("%s \n", msg)
 #else
-#define PRINT_ERROR_MSG(errorcode, msg)
+#define PRINT_ERROR_MSG(errorcode, msg) (void)(errorcode)
 #endif  // PRINT_COND_VAR_ERROR_MSG
 
 /**
@@ -74,6 +85,21 @@ namespace appsdk {
  */
 typedef void* (*threadFunc)(void*);
 
+/**
+ * getNumCPUCores
+ * @return number of online CPU cores, at least 1
+ */
+inline unsigned int getNumCPUCores() {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  unsigned int cores = (unsigned int)info.dwNumberOfProcessors;
+#else
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  return (cores > 0) ? (unsigned int)cores : 1;
+}
+
 //! pack the function pointer and data inside this struct
 typedef struct __argsToThreadFunc {
   threadFunc func;
@@ -230,7 +256,7 @@ class EXPORT CondVar {
   CondVarImpl* _condVarImpl;
 };
 #ifdef _WIN32
-unsigned _stdcall win32ThreadFunc(void* args);
+inline unsigned _stdcall win32ThreadFunc(void* args);
 #endif
 /**
  * \class Thread
@@ -343,7 +369,7 @@ class EXPORT SDKThread {
 #ifdef _WIN32
 //! Windows thread callback - invokes the callback set by
 //! the application in Thread constructor
-unsigned _stdcall win32ThreadFunc(void* args) {
+inline unsigned _stdcall win32ThreadFunc(void* args) {
   argsToThreadFunc* ptr = (argsToThreadFunc*)args;
   SDKThread* obj = (SDKThread*)ptr->data;
   ptr->func(obj->getData());
@@ -365,7 +391,7 @@ class CondVarImpl {
   /**
    * Constructor
    */
-  CondVarImpl() : _count(0xFFFFFFFF), _maxThreads(0xFFFFFFFF) {}
+  CondVarImpl() : _maxThreads(0xFFFFFFFF), _count(0xFFFFFFFF) {}
 
   /**
    * Destructor
@@ -686,25 +712,545 @@ class CondVarImpl {
   unsigned int _count;
 };
 
-CondVar::CondVar() { _condVarImpl = new CondVarImpl(); }
-CondVar::~CondVar() { delete _condVarImpl; }
+inline CondVar::CondVar() { _condVarImpl = new CondVarImpl(); }
+inline CondVar::~CondVar() { delete _condVarImpl; }
 
 /**
  * Initialize condition variable
  */
-bool CondVar::init(unsigned int maxThreadCount) {
+inline bool CondVar::init(unsigned int maxThreadCount) {
   return _condVarImpl->init(maxThreadCount);
 }
 
 /**
  * Destroy condition variable
  */
-bool CondVar::destroy() { return _condVarImpl->destroy(); }
+inline bool CondVar::destroy() { return _condVarImpl->destroy(); }
 
 /**
  * Synchronize threads
  */
-void CondVar::syncThreads() { _condVarImpl->syncThreads(); }
+inline void CondVar::syncThreads() { _condVarImpl->syncThreads(); }
+
+/**
+ * atomicAdd
+ * Atomically adds delta to *value
+ * @return the new value
+ */
+inline long atomicAdd(volatile long *value, long delta) {
+#ifdef _WIN32
+  return InterlockedExchangeAdd(value, delta) + delta;
+#else
+  return __sync_add_and_fetch(value, delta);
+#endif
+}
+
+/**
+ * class ThreadEvent
+ * Manual reset event: wait() blocks until set() is called, and keeps
+ * returning immediately until reset()
+ */
+class EXPORT ThreadEvent {
+ public:
+  ThreadEvent() {
+#ifdef _WIN32
+    _event = CreateEvent(NULL, TRUE, FALSE, NULL);
+#else
+    _set = false;
+    pthread_mutex_init(&_lock, NULL);
+    pthread_cond_init(&_cond, NULL);
+#endif
+  }
+
+  ~ThreadEvent() {
+#ifdef _WIN32
+    CloseHandle(_event);
+#else
+    pthread_cond_destroy(&_cond);
+    pthread_mutex_destroy(&_lock);
+#endif
+  }
+
+  void set() {
+#ifdef _WIN32
+    SetEvent(_event);
+#else
+    pthread_mutex_lock(&_lock);
+    _set = true;
+    pthread_cond_broadcast(&_cond);
+    pthread_mutex_unlock(&_lock);
+#endif
+  }
+
+  void reset() {
+#ifdef _WIN32
+    ResetEvent(_event);
+#else
+    pthread_mutex_lock(&_lock);
+    _set = false;
+    pthread_mutex_unlock(&_lock);
+#endif
+  }
+
+  bool isSet() {
+#ifdef _WIN32
+    return WaitForSingleObject(_event, 0) == WAIT_OBJECT_0;
+#else
+    pthread_mutex_lock(&_lock);
+    bool set = _set;
+    pthread_mutex_unlock(&_lock);
+    return set;
+#endif
+  }
+
+  void wait() {
+#ifdef _WIN32
+    WaitForSingleObject(_event, INFINITE);
+#else
+    pthread_mutex_lock(&_lock);
+    while (!_set) {
+      pthread_cond_wait(&_cond, &_lock);
+    }
+    pthread_mutex_unlock(&_lock);
+#endif
+  }
+
+ private:
+  ThreadEvent(const ThreadEvent &);
+  ThreadEvent &operator=(const ThreadEvent &);
+
+#ifdef _WIN32
+  HANDLE _event;
+#else
+  bool _set;
+  pthread_mutex_t _lock;
+  pthread_cond_t _cond;
+#endif
+};
+
+/**
+ * class ThreadSemaphore
+ * Counting semaphore used to park idle pool workers
+ */
+class EXPORT ThreadSemaphore {
+ public:
+  ThreadSemaphore() : _count(0) {
+#ifdef _WIN32
+    _sem = CreateSemaphore(NULL, 0, 0x7FFFFFFF, NULL);
+#else
+    pthread_mutex_init(&_lock, NULL);
+    pthread_cond_init(&_cond, NULL);
+#endif
+  }
+
+  ~ThreadSemaphore() {
+#ifdef _WIN32
+    CloseHandle(_sem);
+#else
+    pthread_cond_destroy(&_cond);
+    pthread_mutex_destroy(&_lock);
+#endif
+  }
+
+  void post(unsigned int count = 1) {
+#ifdef _WIN32
+    ReleaseSemaphore(_sem, (LONG)count, NULL);
+#else
+    pthread_mutex_lock(&_lock);
+    _count += count;
+    pthread_cond_broadcast(&_cond);
+    pthread_mutex_unlock(&_lock);
+#endif
+  }
+
+  void wait() {
+#ifdef _WIN32
+    WaitForSingleObject(_sem, INFINITE);
+#else
+    pthread_mutex_lock(&_lock);
+    while (_count == 0) {
+      pthread_cond_wait(&_cond, &_lock);
+    }
+    _count--;
+    pthread_mutex_unlock(&_lock);
+#endif
+  }
+
+ private:
+  ThreadSemaphore(const ThreadSemaphore &);
+  ThreadSemaphore &operator=(const ThreadSemaphore &);
+
+  unsigned int _count;
+#ifdef _WIN32
+  HANDLE _sem;
+#else
+  pthread_mutex_t _lock;
+  pthread_cond_t _cond;
+#endif
+};
+
+class SDKThreadPool;
+
+/**
+ * class SDKTaskFuture
+ * Result of a task submitted to SDKThreadPool. The future is owned by the
+ * caller and must outlive the task; the destructor waits for it.
+ */
+class EXPORT SDKTaskFuture {
+ public:
+  SDKTaskFuture() : _func(NULL), _arg(NULL), _result(NULL), _pool(NULL) {}
+
+  ~SDKTaskFuture() { wait(); }
+
+  /**
+   * Returns true once the task has finished
+   */
+  bool isReady() { return _pool == NULL || _done.isSet(); }
+
+  /**
+   * Blocks until the task has finished. The waiting thread runs queued
+   * tasks in the meantime, so waiting from inside a task cannot deadlock.
+   */
+  void wait();
+
+  /**
+   * Waits for the task and returns the value returned by its function
+   */
+  void *get() {
+    wait();
+    return _result;
+  }
+
+ private:
+  friend class SDKThreadPool;
+
+  SDKTaskFuture(const SDKTaskFuture &);
+  SDKTaskFuture &operator=(const SDKTaskFuture &);
+
+  threadFunc _func;
+  void *_arg;
+  void *_result;
+  SDKThreadPool *_pool;
+  ThreadEvent _done;
+};
+
+/**
+ * class SDKThreadPool
+ * Work-stealing pool of CPU threads. Each worker owns a deque: it pops
+ * its own tasks newest first and steals the oldest tasks of the other
+ * workers when it runs dry. Tasks submitted from a worker go to its own
+ * deque, others are spread round robin. Threads are created once, so
+ * repeated run() iterations do not pay for thread creation.
+ *
+ * Common usage:
+ *
+ *   SDKThreadPool &pool = SDKThreadPool::instance();
+ *   pool.parallelFor(0, rows, 16, rowFunc, &data);
+ *
+ *   SDKTaskFuture future;
+ *   pool.submit(future, threadFunc, &data);
+ *   void *result = future.get();
+ */
+class EXPORT SDKThreadPool {
+ public:
+  /**
+   * Creates the workers
+   * @param numWorkers number of worker threads, 0 for one per CPU core
+   * besides the calling thread
+   * @param pinThreads bind worker i to CPU core i
+   */
+  SDKThreadPool(unsigned int numWorkers = 0, bool pinThreads = false)
+      : _stopping(0), _nextQueue(0) {
+    if (numWorkers == 0) {
+      unsigned int cores = getNumCPUCores();
+      numWorkers = (cores > 1) ? cores - 1 : 1;
+    }
+    // All queues must exist before the first worker starts stealing
+    _workers.resize(numWorkers);
+    for (unsigned int i = 0; i < numWorkers; i++) {
+      _queues.push_back(new WorkerQueue());
+      _workers[i].pool = this;
+      _workers[i].index = i;
+      _workers[i].pin = pinThreads;
+    }
+    for (unsigned int i = 0; i < numWorkers; i++) {
+      _threads.push_back(new SDKThread());
+      _threads[i]->create(workerMain, &_workers[i]);
+    }
+  }
+
+  /**
+   * Finishes the queued tasks and joins the workers
+   */
+  ~SDKThreadPool() {
+    atomicAdd(&_stopping, 1);
+    _wakeup.post((unsigned int)_threads.size());
+    for (size_t i = 0; i < _threads.size(); i++) {
+      _threads[i]->join();
+      delete _threads[i];
+    }
+    // Workers steal from every queue until they exit
+    for (size_t i = 0; i < _queues.size(); i++) {
+      delete _queues[i];
+    }
+  }
+
+  /**
+   * instance
+   * @return the process wide pool, sized to the CPU core count
+   */
+  static SDKThreadPool &instance();
+
+  /**
+   * @return number of worker threads
+   */
+  unsigned int getNumWorkers() const { return (unsigned int)_threads.size(); }
+
+  /**
+   * submit
+   * Queues func(arg); its return value is available from future.get()
+   * @param future future of the task, must not be in use
+   * @param func task entry point
+   * @param arg argument passed to func
+   */
+  void submit(SDKTaskFuture &future, threadFunc func, void *arg) {
+    future._func = func;
+    future._arg = arg;
+    future._result = NULL;
+    future._pool = this;
+    future._done.reset();
+
+    unsigned int queue;
+    if (currentPool() == this) {
+      queue = currentWorker();
+    } else {
+      queue = (unsigned int)(atomicAdd(&_nextQueue, 1) % _queues.size());
+    }
+    _queues[queue]->lock.lock();
+    _queues[queue]->tasks.push_back(&future);
+    _queues[queue]->lock.unlock();
+    _wakeup.post();
+  }
+
+  /**
+   * parallelFor
+   * Calls body(chunkBegin, chunkEnd, arg) for consecutive chunks of
+   * [begin, end) of at most grain indices. The calling thread takes part
+   * and the call returns when every chunk is done.
+   * @param grain indices per chunk, 0 picks about 4 chunks per thread
+   */
+  void parallelFor(size_t begin, size_t end, size_t grain,
+                   void (*body)(size_t, size_t, void *), void *arg) {
+    if (end <= begin) {
+      return;
+    }
+    size_t count = end - begin;
+    if (grain == 0) {
+      grain = count / (4 * (getNumWorkers() + 1));
+    }
+    if (grain == 0) {
+      grain = 1;
+    }
+    size_t chunks = (count + grain - 1) / grain;
+    size_t runners = (chunks - 1 < getNumWorkers()) ? chunks - 1
+                                                     : getNumWorkers();
+    if (runners == 0) {
+      body(begin, end, arg);
+      return;
+    }
+
+    ParallelFor state;
+    state.next = 0;
+    state.begin = begin;
+    state.end = end;
+    state.grain = grain;
+    state.body = body;
+    state.arg = arg;
+
+    SDKTaskFuture *futures = new SDKTaskFuture[runners];
+    for (size_t i = 0; i < runners; i++) {
+      submit(futures[i], parallelForRunner, &state);
+    }
+    parallelForRunner(&state);
+    delete[] futures;
+  }
+
+  /**
+   * parallelFor
+   * Calls body(chunkBegin, chunkEnd) for consecutive chunks of
+   * [begin, end), for any function object body
+   */
+  template <class Body>
+  void parallelFor(size_t begin, size_t end, size_t grain, Body &body) {
+    parallelFor(begin, end, grain, callBody<Body>, &body);
+  }
+
+ private:
+  friend class SDKTaskFuture;
+
+  SDKThreadPool(const SDKThreadPool &);
+  SDKThreadPool &operator=(const SDKThreadPool &);
+
+  struct WorkerQueue {
+    ThreadLock lock;
+    std::deque<SDKTaskFuture *> tasks;
+  };
+
+  struct WorkerArgs {
+    SDKThreadPool *pool;
+    unsigned int index;
+    bool pin;
+  };
+
+  struct ParallelFor {
+    volatile long next;
+    size_t begin;
+    size_t end;
+    size_t grain;
+    void (*body)(size_t, size_t, void *);
+    void *arg;
+  };
+
+  static SDKThreadPool *&currentPool() {
+    static SDK_THREAD_LOCAL SDKThreadPool *pool = NULL;
+    return pool;
+  }
+
+  static unsigned int &currentWorker() {
+    static SDK_THREAD_LOCAL unsigned int worker = 0;
+    return worker;
+  }
+
+  template <class Body>
+  static void callBody(size_t begin, size_t end, void *body) {
+    (*(Body *)body)(begin, end);
+  }
+
+  static void *parallelForRunner(void *arg) {
+    ParallelFor *state = (ParallelFor *)arg;
+    for (;;) {
+      size_t chunk = (size_t)(atomicAdd(&state->next, 1) - 1);
+      size_t chunkBegin = state->begin + chunk * state->grain;
+      if (chunk >= (state->end - state->begin + state->grain - 1) /
+                       state->grain) {
+        break;
+      }
+      size_t chunkEnd = (state->end - chunkBegin > state->grain)
+                            ? chunkBegin + state->grain
+                            : state->end;
+      state->body(chunkBegin, chunkEnd, state->arg);
+    }
+    return NULL;
+  }
+
+  static void pinCurrentThread(unsigned int core) {
+    core %= getNumCPUCores();
+#ifdef _WIN32
+    SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+  }
+
+  /**
+   * Takes a task: the newest of the own queue, else the oldest of another
+   * @param self own queue, or -1 for threads outside the pool
+   */
+  SDKTaskFuture *popTask(int self) {
+    size_t numQueues = _queues.size();
+    if (self >= 0) {
+      WorkerQueue *queue = _queues[self];
+      queue->lock.lock();
+      if (!queue->tasks.empty()) {
+        SDKTaskFuture *task = queue->tasks.back();
+        queue->tasks.pop_back();
+        queue->lock.unlock();
+        return task;
+      }
+      queue->lock.unlock();
+    }
+    size_t first = (self >= 0) ? (size_t)self + 1 : 0;
+    for (size_t i = 0; i < numQueues; i++) {
+      WorkerQueue *victim = _queues[(first + i) % numQueues];
+      if (!victim->lock.tryLock()) {
+        continue;
+      }
+      if (!victim->tasks.empty()) {
+        SDKTaskFuture *task = victim->tasks.front();
+        victim->tasks.pop_front();
+        victim->lock.unlock();
+        return task;
+      }
+      victim->lock.unlock();
+    }
+    return NULL;
+  }
+
+  /**
+   * Takes a task for the calling thread, from this pool's point of view
+   */
+  SDKTaskFuture *popTaskForCaller() {
+    return popTask(currentPool() == this ? (int)currentWorker() : -1);
+  }
+
+  static void execute(SDKTaskFuture *task) {
+    task->_result = task->_func(task->_arg);
+    task->_done.set();
+  }
+
+  static void *workerMain(void *arg) {
+    WorkerArgs *args = (WorkerArgs *)arg;
+    SDKThreadPool *pool = args->pool;
+    currentPool() = pool;
+    currentWorker() = args->index;
+    if (args->pin) {
+      pinCurrentThread(args->index);
+    }
+    for (;;) {
+      SDKTaskFuture *task = pool->popTask((int)args->index);
+      if (task != NULL) {
+        execute(task);
+        continue;
+      }
+      if (atomicAdd(&pool->_stopping, 0) != 0) {
+        break;
+      }
+      pool->_wakeup.wait();
+    }
+    return NULL;
+  }
+
+  volatile long _stopping;             /**< set by the destructor */
+  volatile long _nextQueue;            /**< round robin submit cursor */
+  std::vector<WorkerQueue *> _queues;  /**< one task deque per worker */
+  std::vector<WorkerArgs> _workers;    /**< arguments of workerMain */
+  std::vector<SDKThread *> _threads;   /**< worker threads */
+  ThreadSemaphore _wakeup;             /**< one post per queued task */
+};
+
+inline SDKThreadPool &SDKThreadPool::instance() {
+  static SDKThreadPool pool;
+  return pool;
+}
+
+inline void SDKTaskFuture::wait() {
+  if (_pool == NULL) {
+    return;
+  }
+  while (!_done.isSet()) {
+    // Help with queued work; block only when there is nothing left to run
+    SDKTaskFuture *task = _pool->popTaskForCaller();
+    if (task == NULL) {
+      _done.wait();
+      break;
+    }
+    SDKThreadPool::execute(task);
+  }
+  _pool = NULL;
+}
 }
 
 #endif  // _CPU_THREAD_H_
@@ -0,0 +1,375 @@
+/**********************************************************************
+Copyright 2014 Advanced Micro Devices, Inc. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+   Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS
+ OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#ifndef SDKTRANSPOSE_HPP_
+#define SDKTRANSPOSE_HPP_
+
+/**
+ * Header Files
+ */
+#include <CL/cl.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "SDKThread.hpp"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+/**
+ * namespace appsdk
+ */
+namespace appsdk {
+
+/**
+ * Matrix transposes for the host reference engines.
+ *
+ * A row-by-row transpose writes its output a full column apart on every
+ * element, so for large matrices each store misses the cache. Here the
+ * matrix is cut recursively, halving the longer side, until both sides of
+ * a block are at most SDK_TRANSPOSE_BLOCK; the blocks in and out then stay
+ * in cache at every level without tuning for a particular cache size.
+ * Inside a block, 4-byte elements (cl_float, cl_uint, cl_uchar4, ...) move
+ * as 4x4 tiles transposed in SSE registers; other sizes, and the edges of
+ * blocks whose sides are not multiples of 4, are copied one at a time.
+ *
+ * The output of a transpose is written a few bytes to each of many rows, and
+ * once it outgrows the cache those partly written lines are evicted and
+ * refetched over and over. Outputs over SDK_TRANSPOSE_STREAM bytes are
+ * therefore written with streaming stores, which fill whole lines in the
+ * write-combining buffers and skip the cache.
+ *
+ * The thread pool runs one task per SDK_TRANSPOSE_TILE square tile. The
+ * in-place transpose of a square matrix swaps each tile above the diagonal
+ * with its mirror below it in the same task, so it needs no second buffer.
+ */
+#define SDK_TRANSPOSE_BLOCK 32        /**< largest side of a block in cache */
+#define SDK_TRANSPOSE_TILE 256        /**< side of the tile each task handles */
+#define SDK_TRANSPOSE_STREAM (2 << 20) /**< output bytes to stream beyond */
+
+/**
+ * TransposeKernel
+ * Transposes and swaps one block of elements, element by element
+ */
+template <typename T, size_t bytes = sizeof(T)>
+struct TransposeKernel {
+  /**
+   * Writes the transpose of rows x cols of in to out
+   * @param out first output element, row stride os
+   * @param in first input element, row stride is
+   * @param stream write out with streaming stores where it is aligned
+   */
+  static void block(T *out, size_t os, const T *in, size_t is, size_t rows,
+                    size_t cols, bool stream) {
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        out[j * os + i] = in[i * is + j];
+      }
+    }
+  }
+
+  /**
+   * Replaces rows x cols of a and cols x rows of b with each other's
+   * transpose; both share the row stride s
+   */
+  static void swap(T *a, T *b, size_t s, size_t rows, size_t cols) {
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        std::swap(a[i * s + j], b[j * s + i]);
+      }
+    }
+  }
+
+  /**
+   * Transposes n x n of a in place
+   */
+  static void diagonal(T *a, size_t s, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = i + 1; j < n; ++j) {
+        std::swap(a[i * s + j], a[j * s + i]);
+      }
+    }
+  }
+};
+
+#ifdef __SSE__
+/**
+ * TransposeKernel
+ * 4-byte elements, moved as 4x4 tiles transposed in SSE registers
+ */
+template <typename T>
+struct TransposeKernel<T, 4> {
+  typedef TransposeKernel<T, 0> Scalar;
+
+  static void load(const T *p, size_t s, __m128 &r0, __m128 &r1, __m128 &r2,
+                   __m128 &r3) {
+    r0 = _mm_loadu_ps((const float *)p);
+    r1 = _mm_loadu_ps((const float *)(p + s));
+    r2 = _mm_loadu_ps((const float *)(p + 2 * s));
+    r3 = _mm_loadu_ps((const float *)(p + 3 * s));
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  }
+
+  static void store(T *p, size_t s, __m128 r0, __m128 r1, __m128 r2,
+                    __m128 r3) {
+    _mm_storeu_ps((float *)p, r0);
+    _mm_storeu_ps((float *)(p + s), r1);
+    _mm_storeu_ps((float *)(p + 2 * s), r2);
+    _mm_storeu_ps((float *)(p + 3 * s), r3);
+  }
+
+  static void stream(T *p, size_t s, __m128 r0, __m128 r1, __m128 r2,
+                     __m128 r3) {
+    _mm_stream_ps((float *)p, r0);
+    _mm_stream_ps((float *)(p + s), r1);
+    _mm_stream_ps((float *)(p + 2 * s), r2);
+    _mm_stream_ps((float *)(p + 3 * s), r3);
+  }
+
+  // Walks along the output rows, so each one fills a line before moving on
+  static void block(T *out, size_t os, const T *in, size_t is, size_t rows,
+                    size_t cols, bool streamed) {
+    size_t rows4 = rows & ~(size_t)3, cols4 = cols & ~(size_t)3;
+    __m128 r0, r1, r2, r3;
+    for (size_t j = 0; j < cols4; j += 4) {
+      for (size_t i = 0; i < rows4; i += 4) {
+        load(in + i * is + j, is, r0, r1, r2, r3);
+        if (streamed) {
+          stream(out + j * os + i, os, r0, r1, r2, r3);
+        } else {
+          store(out + j * os + i, os, r0, r1, r2, r3);
+        }
+      }
+    }
+    Scalar::block(out + cols4 * os, os, in + cols4, is, rows, cols - cols4,
+                  false);
+    Scalar::block(out + rows4, os, in + rows4 * is, is, rows - rows4, cols4,
+                  false);
+  }
+
+  static void swap(T *a, T *b, size_t s, size_t rows, size_t cols) {
+    size_t rows4 = rows & ~(size_t)3, cols4 = cols & ~(size_t)3;
+    __m128 a0, a1, a2, a3, b0, b1, b2, b3;
+    for (size_t i = 0; i < rows4; i += 4) {
+      for (size_t j = 0; j < cols4; j += 4) {
+        load(a + i * s + j, s, a0, a1, a2, a3);
+        load(b + j * s + i, s, b0, b1, b2, b3);
+        store(a + i * s + j, s, b0, b1, b2, b3);
+        store(b + j * s + i, s, a0, a1, a2, a3);
+      }
+    }
+    Scalar::swap(a + cols4, b + cols4 * s, s, rows, cols - cols4);
+    Scalar::swap(a + rows4 * s, b + rows4, s, rows - rows4, cols4);
+  }
+
+  static void diagonal(T *a, size_t s, size_t n) {
+    size_t n4 = n & ~(size_t)3;
+    __m128 r0, r1, r2, r3;
+    for (size_t i = 0; i < n4; i += 4) {
+      load(a + i * s + i, s, r0, r1, r2, r3);
+      store(a + i * s + i, s, r0, r1, r2, r3);
+      swap(a + i * s + i + 4, a + (i + 4) * s + i, s, 4, n4 - i - 4);
+    }
+    // Pairs with an element in the last n % 4 rows or columns
+    Scalar::swap(a + n4, a + n4 * s, s, n4, n - n4);
+    Scalar::diagonal(a + n4 * s + n4, s, n - n4);
+  }
+};
+#endif
+
+/**
+ * transposeSplit
+ * Where to halve a side of length n, on a 16 element (64 byte) boundary so
+ * 4x4 tiles stay whole and streamed output rows fill whole cache lines
+ */
+inline size_t transposeSplit(size_t n) {
+  return ((n / 2) + 15) & ~(size_t)15;
+}
+
+template <typename T>
+void transposeBlock(T *out, size_t os, const T *in, size_t is, size_t rows,
+                    size_t cols, bool stream) {
+  if (rows <= SDK_TRANSPOSE_BLOCK && cols <= SDK_TRANSPOSE_BLOCK) {
+    TransposeKernel<T>::block(out, os, in, is, rows, cols, stream);
+  } else if (rows >= cols) {
+    size_t h = transposeSplit(rows);
+    transposeBlock(out, os, in, is, h, cols, stream);
+    transposeBlock(out + h, os, in + h * is, is, rows - h, cols, stream);
+  } else {
+    size_t h = transposeSplit(cols);
+    transposeBlock(out, os, in, is, rows, h, stream);
+    transposeBlock(out + h * os, os, in + h, is, rows, cols - h, stream);
+  }
+}
+
+template <typename T>
+void transposeSwap(T *a, T *b, size_t s, size_t rows, size_t cols) {
+  if (rows <= SDK_TRANSPOSE_BLOCK && cols <= SDK_TRANSPOSE_BLOCK) {
+    TransposeKernel<T>::swap(a, b, s, rows, cols);
+  } else if (rows >= cols) {
+    size_t h = transposeSplit(rows);
+    transposeSwap(a, b, s, h, cols);
+    transposeSwap(a + h * s, b + h, s, rows - h, cols);
+  } else {
+    size_t h = transposeSplit(cols);
+    transposeSwap(a, b, s, rows, h);
+    transposeSwap(a + h, b + h * s, s, rows, cols - h);
+  }
+}
+
+template <typename T>
+void transposeDiagonal(T *a, size_t s, size_t n) {
+  if (n <= SDK_TRANSPOSE_BLOCK) {
+    TransposeKernel<T>::diagonal(a, s, n);
+  } else {
+    size_t h = transposeSplit(n);
+    transposeDiagonal(a, s, h);
+    transposeDiagonal(a + h * s + h, s, n - h);
+    transposeSwap(a + h, a + h * s, s, h, n - h);
+  }
+}
+
+/**
+ * TransposeJob
+ * One parallelTranspose or parallelTransposeInPlace call, shared by its
+ * tasks
+ */
+template <typename T>
+struct TransposeJob {
+  T *output;      /**< transposed matrix, or the matrix to transpose in place */
+  const T *input; /**< matrix to transpose */
+  size_t width;   /**< input row length */
+  size_t height;  /**< input rows */
+  size_t tilesX;  /**< tiles across a row of input */
+  bool stream;    /**< write output with streaming stores */
+  std::vector<std::pair<size_t, size_t> > pairs; /**< in place: tile (I, J) */
+};
+
+template <typename T>
+void transposeTiles(size_t begin, size_t end, void *data) {
+  TransposeJob<T> *job = (TransposeJob<T> *)data;
+  for (size_t t = begin; t < end; ++t) {
+    size_t y = (t / job->tilesX) * SDK_TRANSPOSE_TILE;
+    size_t x = (t % job->tilesX) * SDK_TRANSPOSE_TILE;
+    transposeBlock(job->output + x * job->height + y, job->height,
+                   job->input + y * job->width + x, job->width,
+                   std::min((size_t)SDK_TRANSPOSE_TILE, job->height - y),
+                   std::min((size_t)SDK_TRANSPOSE_TILE, job->width - x),
+                   job->stream);
+  }
+#ifdef __SSE__
+  // Streaming stores are weakly ordered; publish them before the task ends
+  if (job->stream) {
+    _mm_sfence();
+  }
+#endif
+}
+
+template <typename T>
+void transposeTilesInPlace(size_t begin, size_t end, void *data) {
+  TransposeJob<T> *job = (TransposeJob<T> *)data;
+  size_t n = job->width;
+  for (size_t t = begin; t < end; ++t) {
+    size_t y = job->pairs[t].first * SDK_TRANSPOSE_TILE;
+    size_t x = job->pairs[t].second * SDK_TRANSPOSE_TILE;
+    size_t rows = std::min((size_t)SDK_TRANSPOSE_TILE, n - y);
+    size_t cols = std::min((size_t)SDK_TRANSPOSE_TILE, n - x);
+    if (x == y) {
+      transposeDiagonal(job->output + y * n + y, n, rows);
+    } else {
+      transposeSwap(job->output + y * n + x, job->output + x * n + y, n, rows,
+                    cols);
+    }
+  }
+}
+
+/**
+ * parallelTranspose
+ * Transposes a height x width matrix into a width x height one, so that
+ * output[x * height + y] = input[y * width + x]
+ * @param output transposed matrix, must not overlap input
+ * @param input matrix to transpose
+ * @param width input row length
+ * @param height input rows
+ */
+template <typename T>
+void parallelTranspose(T *output, const T *input, size_t width,
+                       size_t height) {
+  TransposeJob<T> job;
+  job.output = output;
+  job.input = input;
+  job.width = width;
+  job.height = height;
+  job.tilesX = (width + SDK_TRANSPOSE_TILE - 1) / SDK_TRANSPOSE_TILE;
+  size_t tilesY = (height + SDK_TRANSPOSE_TILE - 1) / SDK_TRANSPOSE_TILE;
+  size_t tiles = job.tilesX * tilesY;
+
+  // Blocks then start on cache lines, which streaming stores must fill
+  // whole to avoid partial writes to memory
+  job.stream = sizeof(T) == 4 && (size_t)output % 64 == 0 &&
+               height % 16 == 0 &&
+               width * height * sizeof(T) > SDK_TRANSPOSE_STREAM;
+
+  if (tiles <= 1) {
+    transposeBlock(output, height, input, width, height, width, false);
+    return;
+  }
+
+  SDKThreadPool::instance().parallelFor(0, tiles, 1, transposeTiles<T>, &job);
+}
+
+/**
+ * parallelTransposeInPlace
+ * Transposes a square n x n matrix in place
+ * @param data matrix to transpose
+ * @param n row length and number of rows
+ */
+template <typename T>
+void parallelTransposeInPlace(T *data, size_t n) {
+  TransposeJob<T> job;
+  job.output = data;
+  job.input = data;
+  job.width = n;
+  job.height = n;
+  job.tilesX = (n + SDK_TRANSPOSE_TILE - 1) / SDK_TRANSPOSE_TILE;
+  if (job.tilesX <= 1) {
+    transposeDiagonal(data, n, n);
+    return;
+  }
+
+  // Each task owns a tile on or above the diagonal and its mirror
+  for (size_t i = 0; i < job.tilesX; ++i) {
+    for (size_t j = i; j < job.tilesX; ++j) {
+      job.pairs.push_back(std::make_pair(i, j));
+    }
+  }
+  SDKThreadPool::instance().parallelFor(0, job.pairs.size(), 1,
+                                        transposeTilesInPlace<T>, &job);
+}
+
+}  // namespace appsdk
+
+#endif  // SDKTRANSPOSE_HPP_
@@ -41,7 +41,9 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <ctype.h>
 #include <vector>
+#include <algorithm>
 #include <malloc.h>
 #include <math.h>
 #include <numeric>
@@ -358,6 +360,383 @@ void printArray(const std::string header, const std::vector<T> &data,
   std::cout << "\n";
 }
 
+/**
+ * SDKReport
+ * class implements a machine-readable result sink shared by all samples.
+ * The run's context (sample, args, device, verify) is set once and every
+ * printStatistics column is collected as a metric. When emit() is called
+ * or the process exits, one row per metric is appended to the report file
+ * with the fixed fields sample, args, device, verify, metric, value and
+ * unit. The format is CSV when the file name ends in ".csv" and JSON Lines
+ * otherwise.
+ */
+class SDKReport {
+ private:
+  std::string _fileName;               /**< _fileName report file */
+  std::vector<std::string> _keys;      /**< _keys context field names */
+  std::vector<std::string> _values;    /**< _values context field values */
+  std::vector<std::string> _metrics;   /**< _metrics normalized metric names */
+  std::vector<std::string> _units;     /**< _units metric units */
+  std::vector<std::string> _readings;  /**< _readings metric values */
+
+  SDKReport() {}
+  SDKReport(const SDKReport &);
+  SDKReport &operator=(const SDKReport &);
+
+  /**
+   * contextKeys
+   * context fields in the order they start every row
+   */
+  static const char *const *contextKeys() {
+    static const char *const keys[] = {"sample", "args", "device", "verify",
+                                       NULL};
+    return keys;
+  }
+
+  /**
+   * csvHeader
+   * first line of every CSV report
+   */
+  static std::string csvHeader() {
+    std::string header;
+    for (const char *const *key = contextKeys(); *key; key++) {
+      header += std::string(*key) + ",";
+    }
+    return header + "metric,value,unit";
+  }
+
+  /**
+   * isNumber
+   * true if the whole string parses as a floating point number
+   */
+  static bool isNumber(const std::string &str) {
+    if (str.empty()) {
+      return false;
+    }
+    char *end = NULL;
+    double val = strtod(str.c_str(), &end);
+    if (*end != '\0') {
+      return false;
+    }
+    return val == val && val - val == 0;  // reject nan and inf
+  }
+
+  /**
+   * jsonString
+   * quotes and escapes a string for JSON
+   */
+  static std::string jsonString(const std::string &str) {
+    std::string out("\"");
+    for (size_t i = 0; i < str.size(); i++) {
+      char c = str[i];
+      if (c == '"' || c == '\\') {
+        out += '\\';
+        out += c;
+      } else if ((unsigned char)c < 0x20) {
+        char buf[8];
+        sprintf(buf, "\\u%04x", (unsigned char)c);
+        out += buf;
+      } else {
+        out += c;
+      }
+    }
+    return out + "\"";
+  }
+
+  /**
+   * csvString
+   * quotes a CSV cell when it contains separators or quotes
+   */
+  static std::string csvString(const std::string &str) {
+    if (str.find_first_of(",\"\n\r") == std::string::npos) {
+      return str;
+    }
+    std::string out("\"");
+    for (size_t i = 0; i < str.size(); i++) {
+      if (str[i] == '"') {
+        out += '"';
+      }
+      out += str[i];
+    }
+    return out + "\"";
+  }
+
+  /**
+   * normalize
+   * Splits a printStatistics label into a metric name and a unit.
+   * "Kernel Time(sec)" gives kernel_time in s, "Host Pixels/sec" gives
+   * host_rate in Pixels/s and "Width" gives width with no unit.
+   */
+  static void normalize(const std::string &label, std::string &metric,
+                        std::string &unit) {
+    std::string name(label);
+    bool rate = false;
+    unit.clear();
+    size_t open = name.rfind('(');
+    size_t space = name.find_last_of(' ');
+    if (open != std::string::npos && name[name.size() - 1] == ')') {
+      unit = name.substr(open + 1, name.size() - open - 2);
+      name.erase(open);
+    } else if (name.find('/', space == std::string::npos ? 0 : space) !=
+               std::string::npos) {
+      size_t start = (space == std::string::npos) ? 0 : space + 1;
+      unit = name.substr(start);
+      name.erase(start);
+      rate = true;
+    }
+    if (unit == "sec") {
+      unit = "s";
+    } else if (unit.size() > 4 &&
+               unit.compare(unit.size() - 4, 4, "/sec") == 0) {
+      unit.replace(unit.size() - 3, 3, "s");
+    }
+
+    metric.clear();
+    for (size_t i = 0; i < name.size(); i++) {
+      char c = name[i];
+      if (isalnum((unsigned char)c)) {
+        metric += (char)tolower((unsigned char)c);
+      } else if (!metric.empty() && metric[metric.size() - 1] != '_') {
+        metric += '_';
+      }
+    }
+    while (!metric.empty() && metric[metric.size() - 1] == '_') {
+      metric.erase(metric.size() - 1);
+    }
+    if (rate) {
+      metric += metric.empty() ? "rate" : "_rate";
+    }
+  }
+
+  /**
+   * isCsv
+   * true if the report file has a .csv extension
+   */
+  bool isCsv() const {
+    return _fileName.size() >= 4 &&
+           strComparei(_fileName.substr(_fileName.size() - 4), ".csv");
+  }
+
+  /**
+   * checkCsvHeader
+   * Writes the header to an empty CSV file, or checks that a non-empty
+   * one starts with it, so every process and Driver job appends rows
+   * under a single header
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  int checkCsvHeader(FILE *file) const {
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0) {
+      fputs((csvHeader() + "\n").c_str(), file);
+      return SDK_SUCCESS;
+    }
+    fseek(file, 0, SEEK_SET);
+    std::string first;
+    int c;
+    while ((c = fgetc(file)) != EOF && c != '\n' && c != '\r') {
+      first += (char)c;
+    }
+    fseek(file, 0, SEEK_END);
+    if (first != csvHeader()) {
+      error("Report file " + _fileName + " has a different CSV header");
+      return SDK_FAILURE;
+    }
+    return SDK_SUCCESS;
+  }
+
+  /**
+   * row
+   * Formats one report row
+   */
+  std::string row(const std::string &metric, const std::string &value,
+                  const std::string &unit) const {
+    std::string line;
+    bool csv = isCsv();
+    line = csv ? "" : "{";
+    for (const char *const *key = contextKeys(); *key; key++) {
+      std::string val = get(*key);
+      if (csv) {
+        line += csvString(val) + ",";
+      } else {
+        line += jsonString(*key) + ": " + jsonString(val) + ", ";
+      }
+    }
+    if (csv) {
+      line += csvString(metric) + "," + csvString(value) + "," +
+              csvString(unit);
+    } else {
+      line += "\"metric\": " + jsonString(metric) + ", \"value\": ";
+      line += isNumber(value) ? value : jsonString(value);
+      line += ", \"unit\": " + jsonString(unit) + "}";
+    }
+    return line + "\n";
+  }
+
+ public:
+  /**
+   * Destructor
+   * writes any record still pending at process exit
+   */
+  ~SDKReport() { emit(); }
+
+  /**
+   * instance
+   * @return the process wide report sink
+   */
+  static SDKReport &instance();
+
+  /**
+   * open
+   * Selects the report file. Rows are appended, so many runs of a size
+   * sweep can share one file.
+   * @param fileName path of the report file
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  int open(const std::string &fileName) {
+    FILE *file = fopen(fileName.c_str(), "a");
+    if (file == NULL) {
+      error("Cannot open report file " + fileName);
+      return SDK_FAILURE;
+    }
+    fclose(file);
+    _fileName = fileName;
+    return SDK_SUCCESS;
+  }
+
+  /**
+   * isOpen
+   * @return true if a report file has been selected
+   */
+  bool isOpen() const { return !_fileName.empty(); }
+
+  /**
+   * set
+   * Sets a context field of the pending record, replacing any earlier value
+   * @param key one of sample, args, device or verify
+   * @param value field value
+   */
+  void set(const std::string &key, const std::string &value) {
+    if (!isOpen()) {
+      return;
+    }
+    for (size_t i = 0; i < _keys.size(); i++) {
+      if (_keys[i] == key) {
+        _values[i] = value;
+        return;
+      }
+    }
+    _keys.push_back(key);
+    _values.push_back(value);
+  }
+
+  /**
+   * get
+   * @return value of a pending context field, empty if it is not set
+   */
+  std::string get(const std::string &key) const {
+    for (size_t i = 0; i < _keys.size(); i++) {
+      if (_keys[i] == key) {
+        return _values[i];
+      }
+    }
+    return std::string("");
+  }
+
+  /**
+   * metric
+   * Adds a measurement to the pending record under its normalized name,
+   * replacing any earlier value of the same metric
+   * @param label column label as printed by printStatistics
+   * @param value measured value
+   */
+  void metric(const std::string &label, const std::string &value) {
+    if (!isOpen()) {
+      return;
+    }
+    std::string name, unit;
+    normalize(label, name, unit);
+    for (size_t i = 0; i < _metrics.size(); i++) {
+      if (_metrics[i] == name) {
+        _units[i] = unit;
+        _readings[i] = value;
+        return;
+      }
+    }
+    _metrics.push_back(name);
+    _units.push_back(unit);
+    _readings.push_back(value);
+  }
+
+  /**
+   * metric
+   * numeric overload
+   */
+  void metric(const std::string &label, double value) {
+    std::ostringstream str;
+    str << std::setprecision(9) << value;
+    metric(label, str.str());
+  }
+
+  /**
+   * emit
+   * Appends the pending record to the report file, one row per metric,
+   * and clears it. A record without metrics still writes one row so that
+   * the run and its verify status are recorded.
+   * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+   */
+  int emit() {
+    if (!isOpen() || (_keys.empty() && _metrics.empty())) {
+      return SDK_SUCCESS;
+    }
+    FILE *file = fopen(_fileName.c_str(), isCsv() ? "a+" : "a");
+    if (file == NULL) {
+      error("Cannot open report file " + _fileName);
+      return SDK_FAILURE;
+    }
+    int status = isCsv() ? checkCsvHeader(file) : SDK_SUCCESS;
+    if (status == SDK_SUCCESS) {
+      std::string lines;
+      for (size_t i = 0; i < _metrics.size(); i++) {
+        lines += row(_metrics[i], _readings[i], _units[i]);
+      }
+      if (_metrics.empty()) {
+        lines = row("", "", "");
+      }
+      fputs(lines.c_str(), file);
+    }
+    fclose(file);
+    _keys.clear();
+    _values.clear();
+    _metrics.clear();
+    _units.clear();
+    _readings.clear();
+    return status;
+  }
+};
+
+inline SDKReport &SDKReport::instance() {
+  static SDKReport report;
+  return report;
+}
+
+/**
+ * reportVerification
+ * Records the outcome of verifyResults() in the report and passes the
+ * status through, so it can wrap the call in main(). A run without -e
+ * stays "skipped" unless it fails.
+ * @param status return value of verifyResults()
+ * @return status
+ */
+static int reportVerification(int status) {
+  SDKReport &report = SDKReport::instance();
+  if (status != SDK_SUCCESS) {
+    report.set("verify", "failed");
+  } else if (report.get("verify") != "skipped") {
+    report.set("verify", "passed");
+  }
+  return status;
+}
+
 /**
  * printstats
  * Print the results from the test
@@ -397,6 +776,38 @@ static void printStatistics(std::string *statsStr, std::string *stats, int n) {
   if (columnWidth) {
     delete[] columnWidth;
   }
+  for (int i = 0; i < n; i++) {
+    SDKReport::instance().metric(statsStr[i], stats[i]);
+  }
+}
+
+/**
+ * printStatisticsWithHost
+ * Prints the statistics of a sample followed by the time and rate of its
+ * host reference. The reference only runs with -e, so the host columns
+ * are left out when hostTime is 0.
+ * @param statsStr names of the n device columns
+ * @param stats values of the n device columns
+ * @param n number of device columns
+ * @param hostTime seconds taken by the host reference
+ * @param rateName name of the host rate column, empty for none
+ * @param work units processed by the host reference, rate is work/hostTime
+ */
+static void printStatisticsWithHost(std::string *statsStr, std::string *stats,
+                                    int n, double hostTime,
+                                    const std::string &rateName = "",
+                                    double work = 0) {
+  std::vector<std::string> names(statsStr, statsStr + n);
+  std::vector<std::string> values(stats, stats + n);
+  if (hostTime > 0) {
+    names.push_back("Host time (sec)");
+    values.push_back(toString(hostTime, std::dec));
+    if (!rateName.empty()) {
+      names.push_back(rateName);
+      values.push_back(toString(work / hostTime, std::dec));
+    }
+  }
+  printStatistics(&names[0], &values[0], (int)names.size());
 }
 
 /**
@@ -468,10 +879,9 @@ int fillConstant(T *arrayPtr, const int width, const int height, const T val) {
  */
 template <typename T>
 T roundToPowerOf2(T val) {
-  int bytes = sizeof(T);
   val--;
-  for (int i = 0; i < bytes; i++) {
-    val |= val >> (1 << i);
+  for (size_t shift = 1; shift < sizeof(T) * 8; shift <<= 1) {
+    val |= val >> shift;
   }
   val++;
   return val;
@@ -491,11 +901,31 @@ int isPowerOf2(T val) {
   }
 }
 
+/**
+ * samplePath
+ * Directory that overrides the executable directory in getPath(). Empty
+ * unless a multi-sample driver points it at the directory of the sample
+ * it is running, so kernels and input files are still found.
+ */
+inline std::string &samplePath() {
+  static std::string path;
+  return path;
+}
+
+/**
+ * setSamplePath
+ * @param path directory, with trailing separator, returned by getPath()
+ */
+static void setSamplePath(const std::string &path) { samplePath() = path; }
+
 /**
         * getPath
         * @return path of the current directory
         */
 static std::string getPath() {
+  if (!samplePath().empty()) {
+    return samplePath();
+  }
 #ifdef _WIN32
   char buffer[MAX_PATH];
 #ifdef UNICODE
@@ -554,27 +984,97 @@ static std::string getSdkVerStr() {
   return std::string(str);
 }
 
+/**
+ * SDKTimerStats
+ * struct to hold the distribution of the intervals recorded by a timer.
+ * All values are in seconds.
+ */
+struct SDKTimerStats {
+  int count;     /**< count number of recorded intervals */
+  double total;  /**< total sum of all intervals */
+  double min;    /**< min shortest interval */
+  double max;    /**< max longest interval */
+  double mean;   /**< mean arithmetic mean of the intervals */
+  double median; /**< median 50th percentile */
+  double p95;    /**< p95 95th percentile */
+  double p99;    /**< p99 99th percentile */
+  double stddev; /**< stddev population standard deviation */
+
+  /**
+   * Constructor
+   */
+  SDKTimerStats()
+      : count(0),
+        total(0),
+        min(0),
+        max(0),
+        mean(0),
+        median(0),
+        p95(0),
+        p99(0),
+        stddev(0) {}
+};
+
 /**
  * Timer
  * struct to handle time measuring functionality
+ * On Linux the ticks come from clock_gettime(CLOCK_MONOTONIC_RAW), which has
+ * nanosecond resolution and is not slewed by NTP. Every start/stop interval
+ * is recorded so that the distribution can be reported, not just the sum.
  */
 class SDKTimer {
  private:
   struct Timer {
-    std::string name; /**< name name of time object*/
-    long long _freq;  /**< _freq frequency*/
-    double _clocks;   /**< _clocks number of ticks at end*/
-    double _start;    /**< _start start point ticks*/
+    std::string name;                /**< name name of time object*/
+    long long _freq;                 /**< _freq ticks per second*/
+    long long _clocks;               /**< _clocks number of ticks at end*/
+    long long _start;                /**< _start start point ticks*/
+    std::vector<long long> _samples; /**< _samples ticks of each interval*/
   };
 
   std::vector<Timer *> _timers; /**< _timers vector to Timer objects */
+  int _iterationTimer; /**< handle used by startIteration, -1 until then */
+
+  /**
+   * readTicks
+   * Current value of the monotonic tick counter
+   */
+  static long long readTicks() {
+#ifdef _WIN32
+    long long ticks;
+    QueryPerformanceCounter((LARGE_INTEGER *)&ticks);
+    return ticks;
+#else
+    struct timespec s;
+#ifdef CLOCK_MONOTONIC_RAW
+    if (clock_gettime(CLOCK_MONOTONIC_RAW, &s) != 0)
+#endif
+      clock_gettime(CLOCK_MONOTONIC, &s);
+    return (long long)s.tv_sec * 1000000000LL + (long long)s.tv_nsec;
+#endif
+  }
+
+  /**
+   * percentile
+   * Nearest-rank percentile of an already sorted array
+   */
+  static long long percentile(const std::vector<long long> &sorted, double p) {
+    size_t rank = (size_t)ceil(p / 100.0 * sorted.size());
+    if (rank > 0) {
+      rank--;
+    }
+    if (rank >= sorted.size()) {
+      rank = sorted.size() - 1;
+    }
+    return sorted[rank];
+  }
 
  public:
   double totalTime; /** total time taken */
                     /**
                      * Constructor
                      */
-  SDKTimer() {}
+  SDKTimer() : _iterationTimer(-1) {}
 
   /**
    * Destructor
@@ -597,7 +1097,7 @@ class SDKTimer {
 #ifdef _WIN32
     QueryPerformanceFrequency((LARGE_INTEGER *)&newTimer->_freq);
 #else
-    newTimer->_freq = (long long)1.0E3;
+    newTimer->_freq = 1000000000LL;
 #endif
     /* Push back the address of new Timer instance created */
     _timers.push_back(newTimer);
@@ -614,6 +1114,7 @@ class SDKTimer {
     }
     (_timers[handle]->_start) = 0;
     (_timers[handle]->_clocks) = 0;
+    _timers[handle]->_samples.clear();
     return SDK_SUCCESS;
   }
   /**
@@ -624,15 +1125,7 @@ class SDKTimer {
       error("Cannot reset timer. Invalid handle.");
       return SDK_FAILURE;
     }
-#ifdef _WIN32
-    long long tmpStart;
-    QueryPerformanceCounter((LARGE_INTEGER *)&(tmpStart));
-    _timers[handle]->_start = (double)tmpStart;
-#else
-    struct timeval s;
-    gettimeofday(&s, 0);
-    _timers[handle]->_start = s.tv_sec * 1.0E3 + ((double)(s.tv_usec / 1.0E3));
-#endif
+    _timers[handle]->_start = readTicks();
     return SDK_SUCCESS;
   }
 
@@ -640,23 +1133,15 @@ class SDKTimer {
   * stopTimer
   */
   int stopTimer(int handle) {
-    double n = 0;
+    long long n = readTicks();
     if (handle >= (int)_timers.size()) {
       error("Cannot reset timer. Invalid handle.");
       return SDK_FAILURE;
     }
-#ifdef _WIN32
-    long long n1;
-    QueryPerformanceCounter((LARGE_INTEGER *)&(n1));
-    n = (double)n1;
-#else
-    struct timeval s;
-    gettimeofday(&s, 0);
-    n = s.tv_sec * 1.0E3 + (double)(s.tv_usec / 1.0E3);
-#endif
     n -= _timers[handle]->_start;
     _timers[handle]->_start = 0;
     _timers[handle]->_clocks += n;
+    _timers[handle]->_samples.push_back(n);
     return SDK_SUCCESS;
   }
 
@@ -672,6 +1157,130 @@ class SDKTimer {
     reading = double(reading / _timers[handle]->_freq);
     return reading;
   }
+
+  /**
+  * getSampleCount
+  * @return number of start/stop intervals recorded since the last reset
+  */
+  int getSampleCount(int handle) {
+    if (handle >= (int)_timers.size()) {
+      error("Cannot read timer. Invalid handle.");
+      return 0;
+    }
+    return (int)_timers[handle]->_samples.size();
+  }
+
+  /**
+  * getTimerStats
+  * Computes min/median/p95/p99/mean/stddev over all recorded intervals
+  * @param handle timer handle
+  * @param stats output statistics, in seconds
+  * @return SDK_SUCCESS on success and SDK_FAILURE on failure
+  */
+  int getTimerStats(int handle, SDKTimerStats &stats) {
+    if (handle >= (int)_timers.size()) {
+      error("Cannot read timer. Invalid handle.");
+      return SDK_FAILURE;
+    }
+    stats = SDKTimerStats();
+    const Timer *timer = _timers[handle];
+    if (timer->_samples.empty()) {
+      return SDK_SUCCESS;
+    }
+    std::vector<long long> sorted(timer->_samples);
+    std::sort(sorted.begin(), sorted.end());
+    double freq = (double)timer->_freq;
+    size_t count = sorted.size();
+    stats.count = (int)count;
+    stats.total = (double)timer->_clocks / freq;
+    stats.min = sorted.front() / freq;
+    stats.max = sorted.back() / freq;
+    stats.mean = stats.total / count;
+    if (count % 2) {
+      stats.median = sorted[count / 2] / freq;
+    } else {
+      stats.median = (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0 / freq;
+    }
+    stats.p95 = percentile(sorted, 95.0) / freq;
+    stats.p99 = percentile(sorted, 99.0) / freq;
+    double variance = 0;
+    for (size_t i = 0; i < count; i++) {
+      double diff = sorted[i] / freq - stats.mean;
+      variance += diff * diff;
+    }
+    stats.stddev = sqrt(variance / count);
+    return SDK_SUCCESS;
+  }
+
+  /**
+  * startIteration
+  * Starts timing one iteration of a sample's kernel loop on a timer
+  * owned by this object, created on first use
+  */
+  void startIteration() {
+    if (_iterationTimer < 0) {
+      _iterationTimer = createTimer();
+    }
+    startTimer(_iterationTimer);
+  }
+
+  /**
+  * stopIteration
+  * Stops the iteration started by startIteration and records it
+  */
+  void stopIteration() {
+    if (_iterationTimer >= 0) {
+      stopTimer(_iterationTimer);
+    }
+  }
+
+  /**
+  * resetIterations
+  * Discards the iterations timed so far
+  */
+  void resetIterations() {
+    if (_iterationTimer >= 0) {
+      resetTimer(_iterationTimer);
+    }
+  }
+
+  /**
+  * printIterationStats
+  * Prints the per-iteration distribution, if any iteration was timed
+  */
+  void printIterationStats() {
+    if (_iterationTimer >= 0) {
+      printTimerStats(_iterationTimer, "Iteration");
+    }
+  }
+
+  /**
+  * printTimerStats
+  * Prints the interval distribution of a timer in printStatistics format
+  * @param handle timer handle
+  * @param name prefix for the column names
+  */
+  void printTimerStats(int handle, std::string name) {
+    SDKTimerStats s;
+    if (getTimerStats(handle, s) != SDK_SUCCESS) {
+      return;
+    }
+    std::string strArray[7] = {"Samples",   "Min(sec)",   "Median(sec)",
+                               "P95(sec)",  "P99(sec)",   "Mean(sec)",
+                               "StdDev(sec)"};
+    std::string stats[7];
+    for (int i = 0; i < 7; i++) {
+      strArray[i] = name + " " + strArray[i];
+    }
+    stats[0] = toString(s.count, std::dec);
+    stats[1] = toString(s.min, std::dec);
+    stats[2] = toString(s.median, std::dec);
+    stats[3] = toString(s.p95, std::dec);
+    stats[4] = toString(s.p99, std::dec);
+    stats[5] = toString(s.mean, std::dec);
+    stats[6] = toString(s.stddev, std::dec);
+    printStatistics(strArray, stats, 7);
+  }
 };
 
 /**************************************************************************